@@ -1,6 +1,6 @@
 /**
  * @file core.cpp
- * @brief Implementation of the framework core — mod lifecycle, hooks, eqlib glue, and logging.
+ * @brief Implementation of the framework core — mod lifecycle, hooks, and eqlib glue.
  * @date 2026-02-07
  *
  * @copyright Copyright (c) 2026
@@ -9,18 +9,37 @@
 #include "pch.h"
 #include "core.h"
 #include "hooks.h"
+#include "hook_mux.h"
+#include "shared_hooks.h"
 #include "memory.h"
 #include "game_state.h"
+#include "offsets.h"
+#include "patches.h"
 #include "commands.h"
+#include "logger.h"
+#include "profiler.h"
+#include "scheduler.h"
+#include "coro.h"
+#include "spawn_index.h"
+#include "spawn_snapshot.h"
+#include "ground_items.h"
+#include "worker_pool.h"
+#include "mod_dispatch.h"
 
 #include <eqlib/Offsets.h>
 #include <eqlib/offsets/eqgame.h>
 
+#include <intrin.h>
+
 #include <cstdio>
 #include <cstdarg>
-#include <ctime>
 #include <vector>
+#include <span>
+#include <unordered_map>
 #include <memory>
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
 
 // ---------------------------------------------------------------------------
 // eqlib extern definitions
@@ -44,47 +63,184 @@ namespace eqlib
 }
 
 // ---------------------------------------------------------------------------
-// Logging
+// Mod registry
 // ---------------------------------------------------------------------------
-static FILE* g_frameworkLog = nullptr;
+static std::vector<std::unique_ptr<IMod>> s_mods;
+static bool s_initialized = false;
+static WorkerPool s_workers;
+
+using ModDispatch::Subscriber;
+
+// Every registered mod, in registration order
+static std::vector<Subscriber> s_subscribers;
+
+// Per-event subscriber arrays. Built by RegisterMod from each mod's
+// GetEventMask() so the detours only touch real subscribers.
+static ModDispatch::HandlerTable s_handlers;
 
-static void OpenLog()
+static inline const std::vector<Subscriber>& Handlers(ModEvent e)
 {
-    if (!g_frameworkLog)
+    return s_handlers.Get(e);
+}
+
+// ---------------------------------------------------------------------------
+// Opcode routing for HandleWorldMessage
+//
+// s_opcodeRoute maps every 16-bit opcode to an index into s_routes. Route 0 is
+// the wildcard list (mods subscribed to ModEvent::IncomingMessage); each opcode
+// with specific subscribers gets its own list merging both sets in
+// registration order, so call order and suppression match a full broadcast.
+// ---------------------------------------------------------------------------
+static constexpr size_t kOpcodeSpace = 0x10000;
+
+static std::vector<std::vector<Subscriber>> s_routes(1);
+static uint16_t                             s_opcodeRoute[kOpcodeSpace];
+static std::vector<std::pair<uint32_t, IMod*>> s_opcodeSubs;
+
+// HandleWorldMessage iterates a route vector by reference while it calls
+// mods, and a mod may (un)subscribe from inside that call. Rebuilding then
+// would free the vector under the loop, so changes made mid-dispatch only
+// mark the table dirty and the outermost dispatch rebuilds it on the way out.
+static uint32_t s_routeDispatchDepth = 0;
+static bool     s_routesDirty = false;
+
+static void RebuildOpcodeRoutes()
+{
+    const auto& wildcard = Handlers(ModEvent::IncomingMessage);
+
+    s_routes.assign(1, wildcard);
+    memset(s_opcodeRoute, 0, sizeof(s_opcodeRoute));
+
+    for (const auto& sub : s_opcodeSubs)
     {
-        // Force-delete any stale file from a previous crash, then create fresh
-        DeleteFileA("dinput8_proxy.log");
-        fopen_s(&g_frameworkLog, "dinput8_proxy.log", "w");
+        uint32_t opcode = sub.first;
+        if (s_opcodeRoute[opcode] != 0)
+            continue;  // route for this opcode already built
+
+        std::vector<Subscriber> route;
+        for (const Subscriber& sub : s_subscribers)
+        {
+            bool wants = std::any_of(wildcard.begin(), wildcard.end(),
+                [&](const Subscriber& w) { return w.mod == sub.mod; });
+            for (const auto& other : s_opcodeSubs)
+                wants = wants || (other.first == opcode && other.second == sub.mod);
+            if (wants)
+                route.push_back(sub);
+        }
+
+        s_opcodeRoute[opcode] = static_cast<uint16_t>(s_routes.size());
+        s_routes.push_back(std::move(route));
     }
 }
 
-void LogFramework(const char* fmt, ...)
+static inline const std::vector<Subscriber>& OpcodeRoute(uint32_t opcode)
 {
-    OpenLog();
-    if (!g_frameworkLog)
-        return;
+    return s_routes[opcode < kOpcodeSpace ? s_opcodeRoute[opcode] : 0];
+}
 
-    time_t now = time(nullptr);
-    struct tm local;
-    localtime_s(&local, &now);
-    fprintf(g_frameworkLog, "[%04d-%02d-%02d %02d:%02d:%02d] ",
-        local.tm_year + 1900, local.tm_mon + 1, local.tm_mday,
-        local.tm_hour, local.tm_min, local.tm_sec);
+static void OpcodeSubsChanged()
+{
+    if (s_routeDispatchDepth > 0)
+        s_routesDirty = true;
+    else
+        RebuildOpcodeRoutes();
+}
 
-    va_list args;
-    va_start(args, fmt);
-    vfprintf(g_frameworkLog, fmt, args);
-    va_end(args);
+// ---------------------------------------------------------------------------
+// Dispatch
+//
+// ModDispatch::Each (mod_dispatch.h) with per-call timing when the profiler is
+// on. With the profiler off the only added cost is the IsEnabled() branch.
+// ---------------------------------------------------------------------------
+template <typename Fn>
+static inline bool Dispatch(ModEvent event, const std::vector<Subscriber>& handlers, Fn&& fn)
+{
+    if (!Profiler::IsEnabled())
+        return ModDispatch::Each(handlers, fn);
 
-    fprintf(g_frameworkLog, "\n");
-    fflush(g_frameworkLog);
+    for (const Subscriber& sub : handlers)
+    {
+        uint64_t start = __rdtsc();
+        if constexpr (ModDispatch::kCanStop<Fn>)
+        {
+            bool keepGoing = fn(sub.mod);
+            Profiler::Record(sub.profileRow, event, __rdtsc() - start);
+            if (!keepGoing)
+                return false;
+        }
+        else
+        {
+            fn(sub.mod);
+            Profiler::Record(sub.profileRow, event, __rdtsc() - start);
+        }
+    }
+    return true;
 }
 
 // ---------------------------------------------------------------------------
-// Mod registry
+// Per-frame object batches
+//
+// Accumulates add/remove notifications between pulses for mods subscribed to
+// ModEvent::SpawnBatch / GroundItemBatch. An add followed by a remove of the
+// same pointer within the frame cancels out. addedIndex maps a pointer to its
+// slot in `added` so that case is an O(1) swap-remove.
 // ---------------------------------------------------------------------------
-static std::vector<std::unique_ptr<IMod>> s_mods;
-static bool s_initialized = false;
+struct ObjectBatch
+{
+    std::vector<void*>                  added;
+    std::vector<void*>                  removed;
+    std::unordered_map<void*, uint32_t> addedIndex;
+
+    void Add(void* p)
+    {
+        addedIndex[p] = static_cast<uint32_t>(added.size());
+        added.push_back(p);
+    }
+
+    void Remove(void* p)
+    {
+        auto it = addedIndex.find(p);
+        if (it == addedIndex.end())
+        {
+            removed.push_back(p);
+            return;
+        }
+
+        uint32_t slot = it->second;
+        addedIndex.erase(it);
+        if (slot != added.size() - 1)
+        {
+            added[slot] = added.back();
+            addedIndex[added[slot]] = slot;
+        }
+        added.pop_back();
+    }
+
+    bool Empty() const { return added.empty() && removed.empty(); }
+
+    void Clear()
+    {
+        added.clear();
+        removed.clear();
+        addedIndex.clear();
+    }
+};
+
+static ObjectBatch s_spawnBatch;
+static ObjectBatch s_groundItemBatch;
+
+static void DeliverBatch(ModEvent event, ObjectBatch& batch,
+    void (IMod::*handler)(std::span<void* const>, std::span<void* const>))
+{
+    if (batch.Empty())
+        return;
+
+    std::span<void* const> added(batch.added);
+    std::span<void* const> removed(batch.removed);
+    Dispatch(event, Handlers(event),
+        [=](IMod* mod) { (mod->*handler)(added, removed); });
+    batch.Clear();
+}
 
 // ---------------------------------------------------------------------------
 // Hook addresses and originals
@@ -157,19 +313,50 @@ static int s_lastGameState = -1;
 
 static int __cdecl ProcessGameEvents_Detour()
 {
+    // Background job results land here first, so their game-thread callbacks
+    // see the same frame the mods are about to pulse.
+    s_workers.DrainCompletions();
+
     int result = ProcessGameEvents_Original();
 
-    for (auto& mod : s_mods)
-        mod->OnPulse();
+    // One read of the hot game globals for everything that runs this pulse
+    GameState::CaptureFrame();
 
-    // Track game state transitions
-    int gs = GameState::GetGameState();
+    // Spawn positions and renames for the index, before anything queries it
+    SpawnIndex::RefreshPositions();
+    SpawnSnapshot::Build();
+
+    // Everything spawned/despawned since the last pulse, before mods pulse
+    DeliverBatch(ModEvent::SpawnBatch, s_spawnBatch, &IMod::OnSpawnBatch);
+    DeliverBatch(ModEvent::GroundItemBatch, s_groundItemBatch, &IMod::OnGroundItemBatch);
+
+    Dispatch(ModEvent::Pulse, Handlers(ModEvent::Pulse),
+        [](IMod* mod) { mod->OnPulse(); });
+
+    // Scheduled mod tasks, bounded by the scheduler's per-frame budget
+    Scheduler::Tick();
+    Coro::OnPulse();
+
+    // Callback tables replaced by attach/detach since the last pulse
+    HookMux::ReclaimRetired();
+
+    // Track game state transitions. Read live: a mod or task above may have
+    // changed it since the capture.
+    int gs = GameState::Live::GetGameState();
     if (gs != s_lastGameState)
     {
         LogFramework("Game state changed: %d -> %d", s_lastGameState, gs);
         s_lastGameState = gs;
-        for (auto& mod : s_mods)
-            mod->OnSetGameState(gs);
+        // Zoning swaps the player, display and zone pointers; re-capture so
+        // SetGameState handlers don't see the old ones.
+        GameState::CaptureFrame();
+        // Re-sync with the game's list; covers spawns created before the hooks
+        // were installed and anything torn down without PrepForDestroyPlayer.
+        SpawnIndex::Rebuild();
+        GroundItems::Rebuild();
+        Dispatch(ModEvent::SetGameState, Handlers(ModEvent::SetGameState),
+            [gs](IMod* mod) { mod->OnSetGameState(gs); });
+        Coro::OnGameState(gs);
     }
 
     return result;
@@ -179,11 +366,20 @@ static unsigned char __fastcall HandleWorldMessage_Detour(
     void* thisPtr, void* edx,
     void* connection, uint32_t opcode, char* buffer, uint32_t size)
 {
-    for (auto& mod : s_mods)
+    LOG(Hooks, Trace, "HandleWorldMessage opcode=0x%04X size=%u", opcode, size);
+
+    Coro::OnOpcode(opcode, buffer, size);
+
+    ++s_routeDispatchDepth;
+    bool allow = Dispatch(ModEvent::IncomingMessage, OpcodeRoute(opcode),
+        [=](IMod* mod) { return mod->OnIncomingMessage(opcode, buffer, size); });
+    if (--s_routeDispatchDepth == 0 && s_routesDirty)
     {
-        if (!mod->OnIncomingMessage(opcode, buffer, size))
-            return 0;
+        s_routesDirty = false;
+        RebuildOpcodeRoutes();
     }
+    if (!allow)
+        return 0;
 
     return HandleWorldMessage_Original(thisPtr, edx, connection, opcode, buffer, size);
 }
@@ -195,8 +391,12 @@ static void* __fastcall CreatePlayer_Detour(
     void* result = CreatePlayer_Original(thisPtr, edx, buf, a, b, c, d, e, f, g);
     if (result)
     {
-        for (auto& mod : s_mods)
-            mod->OnAddSpawn(result);
+        SpawnIndex::Insert(static_cast<eqlib::PlayerClient*>(result));
+        Dispatch(ModEvent::AddSpawn, Handlers(ModEvent::AddSpawn),
+            [result](IMod* mod) { mod->OnAddSpawn(result); });
+        if (!Handlers(ModEvent::SpawnBatch).empty())
+            s_spawnBatch.Add(result);
+        Coro::OnSpawn(result);
     }
     return result;
 }
@@ -204,8 +404,12 @@ static void* __fastcall CreatePlayer_Detour(
 static void* __fastcall PrepForDestroyPlayer_Detour(
     void* thisPtr, void* edx, void* spawn)
 {
-    for (auto& mod : s_mods)
-        mod->OnRemoveSpawn(spawn);
+    Dispatch(ModEvent::RemoveSpawn, Handlers(ModEvent::RemoveSpawn),
+        [spawn](IMod* mod) { mod->OnRemoveSpawn(spawn); });
+    if (!Handlers(ModEvent::SpawnBatch).empty())
+        s_spawnBatch.Remove(spawn);
+    SpawnIndex::Remove(static_cast<eqlib::PlayerClient*>(spawn));
+    GameState::ForgetSpawn(spawn);
 
     return PrepForDestroyPlayer_Original(thisPtr, edx, spawn);
 }
@@ -214,16 +418,22 @@ static void __fastcall GroundItemAdd_Detour(
     void* thisPtr, void* edx, void* pItem)
 {
     GroundItemAdd_Original(thisPtr, edx, pItem);
+    GroundItems::Add(static_cast<EQGroundItem*>(pItem));
 
-    for (auto& mod : s_mods)
-        mod->OnAddGroundItem(pItem);
+    Dispatch(ModEvent::AddGroundItem, Handlers(ModEvent::AddGroundItem),
+        [pItem](IMod* mod) { mod->OnAddGroundItem(pItem); });
+    if (!Handlers(ModEvent::GroundItemBatch).empty())
+        s_groundItemBatch.Add(pItem);
 }
 
 static void __fastcall GroundItemDelete_Detour(
     void* thisPtr, void* edx, void* pItem)
 {
-    for (auto& mod : s_mods)
-        mod->OnRemoveGroundItem(pItem);
+    Dispatch(ModEvent::RemoveGroundItem, Handlers(ModEvent::RemoveGroundItem),
+        [pItem](IMod* mod) { mod->OnRemoveGroundItem(pItem); });
+    if (!Handlers(ModEvent::GroundItemBatch).empty())
+        s_groundItemBatch.Remove(pItem);
+    GroundItems::Remove(static_cast<EQGroundItem*>(pItem));
 
     GroundItemDelete_Original(thisPtr, edx, pItem);
 }
@@ -231,14 +441,23 @@ static void __fastcall GroundItemDelete_Detour(
 static void __fastcall GroundItemClear_Detour(
     void* thisPtr, void* edx)
 {
-    // Walk the linked list before clearing: Top at offset 0x00, pNext at offset 0x04
-    void* current = *reinterpret_cast<void**>(thisPtr);
+    Dispatch(ModEvent::ClearGroundItems, Handlers(ModEvent::ClearGroundItems),
+        [](IMod* mod) { mod->OnClearGroundItems(); });
+    GroundItems::Clear();
+
+    // Walk the linked list before clearing: Top at offset 0x00, then pNext.
+    // Skipped entirely when nobody needs per-item removals.
+    const auto& handlers = Handlers(ModEvent::RemoveGroundItem);
+    bool batching = !Handlers(ModEvent::GroundItemBatch).empty();
+    void* current = (handlers.empty() && !batching) ? nullptr : *reinterpret_cast<void**>(thisPtr);
     while (current)
     {
         void* next = *reinterpret_cast<void**>(
-            reinterpret_cast<uintptr_t>(current) + 0x04);
-        for (auto& mod : s_mods)
-            mod->OnRemoveGroundItem(current);
+            reinterpret_cast<uintptr_t>(current) + GroundItemFields::kNext);
+        Dispatch(ModEvent::RemoveGroundItem, handlers,
+            [current](IMod* mod) { mod->OnRemoveGroundItem(current); });
+        if (batching)
+            s_groundItemBatch.Remove(current);
         current = next;
     }
 
@@ -255,9 +474,11 @@ static void __fastcall InterpretCmd_Detour(
 
 static void __fastcall CleanGameUI_Detour(void* thisPtr, void* edx)
 {
-    for (auto& mod : s_mods)
-        mod->OnCleanUI();
+    Dispatch(ModEvent::CleanUI, Handlers(ModEvent::CleanUI),
+        [](IMod* mod) { mod->OnCleanUI(); });
 
+    // The UI, display and (on camp) local PC are about to be freed
+    GameState::InvalidateFrame();
     CleanGameUI_Original(thisPtr, edx);
 }
 
@@ -265,17 +486,12 @@ static void __fastcall ReloadUI_Detour(void* thisPtr, void* edx, bool useIni)
 {
     ReloadUI_Original(thisPtr, edx, useIni);
 
-    for (auto& mod : s_mods)
-        mod->OnReloadUI();
+    // Replaced UI objects — OnReloadUI handlers read the new ones live
+    GameState::InvalidateFrame();
+    Dispatch(ModEvent::ReloadUI, Handlers(ModEvent::ReloadUI),
+        [](IMod* mod) { mod->OnReloadUI(); });
 }
 
-// ---------------------------------------------------------------------------
-// Address resolution
-// ---------------------------------------------------------------------------
-
-// HandleWorldMessage raw offset (not in eqlib offsets file for ROF2)
-#define CEverQuest__HandleWorldMessage_x  0x004C3250
-
 // ---------------------------------------------------------------------------
 // Chat output
 // ---------------------------------------------------------------------------
@@ -323,8 +539,45 @@ void ExecuteCommand(const char* szCommand)
 
 void RegisterMod(std::unique_ptr<IMod> mod)
 {
-    LogFramework("Registered mod: %s", mod->GetName());
+    Subscriber sub = { mod.get(), Profiler::AddMod(mod.get()) };
+    s_subscribers.push_back(sub);
+
+    uint32_t mask = mod->GetEventMask();
+    s_handlers.Add(sub, mask);
+
+    LogFramework("Registered mod: %s (events 0x%03X)", mod->GetName(), mask);
     s_mods.push_back(std::move(mod));
+    RebuildOpcodeRoutes();
+}
+
+void SubscribeOpcode(IMod* mod, uint32_t opcode)
+{
+    if (opcode >= kOpcodeSpace)
+    {
+        LogFramework("SubscribeOpcode: %s opcode 0x%X is outside the 16-bit opcode space",
+            mod->GetName(), opcode);
+        return;
+    }
+
+    for (const auto& sub : s_opcodeSubs)
+    {
+        if (sub.first == opcode && sub.second == mod)
+            return;
+    }
+
+    s_opcodeSubs.emplace_back(opcode, mod);
+    OpcodeSubsChanged();
+    LogFramework("Opcode 0x%04X routed to %s", opcode, mod->GetName());
+}
+
+void UnsubscribeOpcode(IMod* mod, uint32_t opcode)
+{
+    auto it = std::find(s_opcodeSubs.begin(), s_opcodeSubs.end(), std::make_pair(opcode, mod));
+    if (it == s_opcodeSubs.end())
+        return;
+
+    s_opcodeSubs.erase(it);
+    OpcodeSubsChanged();
 }
 
 void Initialize()
@@ -334,63 +587,37 @@ void Initialize()
     s_initialized = true;
 
     LogFramework("=== Framework initializing ===");
-    LogFramework("EQGameBaseAddress = 0x%08X", static_cast<unsigned int>(EQGameBaseAddress));
+    LOG_DEFERRED("EQGameBaseAddress = 0x%08X", static_cast<unsigned int>(EQGameBaseAddress));
 
     // Resolve game global pointers (must come after InitBaseAddress)
     GameState::ResolveGlobals();
 
-    // Resolve ProcessGameEvents address using eqlib's FixEQGameOffset
-    uintptr_t pgeAddr = eqlib::FixEQGameOffset(__ProcessGameEvents_x);
-    ProcessGameEvents_Original = reinterpret_cast<ProcessGameEvents_t>(pgeAddr);
-    LogFramework("ProcessGameEvents = 0x%08X", static_cast<unsigned int>(pgeAddr));
-
-    // Resolve HandleWorldMessage address (manual calculation — not in eqlib offsets)
-    uintptr_t hwmAddr = static_cast<uintptr_t>(CEverQuest__HandleWorldMessage_x)
-        - eqlib::EQGamePreferredAddress + EQGameBaseAddress;
-    HandleWorldMessage_Original = reinterpret_cast<HandleWorldMessage_t>(hwmAddr);
-    LogFramework("HandleWorldMessage = 0x%08X", static_cast<unsigned int>(hwmAddr));
-
-    // Resolve spawn tracking hooks
-    uintptr_t cpAddr = eqlib::FixEQGameOffset(PlayerManagerClient__CreatePlayer_x);
-    CreatePlayer_Original = reinterpret_cast<CreatePlayer_t>(cpAddr);
-    LogFramework("CreatePlayer = 0x%08X", static_cast<unsigned int>(cpAddr));
-
-    uintptr_t pdpAddr = eqlib::FixEQGameOffset(PlayerManagerBase__PrepForDestroyPlayer_x);
-    PrepForDestroyPlayer_Original = reinterpret_cast<PrepForDestroyPlayer_t>(pdpAddr);
-    LogFramework("PrepForDestroyPlayer = 0x%08X", static_cast<unsigned int>(pdpAddr));
-
-    // Resolve ground item tracking hooks
-    uintptr_t giAddAddr = eqlib::FixEQGameOffset(EQGroundItemListManager__Add_x);
-    GroundItemAdd_Original = reinterpret_cast<GroundItemAdd_t>(giAddAddr);
-    LogFramework("GroundItemAdd = 0x%08X", static_cast<unsigned int>(giAddAddr));
-
-    uintptr_t giDelAddr = eqlib::FixEQGameOffset(EQGroundItemListManager__Delete_x);
-    GroundItemDelete_Original = reinterpret_cast<GroundItemDelete_t>(giDelAddr);
-    LogFramework("GroundItemDelete = 0x%08X", static_cast<unsigned int>(giDelAddr));
-
-    uintptr_t giClrAddr = eqlib::FixEQGameOffset(EQGroundItemListManager__Clear_x);
-    GroundItemClear_Original = reinterpret_cast<GroundItemClear_t>(giClrAddr);
-    LogFramework("GroundItemClear = 0x%08X", static_cast<unsigned int>(giClrAddr));
-
-    // Resolve InterpretCmd address (slash command interpreter)
-    uintptr_t icAddr = eqlib::FixEQGameOffset(CEverQuest__InterpretCmd_x);
-    InterpretCmd_Original = reinterpret_cast<InterpretCmd_t>(icAddr);
-    LogFramework("InterpretCmd = 0x%08X", static_cast<unsigned int>(icAddr));
-
-    // Resolve CleanGameUI address
-    uintptr_t cguiAddr = eqlib::FixEQGameOffset(CDisplay__CleanGameUI_x);
-    CleanGameUI_Original = reinterpret_cast<CleanGameUI_t>(cguiAddr);
-    LogFramework("CleanGameUI = 0x%08X", static_cast<unsigned int>(cguiAddr));
-
-    // Resolve ReloadUI address
-    uintptr_t ruiAddr = eqlib::FixEQGameOffset(CDisplay__ReloadUI_x);
-    ReloadUI_Original = reinterpret_cast<ReloadUI_t>(ruiAddr);
-    LogFramework("ReloadUI = 0x%08X", static_cast<unsigned int>(ruiAddr));
-
-    // Resolve dsp_chat address (direct call, not a hook)
-    uintptr_t dspAddr = eqlib::FixEQGameOffset(CEverQuest__dsp_chat_x);
-    DspChat_Func = reinterpret_cast<DspChat_t>(dspAddr);
-    LogFramework("dsp_chat = 0x%08X", static_cast<unsigned int>(dspAddr));
+    // Code addresses: signature scan of .text, fixed offsets as fallback
+    Offsets::ResolveAll();
+
+    ProcessGameEvents_Original    = reinterpret_cast<ProcessGameEvents_t>(Offsets::Get(Sig::ProcessGameEvents));
+    HandleWorldMessage_Original   = reinterpret_cast<HandleWorldMessage_t>(Offsets::Get(Sig::HandleWorldMessage));
+    CreatePlayer_Original         = reinterpret_cast<CreatePlayer_t>(Offsets::Get(Sig::CreatePlayer));
+    PrepForDestroyPlayer_Original = reinterpret_cast<PrepForDestroyPlayer_t>(Offsets::Get(Sig::PrepForDestroyPlayer));
+    GroundItemAdd_Original        = reinterpret_cast<GroundItemAdd_t>(Offsets::Get(Sig::GroundItemAdd));
+    GroundItemDelete_Original     = reinterpret_cast<GroundItemDelete_t>(Offsets::Get(Sig::GroundItemDelete));
+    GroundItemClear_Original      = reinterpret_cast<GroundItemClear_t>(Offsets::Get(Sig::GroundItemClear));
+    InterpretCmd_Original         = reinterpret_cast<InterpretCmd_t>(Offsets::Get(Sig::InterpretCmd));
+    CleanGameUI_Original          = reinterpret_cast<CleanGameUI_t>(Offsets::Get(Sig::CleanGameUI));
+    ReloadUI_Original             = reinterpret_cast<ReloadUI_t>(Offsets::Get(Sig::ReloadUI));
+
+    // dsp_chat is called directly, not hooked
+    DspChat_Func = reinterpret_cast<DspChat_t>(Offsets::Get(Sig::DspChat));
+
+    // Background workers — up before mod init so Initialize() can submit jobs
+    s_workers.Start();
+    LogFramework("Worker pool started with %u threads",
+        static_cast<unsigned int>(s_workers.GetThreadCount()));
+
+    // Framework slash commands
+    Commands::AddCommand("/log", &Logger::Command);
+    Commands::AddCommand("/perf", &Profiler::Command);
+    Commands::AddCommand("/hook", &Hooks::Command);
 
     // Initialize all mods before installing hooks
     for (auto& mod : s_mods)
@@ -400,51 +627,69 @@ void Initialize()
             LogFramework("  WARNING: mod '%s' failed to initialize", mod->GetName());
     }
 
-    // Install hooks
-    Hooks::Install("ProcessGameEvents",
+    // Byte patches queued by mods, plus any from the optional patch file,
+    // written in one batch
+    Patches::LoadFile("dinput8_patches.txt");
+    size_t patched = Patches::ApplyPending();
+    LogFramework("%zu byte patches applied", patched);
+
+    // Framework hooks join the ones the mods queued; all of them go live
+    // together in one batch
+    Hooks::Queue("ProcessGameEvents",
         reinterpret_cast<void**>(&ProcessGameEvents_Original),
         reinterpret_cast<void*>(&ProcessGameEvents_Detour));
 
-    Hooks::Install("HandleWorldMessage",
+    Hooks::Queue("HandleWorldMessage",
         reinterpret_cast<void**>(&HandleWorldMessage_Original),
         reinterpret_cast<void*>(&HandleWorldMessage_Detour));
 
-    Hooks::Install("CreatePlayer",
+    Hooks::Queue("CreatePlayer",
         reinterpret_cast<void**>(&CreatePlayer_Original),
         reinterpret_cast<void*>(&CreatePlayer_Detour));
 
-    Hooks::Install("PrepForDestroyPlayer",
+    Hooks::Queue("PrepForDestroyPlayer",
         reinterpret_cast<void**>(&PrepForDestroyPlayer_Original),
         reinterpret_cast<void*>(&PrepForDestroyPlayer_Detour));
 
-    Hooks::Install("GroundItemAdd",
+    Hooks::Queue("GroundItemAdd",
         reinterpret_cast<void**>(&GroundItemAdd_Original),
         reinterpret_cast<void*>(&GroundItemAdd_Detour));
 
-    Hooks::Install("GroundItemDelete",
+    Hooks::Queue("GroundItemDelete",
         reinterpret_cast<void**>(&GroundItemDelete_Original),
         reinterpret_cast<void*>(&GroundItemDelete_Detour));
 
-    Hooks::Install("GroundItemClear",
+    Hooks::Queue("GroundItemClear",
         reinterpret_cast<void**>(&GroundItemClear_Original),
         reinterpret_cast<void*>(&GroundItemClear_Detour));
 
-    Hooks::Install("InterpretCmd",
+    Hooks::Queue("InterpretCmd",
         reinterpret_cast<void**>(&InterpretCmd_Original),
         reinterpret_cast<void*>(&InterpretCmd_Detour));
 
-    Hooks::Install("CleanGameUI",
+    Hooks::Queue("CleanGameUI",
         reinterpret_cast<void**>(&CleanGameUI_Original),
         reinterpret_cast<void*>(&CleanGameUI_Detour));
 
-    Hooks::Install("ReloadUI",
+    Hooks::Queue("ReloadUI",
         reinterpret_cast<void**>(&ReloadUI_Original),
         reinterpret_cast<void*>(&ReloadUI_Detour));
 
-    LogFramework("=== Framework initialized — 10 hooks installed ===");
+    // Game functions mods share through HookMux callbacks
+    SharedHooks::Queue();
+
+    size_t hooked = Hooks::CommitBatch();
+    if (!hooked)
+        LogFramework("WARNING: no hooks installed — the framework is inactive");
+    LogFramework("=== Framework initialized — %zu hooks installed ===", hooked);
 }
 
-void Shutdown()
+WorkerPool& Workers()
+{
+    return s_workers;
+}
+
+void Shutdown(bool processExit)
 {
     if (!s_initialized)
         return;
@@ -452,21 +697,56 @@ void Shutdown()
 
     LogFramework("=== Framework shutting down ===");
 
-    // Remove hooks before shutting down mods
+    // Remove hooks and restore patched bytes before shutting down mods
     Hooks::RemoveAll();
+    Patches::RevertAll();
 
     // Clear command registry
     Commands::Shutdown();
 
+    // Stop background work before mods tear down the state jobs reference.
+    // At process exit the workers were already terminated, so there is
+    // nothing to wait for. On FreeLibrary, under the loader lock the threads
+    // can't finish exiting, so wait for them to leave their run loops and
+    // detach rather than join.
+    if (processExit)
+        s_workers.Abandon();
+    else if (!s_workers.Stop(false))
+        LogFramework("WARNING: worker pool did not stop within the timeout");
+    s_workers.DiscardCompletions();
+    SpawnSnapshot::Shutdown();
+    if (uint32_t failed = s_workers.GetFailedCount())
+        LogFramework("Worker pool: %u jobs threw during this session", failed);
+
+    // Destroy suspended coroutine tasks while the mod state they reference
+    // is still alive
+    Coro::Shutdown();
+
     // Shutdown all mods
     for (auto& mod : s_mods)
     {
         LogFramework("Shutting down mod: %s", mod->GetName());
         mod->Shutdown();
     }
+
+    // Shared hook callbacks (the detours are already gone)
+    HookMux::ClearAll();
+    Scheduler::Shutdown();
+    s_handlers.Clear();
+    s_subscribers.clear();
+    s_spawnBatch.Clear();
+    s_groundItemBatch.Clear();
+    SpawnIndex::Clear();
+    GroundItems::Clear();
+    s_opcodeSubs.clear();
     s_mods.clear();
+    RebuildOpcodeRoutes();
 
     LogFramework("=== Framework shutdown complete ===");
+
+    // Push everything queued so far to disk — at process exit the writer
+    // thread may already be gone.
+    Logger::Flush();
 }
 
 } // namespace Core
@@ -11,8 +11,11 @@
 #include "mods/mod_interface.h"
 #include <memory>
 
+class WorkerPool;
+
 // Logging function used by core and hooks modules.
-// Writes timestamped lines to dinput8_proxy.log.
+// Queues a timestamped line for dinput8_proxy.log; file I/O happens on the
+// Logger writer thread (see logger.h), so this never blocks on disk.
 void LogFramework(const char* fmt, ...);
 
 namespace Core
@@ -22,13 +25,28 @@ namespace Core
 // Call before Initialize().
 void RegisterMod(std::unique_ptr<IMod> mod);
 
+// Route world messages with this opcode to mod->OnIncomingMessage. Mods whose
+// GetEventMask() includes ModEvent::IncomingMessage receive every opcode and
+// don't need this. Call from Initialize() or on the game thread, including
+// from inside OnIncomingMessage: a change made while a message is being
+// dispatched takes effect from the next message.
+void SubscribeOpcode(IMod* mod, uint32_t opcode);
+void UnsubscribeOpcode(IMod* mod, uint32_t opcode);
+
 // Called from the init thread once the game window is ready.
 // Initializes all mods, then installs hooks.
 void Initialize();
 
 // Called from DLL_PROCESS_DETACH.
-// Removes all hooks, then shuts down all mods.
-void Shutdown();
+// Removes all hooks, then shuts down all mods. processExit is true when the
+// process is terminating (lpReserved != nullptr) rather than FreeLibrary
+// unloading the DLL; the other threads are already gone then.
+void Shutdown(bool processExit);
+
+// Background thread pool, started in Initialize() and stopped in Shutdown().
+// Jobs must not touch game memory; use Submit(work, done) or PostToMain() to
+// get results back onto the game thread at the start of the next frame.
+WorkerPool& Workers();
 
 // Execute a slash command as if the player typed it. Uses InterpretCmd internally.
 void ExecuteCommand(const char* szCommand);
@@ -0,0 +1,375 @@
+/**
+ * @file coro.cpp
+ * @brief Implementation of coroutine tasks — wait lists, frame pool, event wake-ups.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "pch.h"
+#include "coro.h"
+#include "core.h"
+#include "game_state.h"
+
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+namespace Coro
+{
+
+// ---------------------------------------------------------------------------
+// Wait lists
+// ---------------------------------------------------------------------------
+
+WaitNode::~WaitNode()
+{
+    if (list)
+        list->Unlink(this);
+}
+
+void WaitList::PushBack(WaitNode* node)
+{
+    node->prev = tail;
+    node->next = nullptr;
+    node->list = this;
+    if (tail)
+        tail->next = node;
+    else
+        head = node;
+    tail = node;
+}
+
+WaitNode* WaitList::PopFront()
+{
+    WaitNode* node = head;
+    if (node)
+        Unlink(node);
+    return node;
+}
+
+void WaitList::Unlink(WaitNode* node)
+{
+    if (node->prev) node->prev->next = node->next;
+    else            head = node->next;
+    if (node->next) node->next->prev = node->prev;
+    else            tail = node->prev;
+
+    node->prev = node->next = nullptr;
+    node->list = nullptr;
+}
+
+static WaitList s_nextFrame;
+static WaitList s_gameState;
+static WaitList s_spawn;
+static std::unordered_map<uint32_t, WaitList> s_opcode;  // lists are never erased (nodes point at them)
+
+// ---------------------------------------------------------------------------
+// Frame pool — power-of-two size classes carved from 64 KB chunks
+// ---------------------------------------------------------------------------
+
+static constexpr size_t kMinClassShift = 6;    // 64 bytes
+static constexpr size_t kMaxClassShift = 12;   // 4096 bytes
+static constexpr size_t kClassCount    = kMaxClassShift - kMinClassShift + 1;
+static constexpr size_t kChunkBytes    = 64 * 1024;
+
+struct FreeBlock
+{
+    FreeBlock* next;
+};
+
+static FreeBlock*          s_freeLists[kClassCount];
+static std::vector<void*>  s_chunks;
+static size_t              s_outstanding = 0;
+
+static size_t ClassOf(size_t size)
+{
+    size_t cls = 0;
+    while ((size_t(1) << (cls + kMinClassShift)) < size)
+        ++cls;
+    return cls;
+}
+
+void* AllocateFrame(size_t size)
+{
+    if (size > (size_t(1) << kMaxClassShift))
+        return ::operator new(size);
+
+    size_t cls = ClassOf(size);
+    FreeBlock*& list = s_freeLists[cls];
+    if (!list)
+    {
+        // Carve a fresh chunk into blocks of this class
+        size_t block = size_t(1) << (cls + kMinClassShift);
+        char* chunk = static_cast<char*>(::operator new(kChunkBytes));
+        s_chunks.push_back(chunk);
+        for (size_t off = 0; off + block <= kChunkBytes; off += block)
+        {
+            auto* b = reinterpret_cast<FreeBlock*>(chunk + off);
+            b->next = list;
+            list = b;
+        }
+    }
+
+    FreeBlock* b = list;
+    list = b->next;
+    ++s_outstanding;
+    return b;
+}
+
+void FreeFrame(void* ptr, size_t size)
+{
+    if (size > (size_t(1) << kMaxClassShift))
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    auto* b = static_cast<FreeBlock*>(ptr);
+    FreeBlock*& list = s_freeLists[ClassOf(size)];
+    b->next = list;
+    list = b;
+    --s_outstanding;
+}
+
+// ---------------------------------------------------------------------------
+// Task
+// ---------------------------------------------------------------------------
+
+// Spawned (root) tasks, so Shutdown/CancelAll can find them
+static Task::promise_type* s_liveHead = nullptr;
+static size_t              s_liveCount = 0;
+
+static void LinkLive(Task::promise_type* p)
+{
+    p->prevLive = nullptr;
+    p->nextLive = s_liveHead;
+    if (s_liveHead)
+        s_liveHead->prevLive = p;
+    s_liveHead = p;
+    ++s_liveCount;
+}
+
+Task::promise_type::~promise_type()
+{
+    if (!detached)
+        return;
+
+    if (prevLive) prevLive->nextLive = nextLive;
+    else          s_liveHead = nextLive;
+    if (nextLive) nextLive->prevLive = prevLive;
+    --s_liveCount;
+}
+
+std::coroutine_handle<> Task::promise_type::FinalAwaiter::await_suspend(
+    std::coroutine_handle<promise_type> h) noexcept
+{
+    promise_type& p = h.promise();
+    if (p.continuation)
+        return p.continuation;
+    if (p.detached)
+        h.destroy();
+    return std::noop_coroutine();
+}
+
+void Task::promise_type::unhandled_exception()
+{
+    LogFramework("Coro: unhandled exception in task (owner %s) — task ended",
+        owner ? owner->GetName() : "<none>");
+}
+
+Task& Task::operator=(Task&& other) noexcept
+{
+    if (this != &other)
+    {
+        if (m_handle)
+            m_handle.destroy();
+        m_handle = other.m_handle;
+        other.m_handle = nullptr;
+    }
+    return *this;
+}
+
+Task::~Task()
+{
+    if (m_handle)
+        m_handle.destroy();
+}
+
+void Spawn(Task task, IMod* owner)
+{
+    Task::Handle h = task.Release();
+    if (!h)
+        return;
+
+    Task::promise_type& p = h.promise();
+    p.detached = true;
+    p.owner = owner;
+    LinkLive(&p);
+    h.resume();
+}
+
+void CancelAll(IMod* owner)
+{
+    // Must not be called from inside one of the owner's own tasks — a running
+    // coroutine can't be destroyed.
+    for (Task::promise_type* p = s_liveHead; p; )
+    {
+        Task::promise_type* next = p->nextLive;
+        if (p->owner == owner)
+            Task::Handle::from_promise(*p).destroy();
+        p = next;
+    }
+}
+
+size_t GetLiveCount()
+{
+    return s_liveCount;
+}
+
+// ---------------------------------------------------------------------------
+// Awaitables
+// ---------------------------------------------------------------------------
+
+void NextFrame::await_suspend(std::coroutine_handle<> h)
+{
+    handle = h;
+    s_nextFrame.PushBack(this);
+}
+
+Delay::~Delay()
+{
+    if (m_task)
+        Scheduler::Cancel(m_task);
+}
+
+void Delay::await_suspend(std::coroutine_handle<> h)
+{
+    m_task = Scheduler::After(nullptr, Scheduler::Cadence::Milliseconds, m_ms, [h] { h.resume(); });
+}
+
+bool WaitGameState::await_ready() const
+{
+    return GameState::GetGameState() == m_state;
+}
+
+void WaitGameState::await_suspend(std::coroutine_handle<> h)
+{
+    handle = h;
+    s_gameState.PushBack(this);
+}
+
+void WaitOpcode::await_suspend(std::coroutine_handle<> h)
+{
+    handle = h;
+    s_opcode[m_message.opcode].PushBack(this);
+}
+
+void WaitSpawn::await_suspend(std::coroutine_handle<> h)
+{
+    handle = h;
+    s_spawn.PushBack(this);
+}
+
+// ---------------------------------------------------------------------------
+// Framework entry points
+// ---------------------------------------------------------------------------
+
+// Tasks resumed from a wake-up may immediately wait on the same event again;
+// moving the list aside first means they wait for the *next* occurrence.
+static void TakeAll(WaitList& from, WaitList& to)
+{
+    for (WaitNode* n = from.PopFront(); n; n = from.PopFront())
+        to.PushBack(n);
+}
+
+void OnPulse()
+{
+    if (s_nextFrame.Empty())
+        return;
+
+    WaitList ready;
+    TakeAll(s_nextFrame, ready);
+    for (WaitNode* n = ready.PopFront(); n; n = ready.PopFront())
+        n->handle.resume();
+}
+
+void OnGameState(int state)
+{
+    if (s_gameState.Empty())
+        return;
+
+    WaitList pending;
+    TakeAll(s_gameState, pending);
+    for (WaitNode* n = pending.PopFront(); n; n = pending.PopFront())
+    {
+        if (static_cast<WaitGameState*>(n)->m_state == state)
+            n->handle.resume();
+        else
+            s_gameState.PushBack(n);
+    }
+}
+
+void OnOpcode(uint32_t opcode, char* buffer, uint32_t size)
+{
+    if (s_opcode.empty())
+        return;
+    auto it = s_opcode.find(opcode);
+    if (it == s_opcode.end() || it->second.Empty())
+        return;
+
+    WaitList ready;
+    TakeAll(it->second, ready);
+    for (WaitNode* n = ready.PopFront(); n; n = ready.PopFront())
+    {
+        auto* w = static_cast<WaitOpcode*>(n);
+        w->m_message.buffer = buffer;
+        w->m_message.size = size;
+        n->handle.resume();
+    }
+}
+
+void OnSpawn(void* spawn)
+{
+    if (s_spawn.Empty())
+        return;
+
+    WaitList pending;
+    TakeAll(s_spawn, pending);
+    for (WaitNode* n = pending.PopFront(); n; n = pending.PopFront())
+    {
+        auto* w = static_cast<WaitSpawn*>(n);
+        if (!w->m_filter || w->m_filter(spawn))
+        {
+            w->m_spawn = spawn;
+            n->handle.resume();
+        }
+        else
+        {
+            s_spawn.PushBack(n);
+        }
+    }
+}
+
+void Shutdown()
+{
+    size_t destroyed = s_liveCount;
+    while (s_liveHead)
+        Task::Handle::from_promise(*s_liveHead).destroy();
+
+    if (destroyed)
+        LogFramework("Coro: destroyed %u suspended tasks", static_cast<unsigned int>(destroyed));
+
+    // Only release the pool if nothing still points into it (a Task a mod
+    // created but never spawned would).
+    if (s_outstanding == 0)
+    {
+        for (void* chunk : s_chunks)
+            ::operator delete(chunk);
+        s_chunks.clear();
+        for (auto& list : s_freeLists)
+            list = nullptr;
+    }
+}
+
+} // namespace Coro
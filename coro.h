@@ -0,0 +1,252 @@
+/**
+ * @file coro.h
+ * @brief C++20 coroutine tasks for multi-frame mod logic, resumed on the game thread.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Example — a script that would otherwise be an OnPulse state machine:
+ *
+ *     Coro::Task WaitForZoneIn()
+ *     {
+ *         Core::ExecuteCommand("/camp");
+ *         co_await Coro::WaitGameState(5);
+ *         co_await Coro::Delay(2000);
+ *         void* spawn = co_await Coro::WaitSpawn();
+ *         ...
+ *     }
+ *     Coro::Spawn(WaitForZoneIn(), this);
+ *
+ * A suspended task sits in exactly one intrusive wait list (or one scheduler
+ * slot, for Delay) and is touched only when its event fires. Idle tasks cost
+ * nothing per frame, however many there are.
+ *
+ * Frames come from a size-class pool (game thread only), so long-running
+ * scripts don't fragment the CRT heap. Everything here must be used on the
+ * game thread.
+ */
+
+#pragma once
+
+#include "scheduler.h"
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+class IMod;
+
+namespace Coro
+{
+
+// ---------------------------------------------------------------------------
+// Intrusive wait lists
+// ---------------------------------------------------------------------------
+
+struct WaitList;
+
+// Base for awaiters parked in a WaitList. Unlinks itself when destroyed, so a
+// task destroyed while suspended (Shutdown, CancelAll) leaves no dangling node.
+struct WaitNode
+{
+    WaitNode*               prev = nullptr;
+    WaitNode*               next = nullptr;
+    WaitList*               list = nullptr;
+    std::coroutine_handle<> handle;
+
+    WaitNode() = default;
+    WaitNode(const WaitNode&) = delete;
+    WaitNode& operator=(const WaitNode&) = delete;
+    ~WaitNode();
+};
+
+struct WaitList
+{
+    WaitNode* head = nullptr;
+    WaitNode* tail = nullptr;
+
+    bool Empty() const { return head == nullptr; }
+    void PushBack(WaitNode* node);
+    WaitNode* PopFront();
+    void Unlink(WaitNode* node);
+};
+
+// ---------------------------------------------------------------------------
+// Frame allocator
+// ---------------------------------------------------------------------------
+
+void* AllocateFrame(size_t size);
+void  FreeFrame(void* ptr, size_t size);
+
+// ---------------------------------------------------------------------------
+// Task
+// ---------------------------------------------------------------------------
+
+// Lazily started coroutine. Either hand it to Spawn() (the framework owns it
+// from then on) or co_await it from another task (runs as a child; the parent
+// resumes when it finishes).
+class Task
+{
+public:
+    struct promise_type
+    {
+        std::coroutine_handle<> continuation;
+        IMod*                   owner    = nullptr;
+        bool                    detached = false;
+        promise_type*           prevLive = nullptr;
+        promise_type*           nextLive = nullptr;
+
+        static void* operator new(size_t size) { return AllocateFrame(size); }
+        static void  operator delete(void* ptr, size_t size) { FreeFrame(ptr, size); }
+
+        ~promise_type();
+
+        Task get_return_object()
+        {
+            return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        struct FinalAwaiter
+        {
+            bool await_ready() const noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept;
+            void await_resume() const noexcept {}
+        };
+        FinalAwaiter final_suspend() noexcept { return {}; }
+
+        void return_void() {}
+        void unhandled_exception();
+    };
+
+    using Handle = std::coroutine_handle<promise_type>;
+
+    Task() = default;
+    Task(Task&& other) noexcept : m_handle(other.m_handle) { other.m_handle = nullptr; }
+    Task& operator=(Task&& other) noexcept;
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task();
+
+    // co_await child task
+    bool await_ready() const noexcept { return !m_handle || m_handle.done(); }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> parent) noexcept
+    {
+        m_handle.promise().continuation = parent;
+        return m_handle;
+    }
+    void await_resume() const noexcept {}
+
+    Handle Release()
+    {
+        Handle h = m_handle;
+        m_handle = nullptr;
+        return h;
+    }
+
+private:
+    explicit Task(Handle h) : m_handle(h) {}
+    Handle m_handle;
+};
+
+// Start a task now (it runs until its first suspension) and let the framework
+// own it. `owner` lets CancelAll() destroy a mod's tasks together.
+void Spawn(Task task, IMod* owner = nullptr);
+
+// Destroy every suspended task spawned with this owner.
+void CancelAll(IMod* owner);
+
+// Number of spawned tasks still alive.
+size_t GetLiveCount();
+
+// ---------------------------------------------------------------------------
+// Awaitables
+// ---------------------------------------------------------------------------
+
+// Resume at the end of the next pulse.
+struct NextFrame : WaitNode
+{
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> h);
+    void await_resume() const noexcept {}
+};
+
+// Resume after `ms` milliseconds (via the Scheduler, so it honours its budget).
+struct Delay
+{
+    explicit Delay(uint32_t ms) : m_ms(ms) {}
+    Delay(const Delay&) = delete;
+    Delay& operator=(const Delay&) = delete;
+    ~Delay();
+
+    bool await_ready() const noexcept { return m_ms == 0; }
+    void await_suspend(std::coroutine_handle<> h);
+    void await_resume() noexcept { m_task = 0; }
+
+    uint32_t          m_ms;
+    Scheduler::TaskId m_task = 0;
+};
+
+// Resume when the game state becomes `state` (immediately if it already is).
+struct WaitGameState : WaitNode
+{
+    explicit WaitGameState(int state) : m_state(state) {}
+
+    bool await_ready() const;
+    void await_suspend(std::coroutine_handle<> h);
+    void await_resume() const noexcept {}
+
+    int m_state;
+};
+
+// A world message as seen by HandleWorldMessage. The buffer belongs to the
+// game and is only valid until the task next suspends.
+struct Message
+{
+    uint32_t opcode;
+    char*    buffer;
+    uint32_t size;
+};
+
+// Resume when a world message with this opcode arrives. The task runs inside
+// HandleWorldMessage, before mods see the message.
+struct WaitOpcode : WaitNode
+{
+    explicit WaitOpcode(uint32_t opcode) : m_message{ opcode, nullptr, 0 } {}
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> h);
+    Message await_resume() const noexcept { return m_message; }
+
+    Message m_message;
+};
+
+// Resume when a spawn is created that passes `filter` (any spawn if empty).
+// Yields the PlayerClient* as void*, like IMod::OnAddSpawn.
+struct WaitSpawn : WaitNode
+{
+    explicit WaitSpawn(std::function<bool(void*)> filter = {}) : m_filter(std::move(filter)) {}
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> h);
+    void* await_resume() const noexcept { return m_spawn; }
+
+    std::function<bool(void*)> m_filter;
+    void*                      m_spawn = nullptr;
+};
+
+// ---------------------------------------------------------------------------
+// Framework entry points (called by Core)
+// ---------------------------------------------------------------------------
+
+void OnPulse();
+void OnGameState(int state);
+void OnOpcode(uint32_t opcode, char* buffer, uint32_t size);
+void OnSpawn(void* spawn);
+
+// Destroy all live tasks and release the frame pool.
+void Shutdown();
+
+} // namespace Coro
@@ -0,0 +1,69 @@
+/**
+ * @file cpu_features.h
+ * @brief Runtime CPU feature detection shared by the SIMD code paths.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Header-only and portable (MSVC and GCC/Clang), so portable modules built
+ * without the PCH can use it too.
+ */
+
+#pragma once
+
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+// AVX2 kernels are compiled for AVX2 but only called after the runtime check.
+// MSVC allows the intrinsics without /arch:AVX2; GCC/Clang need the attribute.
+#if defined(__GNUC__)
+#define CPU_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define CPU_TARGET_AVX2
+#endif
+
+namespace CpuFeatures
+{
+
+inline bool DetectAvx2()
+{
+#ifdef _MSC_VER
+    int regs[4];
+    __cpuid(regs, 0);
+    if (regs[0] < 7)
+        return false;
+    __cpuid(regs, 1);
+    bool osxsave = (regs[2] & (1 << 27)) != 0;
+    bool avx     = (regs[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 6) != 6)   // OS saves XMM+YMM state
+        return false;
+    __cpuidex(regs, 7, 0);
+    return (regs[1] & (1 << 5)) != 0;
+#else
+    unsigned int a, b, c, d;
+    if (!__get_cpuid(1, &a, &b, &c, &d))
+        return false;
+    if (!(c & (1u << 27)) || !(c & (1u << 28)))
+        return false;
+    unsigned int xcr0Lo, xcr0Hi;
+    __asm__ volatile("xgetbv" : "=a"(xcr0Lo), "=d"(xcr0Hi) : "c"(0));
+    if ((xcr0Lo & 6) != 6)
+        return false;
+    if (!__get_cpuid_count(7, 0, &a, &b, &c, &d))
+        return false;
+    return (b & (1u << 5)) != 0;
+#endif
+}
+
+// Detected once, on first call
+inline bool HasAvx2()
+{
+    static const bool s_avx2 = DetectAvx2();
+    return s_avx2;
+}
+
+} // namespace CpuFeatures
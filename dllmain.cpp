@@ -12,6 +12,7 @@
 
 #include "pch.h"
 #include "core.h"
+#include "logger.h"
 #include "mods/spellbook_unlock.h"
 #include "mods/combat_abilities.h"
 #include "mods/stats_override.h"
@@ -92,8 +93,9 @@ BOOL WINAPI DllMain(HMODULE hModule, DWORD dwReason, LPVOID lpReserved)
     {
         LogFramework("DLL_PROCESS_DETACH: Shutting down proxy.");
 
-        // Shutdown framework before freeing the real DLL
-        Core::Shutdown();
+        // Shutdown framework before freeing the real DLL. lpReserved is
+        // non-null when the process is exiting rather than unloading us.
+        Core::Shutdown(lpReserved != nullptr);
 
         if (g_hRealDInput8)
         {
@@ -103,6 +105,7 @@ BOOL WINAPI DllMain(HMODULE hModule, DWORD dwReason, LPVOID lpReserved)
         }
 
         LogFramework("=== dinput8 proxy DLL unloaded ===");
+        Logger::Shutdown();
         break;
     }
     }
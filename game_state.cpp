@@ -9,6 +9,8 @@
 #include "pch.h"
 #include "game_state.h"
 #include "core.h"
+#include "logger.h"
+#include "spawn_index.h"
 
 #include <eqlib/Offsets.h>
 #include <eqlib/offsets/eqgame.h>
@@ -46,19 +48,26 @@ void ResolveGlobals()
     s_currentMapLabel   = eqlib::FixEQGameOffset(__CurrentMapLabel_x);
 
     LogFramework("GameState globals resolved:");
-    LogFramework("  pLocalPlayer      = 0x%08X", static_cast<unsigned int>(s_pLocalPlayer));
-    LogFramework("  pTarget           = 0x%08X", static_cast<unsigned int>(s_pTarget));
-    LogFramework("  pControlledPlayer = 0x%08X", static_cast<unsigned int>(s_pControlledPlayer));
-    LogFramework("  pSpawnManager     = 0x%08X", static_cast<unsigned int>(s_pSpawnManager));
-    LogFramework("  pLocalPC          = 0x%08X", static_cast<unsigned int>(s_pLocalPC));
-    LogFramework("  pDisplay          = 0x%08X", static_cast<unsigned int>(s_pDisplay));
-    LogFramework("  pWndMgr           = 0x%08X", static_cast<unsigned int>(s_pWndMgr));
-    LogFramework("  pZoneInfo         = 0x%08X", static_cast<unsigned int>(s_pZoneInfo));
-    LogFramework("  pEverQuest        = 0x%08X", static_cast<unsigned int>(s_pEverQuest));
-    LogFramework("  GroundItemMgr::Instance = 0x%08X", static_cast<unsigned int>(s_groundItemListMgrInstance));
-    LogFramework("  CurrentMapLabel   = 0x%08X", static_cast<unsigned int>(s_currentMapLabel));
+    LOG_DEFERRED("  pLocalPlayer      = 0x%08X", static_cast<unsigned int>(s_pLocalPlayer));
+    LOG_DEFERRED("  pTarget           = 0x%08X", static_cast<unsigned int>(s_pTarget));
+    LOG_DEFERRED("  pControlledPlayer = 0x%08X", static_cast<unsigned int>(s_pControlledPlayer));
+    LOG_DEFERRED("  pSpawnManager     = 0x%08X", static_cast<unsigned int>(s_pSpawnManager));
+    LOG_DEFERRED("  pLocalPC          = 0x%08X", static_cast<unsigned int>(s_pLocalPC));
+    LOG_DEFERRED("  pDisplay          = 0x%08X", static_cast<unsigned int>(s_pDisplay));
+    LOG_DEFERRED("  pWndMgr           = 0x%08X", static_cast<unsigned int>(s_pWndMgr));
+    LOG_DEFERRED("  pZoneInfo         = 0x%08X", static_cast<unsigned int>(s_pZoneInfo));
+    LOG_DEFERRED("  pEverQuest        = 0x%08X", static_cast<unsigned int>(s_pEverQuest));
+    LOG_DEFERRED("  GroundItemMgr::Instance = 0x%08X", static_cast<unsigned int>(s_groundItemListMgrInstance));
+    LOG_DEFERRED("  CurrentMapLabel   = 0x%08X", static_cast<unsigned int>(s_currentMapLabel));
 }
 
+// ---------------------------------------------------------------------------
+// Live reads
+// ---------------------------------------------------------------------------
+
+namespace Live
+{
+
 // Double-pointer dereference: the offset points to a pointer-to-pointer in game memory.
 // First deref gives the game's global pointer, second gives the object.
 eqlib::PlayerClient* GetLocalPlayer()
@@ -80,12 +89,6 @@ eqlib::PlayerClient* GetControlledPlayer()
     return *reinterpret_cast<eqlib::PlayerClient**>(s_pControlledPlayer);
 }
 
-eqlib::PlayerManagerClient* GetSpawnManager()
-{
-    if (!s_pSpawnManager) return nullptr;
-    return *reinterpret_cast<eqlib::PlayerManagerClient**>(s_pSpawnManager);
-}
-
 eqlib::PcClient* GetLocalPC()
 {
     if (!s_pLocalPC) return nullptr;
@@ -111,6 +114,125 @@ eqlib::ZONEINFO* GetZoneInfo()
     return reinterpret_cast<eqlib::ZONEINFO*>(s_pZoneInfo);
 }
 
+CEverQuest* GetEverQuest()
+{
+    if (!s_pEverQuest) return nullptr;
+    return *reinterpret_cast<CEverQuest**>(s_pEverQuest);
+}
+
+int GetGameState()
+{
+    CEverQuest* pEQ = GetEverQuest();
+    if (!pEQ) return -1;
+    // CEverQuest::GameState is at offset 0x5c8 (from eqlib EverQuest.h)
+    return *reinterpret_cast<int*>(reinterpret_cast<uintptr_t>(pEQ) + 0x5c8);
+}
+
+} // namespace Live
+
+// ---------------------------------------------------------------------------
+// Frame snapshot
+// ---------------------------------------------------------------------------
+
+static FrameSnapshot s_frame{};
+
+void CaptureFrame()
+{
+    s_frame.localPlayer      = Live::GetLocalPlayer();
+    s_frame.target           = Live::GetTarget();
+    s_frame.controlledPlayer = Live::GetControlledPlayer();
+    s_frame.localPC          = Live::GetLocalPC();
+    s_frame.zoneInfo         = Live::GetZoneInfo();
+    s_frame.display          = Live::GetDisplay();
+    s_frame.wndManager       = Live::GetWndManager();
+    s_frame.everQuest        = Live::GetEverQuest();
+    s_frame.gameState        = Live::GetGameState();
+    s_frame.current          = true;
+
+    // Skip 0 on wrap so it keeps meaning "never captured"
+    if (++s_frame.frame == 0)
+        s_frame.frame = 1;
+}
+
+void InvalidateFrame()
+{
+    uint32_t frame = s_frame.frame;
+    s_frame = FrameSnapshot{};
+    s_frame.frame = frame;
+}
+
+void ForgetSpawn(const void* spawn)
+{
+    if (!spawn)
+        return;
+    if (s_frame.localPlayer == spawn)      s_frame.localPlayer = nullptr;
+    if (s_frame.target == spawn)           s_frame.target = nullptr;
+    if (s_frame.controlledPlayer == spawn) s_frame.controlledPlayer = nullptr;
+}
+
+const FrameSnapshot& GetFrame()
+{
+    return s_frame;
+}
+
+// Before the first pulse (init, early commands) and between InvalidateFrame
+// and the next capture there is no usable snapshot, so fall through to a
+// live read.
+eqlib::PlayerClient* GetLocalPlayer()
+{
+    return s_frame.current ? s_frame.localPlayer : Live::GetLocalPlayer();
+}
+
+eqlib::PlayerClient* GetTarget()
+{
+    return s_frame.current ? s_frame.target : Live::GetTarget();
+}
+
+eqlib::PlayerClient* GetControlledPlayer()
+{
+    return s_frame.current ? s_frame.controlledPlayer : Live::GetControlledPlayer();
+}
+
+eqlib::PcClient* GetLocalPC()
+{
+    return s_frame.current ? s_frame.localPC : Live::GetLocalPC();
+}
+
+eqlib::CDisplay* GetDisplay()
+{
+    return s_frame.current ? s_frame.display : Live::GetDisplay();
+}
+
+eqlib::CXWndManager* GetWndManager()
+{
+    return s_frame.current ? s_frame.wndManager : Live::GetWndManager();
+}
+
+eqlib::ZONEINFO* GetZoneInfo()
+{
+    return s_frame.current ? s_frame.zoneInfo : Live::GetZoneInfo();
+}
+
+CEverQuest* GetEverQuest()
+{
+    return s_frame.current ? s_frame.everQuest : Live::GetEverQuest();
+}
+
+int GetGameState()
+{
+    return s_frame.current ? s_frame.gameState : Live::GetGameState();
+}
+
+// ---------------------------------------------------------------------------
+// Uncached
+// ---------------------------------------------------------------------------
+
+eqlib::PlayerManagerClient* GetSpawnManager()
+{
+    if (!s_pSpawnManager) return nullptr;
+    return *reinterpret_cast<eqlib::PlayerManagerClient**>(s_pSpawnManager);
+}
+
 eqlib::PlayerClient* GetSpawnList()
 {
     eqlib::PlayerManagerClient* mgr = GetSpawnManager();
@@ -123,18 +245,14 @@ eqlib::PlayerClient* GetSpawnList()
         reinterpret_cast<uintptr_t>(mgr) + 0x08);
 }
 
-CEverQuest* GetEverQuest()
+eqlib::PlayerClient* FindSpawnById(uint32_t spawnId)
 {
-    if (!s_pEverQuest) return nullptr;
-    return *reinterpret_cast<CEverQuest**>(s_pEverQuest);
+    return SpawnIndex::FindById(spawnId);
 }
 
-int GetGameState()
+eqlib::PlayerClient* FindSpawnByName(const char* name)
 {
-    CEverQuest* pEQ = GetEverQuest();
-    if (!pEQ) return -1;
-    // CEverQuest::GameState is at offset 0x5c8 (from eqlib EverQuest.h)
-    return *reinterpret_cast<int*>(reinterpret_cast<uintptr_t>(pEQ) + 0x5c8);
+    return SpawnIndex::FindByName(name);
 }
 
 EQGroundItem* GetGroundItemListTop()
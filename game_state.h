@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 // Forward declarations — avoids pulling in heavy eqlib headers
 class CEverQuest;
 struct EQGroundItem;
@@ -28,7 +30,51 @@ namespace GameState
 // Resolve all global addresses. Call once after InitBaseAddress().
 void ResolveGlobals();
 
+// The hot globals, captured once per pulse by Core (top of
+// ProcessGameEvents_Detour, and again on a game-state transition). The getters
+// below return these values, so a detour that fires many times a frame
+// doesn't re-walk the pointer chains each time. Use GameState::Live for
+// values that must reflect a change made earlier in the same frame.
+//
+// The captured objects can be destroyed before the next capture, so Core
+// keeps the snapshot honest from the hooks that tear them down:
+//   - spawns (localPlayer, target, controlledPlayer) are nulled by ForgetSpawn
+//     from PrepForDestroyPlayer
+//   - CleanGameUI and ReloadUI (camp, zone, /loadskin) drop the whole
+//     snapshot with InvalidateFrame, and the getters read live until the next
+//     pulse captures again
+// everQuest lives for the whole process.
+struct alignas(64) FrameSnapshot
+{
+    eqlib::PlayerClient*  localPlayer;
+    eqlib::PlayerClient*  target;
+    eqlib::PlayerClient*  controlledPlayer;
+    eqlib::PcClient*      localPC;
+    eqlib::ZONEINFO*      zoneInfo;
+    eqlib::CDisplay*      display;
+    eqlib::CXWndManager*  wndManager;
+    CEverQuest*           everQuest;
+    int                   gameState;
+    uint32_t              frame;        // pulse counter; 0 = never captured
+    bool                  current;      // false until captured and after InvalidateFrame
+};
+
+// Called by Core.
+void CaptureFrame();
+
+// Drop the snapshot: its fields are cleared and every getter reads live
+// until the next CaptureFrame. Called by Core before CleanGameUI runs and
+// after ReloadUI rebuilds the UI.
+void InvalidateFrame();
+
+// Null out snapshot references to a spawn the game is about to destroy.
+// Called by Core from PrepForDestroyPlayer_Detour.
+void ForgetSpawn(const void* spawn);
+
+const FrameSnapshot& GetFrame();
+
 // Typed getters — return nullptr/null if the game pointer is not yet set.
+// Snapshot-backed (see FrameSnapshot) while the snapshot is current.
 eqlib::PlayerClient*        GetLocalPlayer();
 eqlib::PlayerClient*        GetTarget();
 eqlib::PlayerClient*        GetControlledPlayer();
@@ -40,14 +86,33 @@ eqlib::ZONEINFO*            GetZoneInfo();
 eqlib::PlayerClient*        GetSpawnList();
 CEverQuest*                 GetEverQuest();
 
-// Read CEverQuest::GameState member (offset 0x5c8).
+// CEverQuest::GameState member (offset 0x5c8), from the frame snapshot.
 // Returns -1 if CEverQuest instance is not yet available.
 int GetGameState();
 
+// O(1) spawn lookups from the framework's spawn index (see spawn_index.h).
+// Prefer these over walking GetSpawnList().
+eqlib::PlayerClient*        FindSpawnById(uint32_t spawnId);
+eqlib::PlayerClient*        FindSpawnByName(const char* name);
+
 // Ground item list — calls EQGroundItemListManager::Instance() then reads Top.
 EQGroundItem*  GetGroundItemListTop();
 
 // Currently hovered map label (game global at __CurrentMapLabel_x).
 MapViewLabel*  GetCurrentMapLabel();
 
+// Direct reads of the game globals, bypassing the frame snapshot.
+namespace Live
+{
+eqlib::PlayerClient*        GetLocalPlayer();
+eqlib::PlayerClient*        GetTarget();
+eqlib::PlayerClient*        GetControlledPlayer();
+eqlib::PcClient*            GetLocalPC();
+eqlib::CDisplay*            GetDisplay();
+eqlib::CXWndManager*        GetWndManager();
+eqlib::ZONEINFO*            GetZoneInfo();
+CEverQuest*                 GetEverQuest();
+int                         GetGameState();
+} // namespace Live
+
 } // namespace GameState
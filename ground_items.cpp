@@ -0,0 +1,86 @@
+/**
+ * @file ground_items.cpp
+ * @brief Implementation of the ground item registry.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "pch.h"
+#include "ground_items.h"
+#include "game_state.h"
+
+namespace GroundItems
+{
+
+// Items cluster around corpses and camps; smaller cells than the spawn grid
+static SpatialGrid s_grid(32.0f);
+
+template <typename T>
+static T ReadField(const EQGroundItem* item, uintptr_t offset)
+{
+    return *reinterpret_cast<const T*>(reinterpret_cast<uintptr_t>(item) + offset);
+}
+
+static void AppendItems(const std::vector<const void*>& keys, std::vector<EQGroundItem*>& out)
+{
+    for (const void* key : keys)
+        out.push_back(static_cast<EQGroundItem*>(const_cast<void*>(key)));
+}
+
+void Add(EQGroundItem* item)
+{
+    if (!item)
+        return;
+    s_grid.Insert(item,
+        ReadField<float>(item, GroundItemFields::kX),
+        ReadField<float>(item, GroundItemFields::kY),
+        ReadField<float>(item, GroundItemFields::kZ));
+}
+
+void Remove(EQGroundItem* item)
+{
+    if (item)
+        s_grid.Remove(item);
+}
+
+void Clear()
+{
+    s_grid.Clear();
+}
+
+void Rebuild()
+{
+    Clear();
+    for (EQGroundItem* item = GameState::GetGroundItemListTop(); item;
+         item = ReadField<EQGroundItem*>(item, GroundItemFields::kNext))
+    {
+        Add(item);
+    }
+}
+
+size_t GetCount()
+{
+    return s_grid.Size();
+}
+
+void QueryRadius(float x, float y, float z, float radius, std::vector<EQGroundItem*>& out)
+{
+    std::vector<const void*> keys;
+    s_grid.QueryRadius(x, y, z, radius, keys);
+    AppendItems(keys, out);
+}
+
+void Nearest(float x, float y, float z, size_t count, std::vector<EQGroundItem*>& out)
+{
+    std::vector<const void*> keys;
+    s_grid.Nearest(x, y, z, count, keys);
+    AppendItems(keys, out);
+}
+
+const SpatialGrid& GetGrid()
+{
+    return s_grid;
+}
+
+} // namespace GroundItems
@@ -0,0 +1,61 @@
+/**
+ * @file ground_items.h
+ * @brief Framework-owned ground item registry with a spatial hash for nearest/radius queries.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Fed by GroundItemAdd_Detour / GroundItemDelete_Detour and emptied in one step
+ * by GroundItemClear_Detour. It is rebuilt from the game's list on every
+ * game-state transition, which picks up items dropped before the hooks were
+ * installed. Ground items don't move, so each position is read once, on add.
+ *
+ * Mods that only need to know the zone's items are gone should subscribe to
+ * ModEvent::ClearGroundItems (one call) rather than RemoveGroundItem (one
+ * call per item during a clear).
+ *
+ * Game thread only.
+ */
+
+#pragma once
+
+#include "spatial_grid.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct EQGroundItem;
+
+// ROF2 EQGroundItem field offsets (eqlib GroundItems.h)
+namespace GroundItemFields
+{
+constexpr uintptr_t kPrev = 0x00;   // EQGroundItem* pPrev
+constexpr uintptr_t kNext = 0x04;   // EQGroundItem* pNext
+constexpr uintptr_t kY    = 0x70;   // float
+constexpr uintptr_t kX    = 0x74;   // float
+constexpr uintptr_t kZ    = 0x78;   // float
+} // namespace GroundItemFields
+
+namespace GroundItems
+{
+
+void Add(EQGroundItem* item);
+void Remove(EQGroundItem* item);
+
+// Forget every item at once (zone teardown).
+void Clear();
+
+// Clear, then re-register everything on the game's ground item list.
+void Rebuild();
+
+size_t GetCount();
+
+// Results are appended to `out`; Nearest returns closest first.
+void QueryRadius(float x, float y, float z, float radius, std::vector<EQGroundItem*>& out);
+void Nearest(float x, float y, float z, size_t count, std::vector<EQGroundItem*>& out);
+
+// Underlying grid (keys are EQGroundItem*), for queries with custom predicates.
+const SpatialGrid& GetGrid();
+
+} // namespace GroundItems
@@ -0,0 +1,55 @@
+/**
+ * @file hook_mux.cpp
+ * @brief Registry of multiplexed hooks, for retired-table reclamation and shutdown.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "hook_mux.h"
+
+namespace HookMux
+{
+
+// Hooks are function-local statics, so the registry must exist before the
+// first one is constructed
+static std::mutex& RegistryLock()
+{
+    static std::mutex s_lock;
+    return s_lock;
+}
+
+static std::vector<HookBase*>& Registry()
+{
+    static std::vector<HookBase*> s_hooks;
+    return s_hooks;
+}
+
+HookBase::HookBase()
+{
+    std::lock_guard<std::mutex> lock(RegistryLock());
+    Registry().push_back(this);
+}
+
+HookBase::~HookBase()
+{
+    std::lock_guard<std::mutex> lock(RegistryLock());
+    auto& hooks = Registry();
+    hooks.erase(std::remove(hooks.begin(), hooks.end(), this), hooks.end());
+}
+
+void ReclaimRetired()
+{
+    std::lock_guard<std::mutex> lock(RegistryLock());
+    for (HookBase* hook : Registry())
+        hook->Reclaim();
+}
+
+void ClearAll()
+{
+    std::lock_guard<std::mutex> lock(RegistryLock());
+    for (HookBase* hook : Registry())
+        hook->Clear();
+}
+
+} // namespace HookMux
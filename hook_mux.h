@@ -0,0 +1,237 @@
+/**
+ * @file hook_mux.h
+ * @brief Multiplexed hooks — one detour per game function, fanned out to a
+ *        priority-ordered list of pre/post callbacks that can change at runtime.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * A HookMux::Hook owns no code patch itself. The framework installs one plain
+ * detour per shared game function (see shared_hooks.h), and that detour just
+ * forwards to Dispatch() with the trampoline:
+ *
+ *     static bool __fastcall CanUseItem_Detour(void* thisPtr, void* edx, const void* item, bool lvl, bool out)
+ *     {
+ *         return s_canUseItem.Dispatch(CanUseItem_Original, thisPtr, edx, item, lvl, out);
+ *     }
+ *
+ * Any number of mods then Attach() callbacks to the Hook:
+ *
+ *   pre   bool (Ret& result, Args...)  runs before the original, highest
+ *         priority first. Returning true short-circuits: `result` becomes
+ *         the return value, and the original and lower-priority pre
+ *         callbacks are skipped.
+ *   post void (Ret& result, Args...)   runs after the original (or the
+ *         short-circuit), lowest priority first so the highest-priority
+ *         mod has the last word. Post callbacks always run.
+ *
+ * Equal priorities keep attach order. With nothing attached, Dispatch is a
+ * single pointer load and a call to the original.
+ *
+ * The callback list is read-copy-update. Attach/Detach build a new immutable
+ * table and publish it with one atomic store, so they are safe from any thread
+ * and never touch code. The replaced table is retired, and
+ * HookMux::ReclaimRetired() frees retired tables once no dispatch is in
+ * flight (Core calls it every pulse).
+ *
+ * Portable (standard library only).
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace HookMux
+{
+
+// Type-erased part every Hook registers, so retired tables can be reclaimed
+// for all of them at once
+class HookBase
+{
+public:
+    HookBase();
+    virtual ~HookBase();
+
+    HookBase(const HookBase&) = delete;
+    HookBase& operator=(const HookBase&) = delete;
+
+    // Free retired tables if no dispatch is in flight
+    virtual void Reclaim() = 0;
+
+    // Drop every callback and free all tables (shutdown, after the detour is removed)
+    virtual void Clear() = 0;
+
+protected:
+    // Readers in Dispatch; retired tables are only freed while this is 0
+    std::atomic<uint32_t> m_inFlight{ 0 };
+    std::mutex            m_writeLock;
+};
+
+// Frees retired callback tables on every registered Hook. Game thread, once
+// per pulse.
+void ReclaimRetired();
+
+// Clear() on every registered Hook
+void ClearAll();
+
+template <typename Ret, typename... Args>
+class Hook : public HookBase
+{
+    static_assert(!std::is_void_v<Ret>, "HookMux::Hook needs a return value to pass between callbacks");
+    static_assert(std::is_default_constructible_v<Ret>, "HookMux::Hook return type must be default-constructible");
+
+public:
+    using Pre  = bool (*)(Ret& result, Args... args);
+    using Post = void (*)(Ret& result, Args... args);
+
+    explicit Hook(const char* name) : m_name(name) {}
+    ~Hook() override { Clear(); }
+
+    const char* GetName() const { return m_name; }
+
+    // Add a named callback pair (either may be null). False if the name is
+    // already attached to this hook.
+    bool Attach(const char* name, int priority, Pre pre, Post post)
+    {
+        std::lock_guard<std::mutex> lock(m_writeLock);
+        const Table* old = m_table.load(std::memory_order_relaxed);
+
+        Table* table = old ? new Table(*old) : new Table();
+        for (const Entry& e : table->entries)
+        {
+            if (e.name == name)
+            {
+                delete table;
+                return false;
+            }
+        }
+
+        // Stable insert after every entry of equal or higher priority
+        auto at = std::find_if(table->entries.begin(), table->entries.end(),
+            [priority](const Entry& e) { return e.priority < priority; });
+        table->entries.insert(at, Entry{ name, priority, pre, post });
+        Publish(table, old);
+        return true;
+    }
+
+    bool Detach(const char* name)
+    {
+        std::lock_guard<std::mutex> lock(m_writeLock);
+        const Table* old = m_table.load(std::memory_order_relaxed);
+        if (!old)
+            return false;
+
+        auto it = std::find_if(old->entries.begin(), old->entries.end(),
+            [name](const Entry& e) { return e.name == name; });
+        if (it == old->entries.end())
+            return false;
+
+        Table* table = nullptr;
+        if (old->entries.size() > 1)
+        {
+            table = new Table(*old);
+            table->entries.erase(table->entries.begin() + (it - old->entries.begin()));
+        }
+        Publish(table, old);
+        return true;
+    }
+
+    size_t CallbackCount() const
+    {
+        const Table* t = m_table.load(std::memory_order_acquire);
+        return t ? t->entries.size() : 0;
+    }
+
+    // Called from the detour with the trampoline. `original` is whatever
+    // callable reaches the unhooked function (calling convention included).
+    template <typename Fn>
+    Ret Dispatch(Fn original, Args... args)
+    {
+        if (!m_table.load(std::memory_order_acquire))
+            return original(args...);
+
+        // Announce the read before loading the table Reclaim might free
+        m_inFlight.fetch_add(1, std::memory_order_seq_cst);
+        const Table* t = m_table.load(std::memory_order_seq_cst);
+
+        Ret result{};
+        bool handled = false;
+        if (t)
+        {
+            for (const Entry& e : t->entries)
+            {
+                if (e.pre && e.pre(result, args...))
+                {
+                    handled = true;
+                    break;
+                }
+            }
+        }
+        if (!handled)
+            result = original(args...);
+        if (t)
+        {
+            for (auto it = t->entries.rbegin(); it != t->entries.rend(); ++it)
+            {
+                if (it->post)
+                    it->post(result, args...);
+            }
+        }
+
+        m_inFlight.fetch_sub(1, std::memory_order_release);
+        return result;
+    }
+
+    void Reclaim() override
+    {
+        std::lock_guard<std::mutex> lock(m_writeLock);
+        if (m_retired.empty() || m_inFlight.load(std::memory_order_seq_cst) != 0)
+            return;
+        for (const Table* t : m_retired)
+            delete t;
+        m_retired.clear();
+    }
+
+    void Clear() override
+    {
+        std::lock_guard<std::mutex> lock(m_writeLock);
+        delete m_table.exchange(nullptr, std::memory_order_acq_rel);
+        for (const Table* t : m_retired)
+            delete t;
+        m_retired.clear();
+    }
+
+private:
+    struct Entry
+    {
+        std::string name;
+        int         priority;
+        Pre         pre;
+        Post        post;
+    };
+
+    struct Table
+    {
+        std::vector<Entry> entries;   // priority descending
+    };
+
+    // Caller holds m_writeLock
+    void Publish(const Table* table, const Table* old)
+    {
+        m_table.store(table, std::memory_order_seq_cst);
+        if (old)
+            m_retired.push_back(old);
+    }
+
+    const char*                m_name;
+    std::atomic<const Table*>  m_table{ nullptr };
+    std::vector<const Table*>  m_retired;
+};
+
+} // namespace HookMux
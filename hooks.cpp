@@ -1,6 +1,6 @@
 /**
  * @file hooks.cpp
- * @brief Implementation of detour install/remove using Microsoft Detours.
+ * @brief Implementation of hook install/remove on top of the inline hook engine.
  * @date 2026-02-07
  *
  * @copyright Copyright (c) 2026
@@ -8,9 +8,11 @@
 
 #include "pch.h"
 #include "hooks.h"
+#include "inline_hook.h"
 #include "core.h"
 
-#include <detours/detours.h>
+#include <cstdio>
+#include <cstring>
 #include <vector>
 #include <string>
 
@@ -19,46 +21,131 @@ namespace Hooks
 
 struct HookRecord
 {
-    std::string name;
-    void**      target;   // pointer to the original-function pointer
-    void*       detour;   // our replacement function
+    std::string       name;
+    void**            target;   // pointer to the original-function pointer
+    void*             detour;   // our replacement function
+    InlineHook::Hook  hook;
 };
 
 static std::vector<HookRecord> s_hooks;
+static std::vector<HookRecord> s_pending;   // queued for CommitBatch
 
-bool Install(const char* name, void** target, void* detour)
+// Core's slash command hook — /hook must not turn off the path it arrives by
+constexpr const char* kCommandHook = "InterpretCmd";
+
+static HookRecord* Find(const char* name)
 {
-    LogFramework("Hooks::Install '%s' target=0x%p detour=0x%p", name, *target, detour);
+    for (auto& hook : s_hooks)
+    {
+        if (hook.name == name)
+            return &hook;
+    }
+    return nullptr;
+}
 
-    LONG error = DetourTransactionBegin();
-    if (error != NO_ERROR)
+static bool AlreadyHooked(void* address, const std::vector<HookRecord>& batch, size_t before)
+{
+    for (const auto& hook : s_hooks)
     {
-        LogFramework("  DetourTransactionBegin failed: %ld", error);
-        return false;
+        if (hook.hook.target == reinterpret_cast<uintptr_t>(address))
+            return true;
     }
+    for (size_t i = 0; i < before; ++i)
+    {
+        if (*batch[i].target == address)
+            return true;
+    }
+    return false;
+}
 
-    DetourUpdateThread(GetCurrentThread());
+// Build every trampoline, then write every entry JMP in one set. Nothing in
+// the game's code changes unless all of them can be installed.
+static bool AttachAll(std::vector<HookRecord>& batch)
+{
+    size_t prepared = 0;
+    auto rollback = [&]() {
+        for (size_t i = 0; i < prepared; ++i)
+            InlineHook::Release(batch[i].hook);
+    };
 
-    error = DetourAttach(target, detour);
-    if (error != NO_ERROR)
+    for (auto& hook : batch)
     {
-        LogFramework("  DetourAttach failed: %ld", error);
-        DetourTransactionAbort();
-        return false;
+        const char* why = "already hooked";
+        if (AlreadyHooked(*hook.target, batch, prepared) ||
+            !InlineHook::Prepare(*hook.target, hook.detour, hook.hook, &why))
+        {
+            LogFramework("  Hook '%s' (target=0x%p) cannot be installed: %s — batch rolled back",
+                hook.name.c_str(), *hook.target, why);
+            rollback();
+            return false;
+        }
+        ++prepared;
     }
 
-    error = DetourTransactionCommit();
-    if (error != NO_ERROR)
+    std::vector<InlineHook::Hook*> set;
+    for (auto& hook : batch)
+        set.push_back(&hook.hook);
+
+    if (!InlineHook::Attach(set.data(), set.size()))
     {
-        LogFramework("  DetourTransactionCommit failed: %ld", error);
+        LogFramework("  Writing %zu hook entries failed — batch rolled back", set.size());
+        rollback();
         return false;
     }
 
-    s_hooks.push_back({ name, target, detour });
+    for (auto& hook : batch)
+        *hook.target = hook.hook.trampoline;
+    return true;
+}
+
+bool Install(const char* name, void** target, void* detour)
+{
+    LogFramework("Hooks::Install '%s' target=0x%p detour=0x%p", name, *target, detour);
+
+    std::vector<HookRecord> one;
+    one.push_back({ name, target, detour, {} });
+    if (!AttachAll(one))
+        return false;
+
+    s_hooks.push_back(std::move(one.front()));
     LogFramework("  Hook '%s' installed successfully", name);
     return true;
 }
 
+void Queue(const char* name, void** target, void* detour)
+{
+    s_pending.push_back({ name, target, detour, {} });
+}
+
+size_t CommitBatch()
+{
+    std::vector<HookRecord> batch;
+    batch.swap(s_pending);
+
+    // An unresolved address can't be attached; drop it rather than fail the batch
+    std::erase_if(batch, [](const HookRecord& hook) {
+        if (*hook.target)
+            return false;
+        LogFramework("Hooks::CommitBatch — '%s' has no target address, skipped", hook.name.c_str());
+        return true;
+    });
+    if (batch.empty())
+        return 0;
+
+    LogFramework("Hooks::CommitBatch — %zu hooks in one batch", batch.size());
+
+    if (!AttachAll(batch))
+        return 0;
+
+    for (auto& hook : batch)
+    {
+        LogFramework("  Hook '%s' installed (trampoline=0x%p detour=0x%p, %u bytes relocated)",
+            hook.name.c_str(), *hook.target, hook.detour, static_cast<unsigned int>(hook.hook.stolen));
+        s_hooks.push_back(std::move(hook));
+    }
+    return batch.size();
+}
+
 bool Remove(const char* name)
 {
     for (auto it = s_hooks.begin(); it != s_hooks.end(); ++it)
@@ -67,21 +154,12 @@ bool Remove(const char* name)
         {
             LogFramework("Hooks::Remove '%s'", name);
 
-            LONG error = DetourTransactionBegin();
-            if (error != NO_ERROR) return false;
-
-            DetourUpdateThread(GetCurrentThread());
-
-            error = DetourDetach(it->target, it->detour);
-            if (error != NO_ERROR)
-            {
-                DetourTransactionAbort();
+            InlineHook::Hook* set[] = { &it->hook };
+            if (!InlineHook::Detach(set, 1))
                 return false;
-            }
-
-            error = DetourTransactionCommit();
-            if (error != NO_ERROR) return false;
 
+            *it->target = reinterpret_cast<void*>(it->hook.target);
+            InlineHook::Release(it->hook);
             s_hooks.erase(it);
             LogFramework("  Hook '%s' removed", name);
             return true;
@@ -95,35 +173,108 @@ bool Remove(const char* name)
 void RemoveAll()
 {
     LogFramework("Hooks::RemoveAll — %zu hooks to remove", s_hooks.size());
+    s_pending.clear();
 
     if (s_hooks.empty())
         return;
 
-    LONG error = DetourTransactionBegin();
-    if (error != NO_ERROR)
+    std::vector<InlineHook::Hook*> set;
+    for (auto& hook : s_hooks)
+        set.push_back(&hook.hook);
+
+    if (!InlineHook::Detach(set.data(), set.size()))
     {
-        LogFramework("  DetourTransactionBegin failed: %ld", error);
+        LogFramework("  Restoring hook entries failed");
         return;
     }
 
-    DetourUpdateThread(GetCurrentThread());
+    for (auto& hook : s_hooks)
+    {
+        *hook.target = reinterpret_cast<void*>(hook.hook.target);
+        InlineHook::Release(hook.hook);
+    }
 
+    LogFramework("  All hooks removed");
+    s_hooks.clear();
+}
+
+// ---------------------------------------------------------------------------
+// Runtime toggle
+// ---------------------------------------------------------------------------
+
+bool SetEnabled(const char* name, bool enabled)
+{
+    HookRecord* hook = Find(name);
+    if (!hook)
+        return false;
+
+    InlineHook::SetEnabled(hook->hook, enabled);
+    return true;
+}
+
+bool IsEnabled(const char* name)
+{
+    const HookRecord* hook = Find(name);
+    return hook && InlineHook::IsEnabled(hook->hook);
+}
+
+void Command(eqlib::PlayerClient* pChar, const char* szLine)
+{
+    char action[8] = {};
+    char name[64] = {};
+    int fields = sscanf_s(szLine, "%7s %63s", action, static_cast<unsigned>(sizeof(action)),
+        name, static_cast<unsigned>(sizeof(name)));
+
+    if (fields <= 0 || _stricmp(action, "list") == 0)
+    {
+        WriteChatf("/hook: %zu installed", s_hooks.size());
+        for (const auto& hook : s_hooks)
+        {
+            WriteChatf("  %-22s %-3s 0x%08X", hook.name.c_str(), InlineHook::IsEnabled(hook.hook) ? "on" : "off",
+                static_cast<unsigned int>(hook.hook.target));
+        }
+        return;
+    }
+
+    bool on = _stricmp(action, "on") == 0;
+    if (fields < 2 || (!on && _stricmp(action, "off") != 0))
+    {
+        WriteChatf("Usage: /hook [list] | /hook <on|off> <name|all>");
+        return;
+    }
+
+    // "all" leaves the command hook alone; naming it directly is refused
+    bool all = _stricmp(name, "all") == 0;
+    const char* label = name;
+    std::vector<InlineHook::Hook*> set;
     for (auto& hook : s_hooks)
     {
-        error = DetourDetach(hook.target, hook.detour);
-        if (error != NO_ERROR)
-            LogFramework("  DetourDetach '%s' failed: %ld", hook.name.c_str(), error);
+        if (all ? hook.name != kCommandHook : _stricmp(hook.name.c_str(), name) == 0)
+        {
+            set.push_back(&hook.hook);
+            if (!all)
+                label = hook.name.c_str();
+        }
     }
 
-    error = DetourTransactionCommit();
-    if (error != NO_ERROR)
+    if (set.empty())
     {
-        LogFramework("  DetourTransactionCommit failed: %ld", error);
+        if (all)
+            WriteChatf("/hook: nothing to change");
+        else
+            WriteChatf("/hook: no installed hook named '%s'", name);
+        return;
+    }
+    if (!all && !on && strcmp(label, kCommandHook) == 0)
+    {
+        WriteChatf("/hook: %s carries slash commands and stays on", kCommandHook);
         return;
     }
 
-    LogFramework("  All hooks removed");
-    s_hooks.clear();
+    for (InlineHook::Hook* hook : set)
+        InlineHook::SetEnabled(*hook, on);
+    WriteChatf("/hook: %s %s", label, on ? "on" : "off");
+    LogFramework("Hooks: %s turned %s by /hook", label, on ? "on" : "off");
 }
 
 } // namespace Hooks
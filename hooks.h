@@ -1,6 +1,6 @@
 /**
  * @file hooks.h
- * @brief Detour management — install, remove, and track function hooks via MS Detours.
+ * @brief Detour management — install, remove, and track function hooks (inline_hook engine).
  * @date 2026-02-07
  *
  * @copyright Copyright (c) 2026
@@ -8,19 +8,43 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
+namespace eqlib { class PlayerClient; }
+
 namespace Hooks
 {
 
 // Install a detour. target must point to a function pointer that holds the
 // original address; it will be overwritten with the trampoline on success.
+// Patches the entry on its own — prefer Queue() during initialization.
 bool Install(const char* name, void** target, void* detour);
 
+// Batch install. Core and mods Queue() their detours from Initialize(); Core
+// then calls CommitBatch() once, which builds every trampoline before writing
+// any entry JMP. All-or-nothing: if any target can't be relocated or the
+// writes fail, every target pointer keeps its original address and nothing
+// is installed. Entries whose target is null are dropped (logged)
+// before anything is prepared. Returns the number of hooks installed.
+void   Queue(const char* name, void** target, void* detour);
+size_t CommitBatch();
+
 // Remove a previously installed detour by name.
 bool Remove(const char* name);
 
 // Remove all installed detours (called during shutdown).
 void RemoveAll();
 
+// Turn an installed hook off or back on without removing it. This flips the
+// hook's gate byte (see inline_hook.h): one atomic store, with no code write or
+// page protection change. Off, the target runs its original code through the
+// trampoline and the detour is skipped. Cheap enough to flip per frame for A/B
+// timing. Returns false if name isn't installed.
+bool SetEnabled(const char* name, bool enabled);
+bool IsEnabled(const char* name);
+
+// /hook [list] | /hook <on|off> <name|all>
+void Command(eqlib::PlayerClient* pChar, const char* szLine);
+
 } // namespace Hooks
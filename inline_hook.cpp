@@ -0,0 +1,290 @@
+/**
+ * @file inline_hook.cpp
+ * @brief Trampoline slab allocator and batched entry patching for the inline hook engine.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "pch.h"
+#include "inline_hook.h"
+#include "memory.h"
+#include "x86_decode.h"
+#include "core.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+namespace InlineHook
+{
+
+// ---------------------------------------------------------------------------
+// Trampoline slots
+// ---------------------------------------------------------------------------
+
+// Each slot starts with the on/off gate the entry JMP lands on:
+//   cmp byte ptr [gate], 0     80 3D <gate> 00
+//   jne detour                 0F 85 <rel32>
+// and falls through into the trampoline proper when the gate is 0. EFLAGS
+// are dead at a call boundary, so the cmp is free to clobber them.
+constexpr size_t kGateSize = 7 + 6;
+
+// Gate, relocated prologue (worst case 3x the stolen bytes), JMP back
+constexpr size_t kSlotSize = 128;
+constexpr size_t kSlabSize = 64 * 1024;
+
+// How far past the target to look for a free region before taking any
+constexpr uintptr_t kSearchRange = 256u * 1024 * 1024;
+
+static_assert(kGateSize + X86::MaxRelocatedSize(kMaxStolen) + X86::kJmpRel32Size <= kSlotSize);
+
+struct Slot
+{
+    uint8_t*              code;
+    std::atomic<uint8_t>* gate;   // read/write data; the code slab is never writable
+};
+
+// Slabs (and their gate arrays) live for the life of the process; released
+// slots are reused
+static std::vector<Slot> s_freeSlots;
+
+static void* AllocSlabNear(uintptr_t target)
+{
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    const uintptr_t gran = info.dwAllocationGranularity ? info.dwAllocationGranularity : 0x10000;
+    const uintptr_t limit = std::min<uintptr_t>(
+        reinterpret_cast<uintptr_t>(info.lpMaximumApplicationAddress),
+        target + std::min(kSearchRange, UINTPTR_MAX - target));
+
+    MEMORY_BASIC_INFORMATION mbi;
+    uintptr_t p = target & ~(gran - 1);
+    while (p < limit && VirtualQuery(reinterpret_cast<void*>(p), &mbi, sizeof(mbi)))
+    {
+        uintptr_t regionBase = reinterpret_cast<uintptr_t>(mbi.BaseAddress);
+        uintptr_t regionEnd  = regionBase + mbi.RegionSize;
+        if (mbi.State == MEM_FREE)
+        {
+            uintptr_t start = (regionBase + gran - 1) & ~(gran - 1);
+            if (start >= regionBase && start + kSlabSize <= regionEnd)
+            {
+                void* slab = VirtualAlloc(reinterpret_cast<void*>(start), kSlabSize,
+                    MEM_RESERVE | MEM_COMMIT, PAGE_EXECUTE_READ);
+                if (slab)
+                    return slab;
+            }
+        }
+        if (regionEnd <= p)
+            break;
+        p = regionEnd;
+    }
+
+    return VirtualAlloc(nullptr, kSlabSize, MEM_RESERVE | MEM_COMMIT, PAGE_EXECUTE_READ);
+}
+
+static bool AllocSlot(uintptr_t target, Slot& slot)
+{
+    if (s_freeSlots.empty())
+    {
+        auto* slab = static_cast<uint8_t*>(AllocSlabNear(target));
+        if (!slab)
+            return false;
+        constexpr size_t kSlots = kSlabSize / kSlotSize;
+        auto* gates = new std::atomic<uint8_t>[kSlots]();
+        for (size_t i = kSlots; i-- > 0;)
+            s_freeSlots.push_back({ slab + i * kSlotSize, &gates[i] });
+        LogFramework("InlineHook: trampoline slab at 0x%p (%zu slots)", slab, kSlots);
+    }
+
+    slot = s_freeSlots.back();
+    s_freeSlots.pop_back();
+    return true;
+}
+
+static bool WriteSlot(uint8_t* slot, const uint8_t* code)
+{
+    DWORD oldProtect;
+    if (!VirtualProtect(slot, kSlotSize, PAGE_EXECUTE_READWRITE, &oldProtect))
+        return false;
+    memcpy(slot, code, kSlotSize);
+    VirtualProtect(slot, kSlotSize, oldProtect, &oldProtect);
+    FlushInstructionCache(GetCurrentProcess(), slot, kSlotSize);
+    return true;
+}
+
+static void FreeSlot(const Slot& slot)
+{
+    uint8_t fill[kSlotSize];
+    memset(fill, 0xCC, sizeof(fill));
+    WriteSlot(slot.code, fill);
+    slot.gate->store(0, std::memory_order_relaxed);
+    s_freeSlots.push_back(slot);
+}
+
+static void WriteGate(uint8_t* dst, uint32_t at, const std::atomic<uint8_t>* gate, uint32_t detour)
+{
+    static_assert(sizeof(std::atomic<uint8_t>) == 1 && std::atomic<uint8_t>::is_always_lock_free);
+    const uint32_t flag = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(gate));
+    const int32_t rel = static_cast<int32_t>(detour - (at + kGateSize));
+    dst[0] = 0x80;
+    dst[1] = 0x3D;
+    memcpy(dst + 2, &flag, sizeof(flag));
+    dst[6] = 0x00;
+    dst[7] = 0x0F;
+    dst[8] = 0x85;
+    memcpy(dst + 9, &rel, sizeof(rel));
+}
+
+// Bytes readable from address, up to want (the prologue may run into the
+// next region)
+static size_t ReadableBytes(uintptr_t address, size_t want)
+{
+    size_t avail = 0;
+    while (avail < want)
+    {
+        MEMORY_BASIC_INFORMATION mbi;
+        if (!VirtualQuery(reinterpret_cast<void*>(address + avail), &mbi, sizeof(mbi)))
+            break;
+        if (mbi.State != MEM_COMMIT || (mbi.Protect & (PAGE_NOACCESS | PAGE_GUARD)))
+            break;
+        avail = reinterpret_cast<uintptr_t>(mbi.BaseAddress) + mbi.RegionSize - address;
+    }
+    return std::min(avail, want);
+}
+
+// ---------------------------------------------------------------------------
+// Public API
+// ---------------------------------------------------------------------------
+
+bool Prepare(void* target, void* detour, Hook& hook, const char** error)
+{
+    auto fail = [error](const char* why) {
+        if (error)
+            *error = why;
+        return false;
+    };
+
+    if (!target || !detour)
+        return fail("null target or detour");
+
+    const uintptr_t at = reinterpret_cast<uintptr_t>(target);
+    const size_t avail = ReadableBytes(at, 2 * X86::kMaxInsnLength);
+    if (avail < X86::kJmpRel32Size)
+        return fail("target is not readable");
+
+    Slot slot;
+    if (!AllocSlot(at, slot))
+        return fail("no memory for trampoline");
+
+    const uint32_t slotAddr = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(slot.code));
+    const uint32_t trampAddr = slotAddr + kGateSize;
+
+    uint8_t code[kSlotSize];
+    memset(code, 0xCC, sizeof(code));
+    WriteGate(code, slotAddr, slot.gate, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(detour)));
+
+    X86::RelocResult reloc;
+    bool ok = X86::Relocate(static_cast<const uint8_t*>(target), avail, static_cast<uint32_t>(at),
+        X86::kJmpRel32Size, code + kGateSize, kSlotSize - kGateSize - X86::kJmpRel32Size, trampAddr, reloc);
+    if (!ok || reloc.consumed > kMaxStolen)
+    {
+        s_freeSlots.push_back(slot);
+        return fail(ok ? "prologue too long" : X86::RelocErrorName(reloc.error));
+    }
+
+    X86::WriteJmpRel32(code + kGateSize + reloc.produced, trampAddr + static_cast<uint32_t>(reloc.produced),
+        static_cast<uint32_t>(at + reloc.consumed));
+
+    // On from the first call once attached
+    slot.gate->store(1, std::memory_order_relaxed);
+    if (!WriteSlot(slot.code, code))
+    {
+        FreeSlot(slot);
+        return fail("trampoline not writable");
+    }
+
+    hook.target     = at;
+    hook.detour     = detour;
+    hook.entry      = slot.code;
+    hook.trampoline = slot.code + kGateSize;
+    hook.gate       = slot.gate;
+    hook.stolen     = static_cast<uint8_t>(reloc.consumed);
+    hook.attached   = false;
+    memcpy(hook.original, target, reloc.consumed);
+    return true;
+}
+
+bool Attach(Hook* const* hooks, size_t count)
+{
+    std::vector<std::array<uint8_t, kMaxStolen>> entries;
+    std::vector<Hook*> changing;
+    entries.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        Hook* hook = hooks[i];
+        if (hook->attached || !hook->entry)
+            continue;
+
+        auto& entry = entries.emplace_back();
+        entry.fill(0xCC);
+        X86::WriteJmpRel32(entry.data(), static_cast<uint32_t>(hook->target),
+            static_cast<uint32_t>(reinterpret_cast<uintptr_t>(hook->entry)));
+        changing.push_back(hook);
+    }
+
+    std::vector<Memory::Write> writes;
+    for (size_t i = 0; i < changing.size(); ++i)
+        writes.push_back({ changing[i]->target, entries[i].data(), changing[i]->stolen });
+
+    if (!Memory::WriteBatch(writes))
+        return false;
+    for (Hook* hook : changing)
+        hook->attached = true;
+    return true;
+}
+
+bool Detach(Hook* const* hooks, size_t count)
+{
+    std::vector<Hook*> changing;
+    std::vector<Memory::Write> writes;
+    for (size_t i = 0; i < count; ++i)
+    {
+        Hook* hook = hooks[i];
+        if (!hook->attached)
+            continue;
+        changing.push_back(hook);
+        writes.push_back({ hook->target, hook->original, hook->stolen });
+    }
+
+    if (!Memory::WriteBatch(writes))
+        return false;
+    for (Hook* hook : changing)
+        hook->attached = false;
+    return true;
+}
+
+void SetEnabled(Hook& hook, bool enabled)
+{
+    if (hook.gate)
+        hook.gate->store(enabled ? 1 : 0, std::memory_order_release);
+}
+
+bool IsEnabled(const Hook& hook)
+{
+    return hook.gate && hook.gate->load(std::memory_order_relaxed) != 0;
+}
+
+void Release(Hook& hook)
+{
+    if (!hook.entry || hook.attached)
+        return;
+    FreeSlot({ hook.entry, hook.gate });
+    hook.entry      = nullptr;
+    hook.trampoline = nullptr;
+    hook.gate       = nullptr;
+}
+
+} // namespace InlineHook
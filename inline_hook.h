@@ -0,0 +1,78 @@
+/**
+ * @file inline_hook.h
+ * @brief 32-bit inline hook engine — trampolines built with x86_decode, entry JMPs written in page-batched sets.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * A hook is two steps:
+ *
+ *   Prepare()  relocates the first whole instructions (>= 5 bytes) of the
+ *              target into a trampoline slot and appends a JMP back to the
+ *              rest of the function. Nothing in the target is touched, so a
+ *              failed Prepare leaves the game exactly as it was.
+ *   Attach()   writes `JMP slot` over the target's entry (INT3 over any
+ *              leftover stolen bytes) for a whole set of hooks at once.
+ *
+ * Each slot opens with a gate: `cmp byte [gate], 0 / jne detour`, falling
+ * through into the trampoline when the gate byte is 0. SetEnabled() is a
+ * single atomic byte store, with no page protection change, instruction
+ * cache flush or code write. That makes it safe to flip per frame, or from
+ * another thread while the target runs. An attached hook pays the cmp and a
+ * predicted branch on every call, on or off.
+ *
+ * Detach() puts the saved bytes back. The trampoline stays valid, so a hook
+ * can be attached again without preparing it again. Release() frees the slot
+ * once the hook is detached for good.
+ *
+ * Trampolines live in 64 KB executable slabs allocated as close to the
+ * first target as a free region allows. On x86 a rel32 reaches the whole
+ * address space, so proximity only keeps trampolines beside the code they
+ * came from; any slab works.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace InlineHook
+{
+
+// Whole instructions stolen from the target: a 5-byte JMP can split the last
+// one, which may be up to 15 bytes long.
+constexpr size_t kMaxStolen = 5 + 15 - 1;
+
+struct Hook
+{
+    uintptr_t             target = 0;
+    void*                 detour = nullptr;
+    uint8_t*              entry = nullptr;       // slot start (the gate); the entry JMP lands here
+    uint8_t*              trampoline = nullptr;  // call this to run the original
+    std::atomic<uint8_t>* gate = nullptr;        // nonzero = detour runs
+    uint8_t               stolen = 0;            // bytes replaced at target
+    uint8_t               original[kMaxStolen] = {};
+    bool                  attached = false;      // entry JMP written
+};
+
+// Build the gated trampoline for target, with the gate on. On failure returns false and, if error is
+// non-null, points it at a static description.
+bool Prepare(void* target, void* detour, Hook& hook, const char** error = nullptr);
+
+// Write (or restore) the entry of every hook in the set: each touched page is
+// unprotected once and the instruction cache flushed once. Either every hook
+// in the set changes state or none does. Hooks already in the requested state
+// are skipped.
+bool Attach(Hook* const* hooks, size_t count);
+bool Detach(Hook* const* hooks, size_t count);
+
+// Flip the gate. When off, an attached hook runs the original code and the
+// detour is never entered. The setting survives Detach/Attach.
+void SetEnabled(Hook& hook, bool enabled);
+bool IsEnabled(const Hook& hook);
+
+// Return the trampoline slot. The hook must be detached.
+void Release(Hook& hook);
+
+} // namespace InlineHook
@@ -0,0 +1,364 @@
+/**
+ * @file log_format.h
+ * @brief On-disk layout of dinput8_proxy.blog (deferred-format binary log) and the
+ *        argument encoder shared by the DLL and tools/blog_decode.cpp.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Portable header — no Windows or eqlib dependencies, so the decoder builds on Linux.
+ *
+ * File layout:
+ *   FileHeader
+ *   RecordHeader + payload, repeated
+ *
+ * Record kinds:
+ *   Text       payload is a preformatted line (LogFramework calls, drop notices)
+ *   FormatDef  payload is the format string for formatId; written once per ID
+ *              before the first Format record that uses it
+ *   Format     payload is the encoded argument list for formatId
+ *
+ * Each encoded argument is a one-byte ArgType tag followed by its value in
+ * little-endian order; strings are a uint16 length followed by the bytes.
+ *
+ * Render() turns a format string plus encoded arguments back into text. The
+ * Logger writer thread uses it for text builds and blog_decode uses it offline,
+ * so both produce byte-identical lines.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace BlogFormat
+{
+
+constexpr char     kMagic[4] = { 'B', 'L', 'O', 'G' };
+constexpr uint16_t kVersion  = 1;
+
+enum class RecordKind : uint8_t
+{
+    Text      = 1,
+    FormatDef = 2,
+    Format    = 3,
+};
+
+enum class ArgType : uint8_t
+{
+    I32 = 1,
+    U32 = 2,
+    I64 = 3,
+    U64 = 4,
+    F64 = 5,
+    Ptr = 6,   // stored as uint64; rendered at FileHeader::pointerSize width
+    Str = 7,   // uint16 length + bytes (no terminator)
+};
+
+#pragma pack(push, 1)
+struct FileHeader
+{
+    char     magic[4];
+    uint16_t version;
+    uint8_t  pointerSize;   // sizeof(void*) in the writing process, for %p width
+    uint8_t  reserved;
+};
+
+struct RecordHeader
+{
+    uint8_t  kind;          // RecordKind
+    uint8_t  reserved;
+    uint16_t size;          // payload bytes following this header
+    uint32_t formatId;      // 0 for Text records
+    uint32_t stamp;         // seconds since the epoch
+};
+#pragma pack(pop)
+
+// Compile-time format-string ID (FNV-1a). Used as the key for FormatDef records.
+constexpr uint32_t FormatId(std::string_view fmt)
+{
+    uint32_t hash = 2166136261u;
+    for (char c : fmt)
+    {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 16777619u;
+    }
+    return hash ? hash : 1u;  // 0 is reserved for Text records
+}
+
+// ---------------------------------------------------------------------------
+// Argument encoding
+// ---------------------------------------------------------------------------
+
+// Append one tagged value. Returns false (leaving `used` unchanged) if it doesn't fit.
+inline bool PutValue(uint8_t* buf, size_t cap, size_t& used, ArgType type, const void* value, size_t size)
+{
+    if (used + 1 + size > cap)
+        return false;
+    buf[used] = static_cast<uint8_t>(type);
+    memcpy(buf + used + 1, value, size);
+    used += 1 + size;
+    return true;
+}
+
+inline bool PutString(uint8_t* buf, size_t cap, size_t& used, const char* s)
+{
+    if (!s)
+        s = "(null)";
+    if (used + 3 > cap)
+        return false;
+    size_t len = strlen(s);
+    if (len > cap - used - 3)
+        len = cap - used - 3;  // truncate to what fits
+    uint16_t len16 = static_cast<uint16_t>(len);
+    buf[used] = static_cast<uint8_t>(ArgType::Str);
+    memcpy(buf + used + 1, &len16, sizeof(len16));
+    memcpy(buf + used + 3, s, len);
+    used += 3 + len;
+    return true;
+}
+
+template <typename T>
+inline bool PutArg(uint8_t* buf, size_t cap, size_t& used, const T& arg)
+{
+    using U = std::decay_t<T>;
+
+    if constexpr (std::is_same_v<U, char*> || std::is_same_v<U, const char*>)
+    {
+        return PutString(buf, cap, used, arg);
+    }
+    else if constexpr (std::is_pointer_v<U> || std::is_null_pointer_v<U>)
+    {
+        uint64_t v = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(arg));
+        return PutValue(buf, cap, used, ArgType::Ptr, &v, sizeof(v));
+    }
+    else if constexpr (std::is_floating_point_v<U>)
+    {
+        double v = static_cast<double>(arg);
+        return PutValue(buf, cap, used, ArgType::F64, &v, sizeof(v));
+    }
+    else if constexpr (std::is_enum_v<U>)
+    {
+        return PutArg(buf, cap, used, static_cast<std::underlying_type_t<U>>(arg));
+    }
+    else if constexpr (std::is_integral_v<U>)
+    {
+        // Match printf's default promotions: anything up to 32 bits travels as 32 bits.
+        if constexpr (sizeof(U) <= 4 && std::is_signed_v<U>)
+        {
+            int32_t v = static_cast<int32_t>(arg);
+            return PutValue(buf, cap, used, ArgType::I32, &v, sizeof(v));
+        }
+        else if constexpr (sizeof(U) <= 4)
+        {
+            uint32_t v = static_cast<uint32_t>(arg);
+            return PutValue(buf, cap, used, ArgType::U32, &v, sizeof(v));
+        }
+        else if constexpr (std::is_signed_v<U>)
+        {
+            int64_t v = static_cast<int64_t>(arg);
+            return PutValue(buf, cap, used, ArgType::I64, &v, sizeof(v));
+        }
+        else
+        {
+            uint64_t v = static_cast<uint64_t>(arg);
+            return PutValue(buf, cap, used, ArgType::U64, &v, sizeof(v));
+        }
+    }
+    else
+    {
+        static_assert(sizeof(U) == 0, "LOG_DEFERRED: unsupported argument type");
+        return false;
+    }
+}
+
+// Encode an argument list into buf. Returns the number of bytes used; arguments
+// that don't fit are omitted (the decoder prints them as "<?>").
+template <typename... Args>
+inline size_t EncodeArgs(uint8_t* buf, size_t cap, const Args&... args)
+{
+    size_t used = 0;
+    (void)(PutArg(buf, cap, used, args) && ...);
+    return used;
+}
+
+// ---------------------------------------------------------------------------
+// Rendering
+// ---------------------------------------------------------------------------
+
+// Cursor over an encoded argument list.
+struct ArgReader
+{
+    const uint8_t* p;
+    const uint8_t* end;
+
+    bool Next(ArgType& type, uint64_t& bits, double& real, std::string_view& str)
+    {
+        if (p >= end)
+            return false;
+        type = static_cast<ArgType>(*p++);
+        size_t size = 0;
+        switch (type)
+        {
+        case ArgType::I32: case ArgType::U32:                     size = 4; break;
+        case ArgType::I64: case ArgType::U64: case ArgType::Ptr:  size = 8; break;
+        case ArgType::F64:                                        size = 8; break;
+        case ArgType::Str:
+        {
+            uint16_t len;
+            if (end - p < 2) { p = end; return false; }
+            memcpy(&len, p, 2);
+            p += 2;
+            if (static_cast<size_t>(end - p) < len) { p = end; return false; }
+            str = std::string_view(reinterpret_cast<const char*>(p), len);
+            p += len;
+            return true;
+        }
+        default:
+            p = end;  // unknown tag — stop decoding this record
+            return false;
+        }
+        if (static_cast<size_t>(end - p) < size) { p = end; return false; }
+
+        if (type == ArgType::F64)
+        {
+            memcpy(&real, p, 8);
+        }
+        else if (type == ArgType::I32)
+        {
+            int32_t v; memcpy(&v, p, 4);
+            bits = static_cast<uint64_t>(static_cast<int64_t>(v));
+        }
+        else if (type == ArgType::U32)
+        {
+            uint32_t v; memcpy(&v, p, 4);
+            bits = v;
+        }
+        else
+        {
+            memcpy(&bits, p, 8);
+        }
+        p += size;
+        return true;
+    }
+};
+
+// Format `fmt` against an encoded argument list, appending to `out`.
+// Length modifiers in the format string are ignored — the argument's own type
+// decides the width — and %p renders the way the MSVC CRT does (zero-padded
+// uppercase hex, no prefix) so output matches LogFramework's text lines.
+inline void Render(std::string& out, std::string_view fmt, const uint8_t* args, size_t size,
+    unsigned pointerSize = sizeof(void*))
+{
+    ArgReader reader{ args, args + size };
+    char tmp[512];
+
+    for (size_t i = 0; i < fmt.size(); ++i)
+    {
+        char c = fmt[i];
+        if (c != '%')
+        {
+            out.push_back(c);
+            continue;
+        }
+        if (i + 1 < fmt.size() && fmt[i + 1] == '%')
+        {
+            out.push_back('%');
+            ++i;
+            continue;
+        }
+
+        // Collect flags / width / precision, substituting '*' from the argument list
+        std::string spec = "%";
+        size_t j = i + 1;
+        while (j < fmt.size() && strchr("-+ #0", fmt[j]))
+            spec.push_back(fmt[j++]);
+        for (int part = 0; part < 2; ++part)
+        {
+            if (part == 1)
+            {
+                if (j >= fmt.size() || fmt[j] != '.')
+                    break;
+                spec.push_back(fmt[j++]);
+            }
+            if (j < fmt.size() && fmt[j] == '*')
+            {
+                ArgType t; uint64_t bits = 0; double real; std::string_view str;
+                reader.Next(t, bits, real, str);
+                spec += std::to_string(static_cast<int>(static_cast<int64_t>(bits)));
+                ++j;
+            }
+            while (j < fmt.size() && fmt[j] >= '0' && fmt[j] <= '9')
+                spec.push_back(fmt[j++]);
+        }
+
+        // Skip length modifiers (h hh l ll j z t L q w I I32 I64)
+        while (j < fmt.size() && strchr("hljztLqwI", fmt[j]))
+        {
+            if (fmt[j] == 'I' && fmt.substr(j, 3) == "I64") j += 3;
+            else if (fmt[j] == 'I' && fmt.substr(j, 3) == "I32") j += 3;
+            else ++j;
+        }
+        if (j >= fmt.size())
+            break;
+        char conv = fmt[j];
+        i = j;
+
+        ArgType type; uint64_t bits = 0; double real = 0.0; std::string_view str;
+        if (!reader.Next(type, bits, real, str))
+        {
+            out += "<?>";
+            continue;
+        }
+
+        int n = -1;
+        if (conv == 's' && type == ArgType::Str)
+        {
+            spec += (spec.find('.') == std::string::npos) ? ".*s" : "s";
+            if (spec.find(".*") != std::string::npos)
+                n = snprintf(tmp, sizeof(tmp), spec.c_str(), static_cast<int>(str.size()), std::string(str).c_str());
+            else
+                n = snprintf(tmp, sizeof(tmp), spec.c_str(), std::string(str).c_str());
+        }
+        else if (conv == 'p' && type != ArgType::Str && type != ArgType::F64)
+        {
+            n = snprintf(tmp, sizeof(tmp), "%0*llX", static_cast<int>(pointerSize * 2),
+                static_cast<unsigned long long>(bits));
+        }
+        else if (strchr("fFeEgGaA", conv) && type == ArgType::F64)
+        {
+            spec.push_back(conv);
+            n = snprintf(tmp, sizeof(tmp), spec.c_str(), real);
+        }
+        else if (conv == 'c' && (type == ArgType::I32 || type == ArgType::U32))
+        {
+            spec.push_back('c');
+            n = snprintf(tmp, sizeof(tmp), spec.c_str(), static_cast<int>(bits));
+        }
+        else if (strchr("di", conv) && type != ArgType::Str && type != ArgType::F64)
+        {
+            spec += "lld";
+            n = snprintf(tmp, sizeof(tmp), spec.c_str(), static_cast<long long>(bits));
+        }
+        else if (strchr("uxXo", conv) && type != ArgType::Str && type != ArgType::F64)
+        {
+            // 32-bit arguments were sign-extended into `bits`; mask back for %u/%x
+            uint64_t v = (type == ArgType::I32) ? (bits & 0xFFFFFFFFull) : bits;
+            spec += "ll";
+            spec.push_back(conv);
+            n = snprintf(tmp, sizeof(tmp), spec.c_str(), static_cast<unsigned long long>(v));
+        }
+
+        if (n < 0)
+            out += "<?>";
+        else
+            out.append(tmp, (static_cast<size_t>(n) < sizeof(tmp)) ? static_cast<size_t>(n) : sizeof(tmp) - 1);
+    }
+}
+
+} // namespace BlogFormat
@@ -0,0 +1,105 @@
+/**
+ * @file log_ring.h
+ * @brief Bounded lock-free multi-producer ring behind the async logger.
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Vyukov's bounded sequence-numbered queue. Each slot carries a sequence
+ * counter, stored relative to the slot index so a zero-initialized ring is
+ * already valid before any constructor runs:
+ *   seq == Lap(pos)              slot is free for the producer that claims `pos`
+ *   seq == Lap(pos) + 1          slot holds a committed record for the consumer
+ *   seq == Lap(pos) + Capacity   slot has been consumed and is free for the next lap
+ * Producers claim a position with a single CAS and never block: when the ring
+ * is full the record is dropped and counted. Only one thread may Drain at a
+ * time; the caller serializes consumers.
+ *
+ * Slot is the caller's record type and must have a `std::atomic<uint32_t> seq`
+ * member. Portable — no Windows headers, so it can be benchmarked on Linux.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+template <typename Slot, uint32_t Capacity>
+class LogRing
+{
+    static_assert((Capacity & (Capacity - 1)) == 0, "LogRing capacity must be a power of two");
+
+public:
+    constexpr LogRing() = default;
+
+    LogRing(const LogRing&) = delete;
+    LogRing& operator=(const LogRing&) = delete;
+
+    // Claim the next free slot, or count a drop and return nullptr if the
+    // ring is full. Any thread. Fill the slot, then Commit it.
+    Slot* Claim(uint32_t& pos)
+    {
+        pos = m_enqueuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Slot* slot = &m_slots[pos & (Capacity - 1)];
+            uint32_t seq = slot->seq.load(std::memory_order_acquire);
+            int32_t diff = static_cast<int32_t>(seq - Lap(pos));
+
+            if (diff == 0)
+            {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    return slot;
+            }
+            else if (diff < 0)
+            {
+                // Full: drop the new record rather than block the producer
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            else
+            {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Publish a filled slot to the consumer.
+    void Commit(Slot* slot, uint32_t pos)
+    {
+        slot->seq.store(Lap(pos) + 1, std::memory_order_release);
+    }
+
+    // Pass every committed record, in claim order, to fn(const Slot&) and free
+    // its slot. Stops at the first claimed-but-uncommitted slot. Consumer only.
+    template <typename Fn>
+    uint32_t Drain(Fn&& fn)
+    {
+        uint32_t count = 0;
+        for (;;)
+        {
+            Slot& slot = m_slots[m_dequeuePos & (Capacity - 1)];
+            if (slot.seq.load(std::memory_order_acquire) != Lap(m_dequeuePos) + 1)
+                return count;
+
+            fn(static_cast<const Slot&>(slot));
+            slot.seq.store(Lap(m_dequeuePos) + Capacity, std::memory_order_release);
+            ++m_dequeuePos;
+            ++count;
+        }
+    }
+
+    // Records dropped because the ring was full (lifetime total).
+    uint32_t Dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    // Ring position with the slot index masked off: the base of the slot's sequence
+    static uint32_t Lap(uint32_t pos) { return pos & ~(Capacity - 1); }
+
+    Slot m_slots[Capacity]{};
+
+    // Producer and consumer positions on separate cache lines
+    alignas(64) std::atomic<uint32_t> m_enqueuePos{ 0 };
+    std::atomic<uint32_t>             m_dropped{ 0 };
+    alignas(64) uint32_t              m_dequeuePos = 0;
+};
@@ -0,0 +1,477 @@
+/**
+ * @file logger.cpp
+ * @brief Implementation of the asynchronous log sink — bounded MPSC ring and writer thread.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The ring is a LogRing (log_ring.h), constant-initialized so it is valid
+ * before any constructor runs. Producers claim and commit slots without
+ * blocking; there is only ever one consumer at a time, serialized by
+ * s_draining.
+ */
+
+#include "pch.h"
+#include "logger.h"
+#include "core.h"
+#include "log_ring.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdarg>
+#include <ctime>
+#include <string>
+#include <unordered_map>
+
+namespace Logger
+{
+
+// ---------------------------------------------------------------------------
+// Ring storage
+// ---------------------------------------------------------------------------
+struct SlotHeader
+{
+    std::atomic<uint32_t>  seq;
+    uint16_t               len;       // payload bytes
+    BlogFormat::RecordKind kind;      // Text or Format
+    uint32_t               stamp;     // seconds since the epoch
+    uint32_t               formatId;  // Format records only
+    const char*            fmt;       // Format records only — string literal
+};
+
+struct alignas(64) Slot : SlotHeader
+{
+    char payload[kPayloadBytes];
+};
+
+static_assert(sizeof(Slot) == kSlotBytes, "Slot must be exactly kSlotBytes");
+
+static constinit LogRing<Slot, kCapacity> s_ring;
+static uint32_t         s_droppedReported = 0;  // owned by whoever holds s_draining
+static std::atomic_flag s_draining = ATOMIC_FLAG_INIT;
+
+// Writer thread state
+static std::atomic<bool> s_started{ false };
+static std::atomic<bool> s_stopping{ false };
+static HANDLE            s_wakeEvent = nullptr;
+static HANDLE            s_writerThread = nullptr;
+
+// Wake the writer every this many records so a burst can't outrun its 50 ms poll.
+static constexpr uint32_t kWakeInterval = kCapacity / 4;
+static constexpr DWORD    kPollMs       = 50;
+
+// Output file — touched only by the drain owner.
+static FILE* s_file = nullptr;
+
+#ifdef DINPUT8_BINARY_LOG
+static constexpr const char* kLogFileName = "dinput8_proxy.blog";
+#else
+static constexpr const char* kLogFileName = "dinput8_proxy.log";
+#endif
+
+static void OpenLog()
+{
+    if (!s_file)
+    {
+        // Force-delete any stale file from a previous crash, then create fresh
+        DeleteFileA(kLogFileName);
+#ifdef DINPUT8_BINARY_LOG
+        fopen_s(&s_file, kLogFileName, "wb");
+        if (s_file)
+        {
+            BlogFormat::FileHeader header = {};
+            memcpy(header.magic, BlogFormat::kMagic, sizeof(header.magic));
+            header.version     = BlogFormat::kVersion;
+            header.pointerSize = static_cast<uint8_t>(sizeof(void*));
+            fwrite(&header, sizeof(header), 1, s_file);
+        }
+#else
+        fopen_s(&s_file, kLogFileName, "w");
+#endif
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Consumer side
+// ---------------------------------------------------------------------------
+
+#ifdef DINPUT8_BINARY_LOG
+
+// Format strings already written to this file as FormatDef records.
+static std::unordered_map<uint32_t, const char*> s_formatsWritten;
+
+static void EmitRecord(BlogFormat::RecordKind kind, uint32_t formatId, uint32_t stamp,
+    const void* payload, size_t size)
+{
+    BlogFormat::RecordHeader header = {};
+    header.kind     = static_cast<uint8_t>(kind);
+    header.size     = static_cast<uint16_t>(size);
+    header.formatId = formatId;
+    header.stamp    = stamp;
+    fwrite(&header, sizeof(header), 1, s_file);
+    fwrite(payload, 1, size, s_file);
+}
+
+static void EmitText(uint32_t stamp, const char* text, size_t len)
+{
+    EmitRecord(BlogFormat::RecordKind::Text, 0, stamp, text, len);
+}
+
+static void EmitSlot(const Slot& slot)
+{
+    if (slot.kind == BlogFormat::RecordKind::Text)
+    {
+        EmitText(slot.stamp, slot.payload, slot.len);
+        return;
+    }
+
+    auto it = s_formatsWritten.find(slot.formatId);
+    if (it == s_formatsWritten.end())
+    {
+        size_t fmtLen = strlen(slot.fmt);
+        EmitRecord(BlogFormat::RecordKind::FormatDef, slot.formatId, slot.stamp,
+            slot.fmt, fmtLen < 0xFFFF ? fmtLen : 0xFFFF);
+        s_formatsWritten.emplace(slot.formatId, slot.fmt);
+    }
+    else if (it->second != slot.fmt && strcmp(it->second, slot.fmt) != 0)
+    {
+        // Two format strings share an ID — render this one here as plain text.
+        std::string line;
+        BlogFormat::Render(line, slot.fmt, reinterpret_cast<const uint8_t*>(slot.payload), slot.len);
+        EmitText(slot.stamp, line.data(), line.size() < 0xFFFF ? line.size() : 0xFFFF);
+        return;
+    }
+
+    EmitRecord(BlogFormat::RecordKind::Format, slot.formatId, slot.stamp, slot.payload, slot.len);
+}
+
+#else
+
+// Format "[YYYY-MM-DD HH:MM:SS] " once per distinct second rather than per line.
+static const char* FormatStamp(uint32_t stamp)
+{
+    static int64_t s_lastStamp = -1;
+    static char    s_lastText[32] = {};
+
+    if (stamp != s_lastStamp)
+    {
+        time_t t = static_cast<time_t>(stamp);
+        struct tm local;
+        localtime_s(&local, &t);
+        snprintf(s_lastText, sizeof(s_lastText), "[%04d-%02d-%02d %02d:%02d:%02d] ",
+            local.tm_year + 1900, local.tm_mon + 1, local.tm_mday,
+            local.tm_hour, local.tm_min, local.tm_sec);
+        s_lastStamp = stamp;
+    }
+    return s_lastText;
+}
+
+static void EmitText(uint32_t stamp, const char* text, size_t len)
+{
+    fputs(FormatStamp(stamp), s_file);
+    fwrite(text, 1, len, s_file);
+    fputc('\n', s_file);
+}
+
+static void EmitSlot(const Slot& slot)
+{
+    if (slot.kind == BlogFormat::RecordKind::Text)
+    {
+        EmitText(slot.stamp, slot.payload, slot.len);
+        return;
+    }
+
+    static std::string s_line;
+    s_line.clear();
+    BlogFormat::Render(s_line, slot.fmt, reinterpret_cast<const uint8_t*>(slot.payload), slot.len);
+    EmitText(slot.stamp, s_line.data(), s_line.size());
+}
+
+#endif // DINPUT8_BINARY_LOG
+
+static uint32_t Now()
+{
+    return static_cast<uint32_t>(time(nullptr));
+}
+
+// Write every committed record to disk, then fflush once. Caller holds s_draining.
+static void DrainLocked()
+{
+    OpenLog();
+
+    bool wrote = false;
+    s_ring.Drain([&wrote](const Slot& slot)
+    {
+        if (s_file)
+        {
+            EmitSlot(slot);
+            wrote = true;
+        }
+    });
+
+    uint32_t dropped = s_ring.Dropped();
+    if (dropped != s_droppedReported && s_file)
+    {
+        char notice[64];
+        int n = snprintf(notice, sizeof(notice), "[Logger] %u records dropped (ring full)",
+            dropped - s_droppedReported);
+        EmitText(Now(), notice, static_cast<size_t>(n));
+        s_droppedReported = dropped;
+        wrote = true;
+    }
+
+    if (wrote)
+        fflush(s_file);
+}
+
+// Acquire the consumer role. Spins briefly, then gives up after ~250 ms so a
+// writer thread killed mid-drain at process exit can't wedge shutdown.
+static bool AcquireDrain(bool wait)
+{
+    for (int i = 0; s_draining.test_and_set(std::memory_order_acquire); ++i)
+    {
+        if (!wait || i >= 250)
+            return false;
+        Sleep(1);
+    }
+    return true;
+}
+
+static DWORD WINAPI WriterThread(LPVOID)
+{
+    while (!s_stopping.load(std::memory_order_acquire))
+    {
+        WaitForSingleObject(s_wakeEvent, kPollMs);
+        if (AcquireDrain(false))
+        {
+            DrainLocked();
+            s_draining.clear(std::memory_order_release);
+        }
+    }
+    return 0;
+}
+
+// Lazily start the writer. The first LogFramework call happens inside DllMain,
+// where CreateThread is legal but the thread only runs once the loader lock is
+// released — records simply accumulate in the ring until then.
+static void EnsureStarted()
+{
+    bool expected = false;
+    if (!s_started.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+        return;
+
+    s_wakeEvent = CreateEventA(nullptr, FALSE, FALSE, nullptr);
+    s_writerThread = CreateThread(nullptr, 0, &WriterThread, nullptr, 0, nullptr);
+}
+
+// ---------------------------------------------------------------------------
+// Producer side
+// ---------------------------------------------------------------------------
+
+// Claim the next free slot, or count a drop and return nullptr if the ring is
+// full; a drop never blocks the game thread.
+static Slot* Claim(uint32_t& pos)
+{
+    EnsureStarted();
+    return s_ring.Claim(pos);
+}
+
+// Publish a filled slot to the consumer.
+static void Commit(Slot* slot, uint32_t pos)
+{
+    slot->stamp = Now();
+    s_ring.Commit(slot, pos);
+
+    if (s_stopping.load(std::memory_order_relaxed))
+        Flush();
+    else if ((pos & (kWakeInterval - 1)) == 0 && s_wakeEvent)
+        SetEvent(s_wakeEvent);
+}
+
+bool Write(const char* fmt, va_list args)
+{
+    uint32_t pos;
+    Slot* slot = Claim(pos);
+    if (!slot)
+        return false;
+
+    int n = vsnprintf(slot->payload, sizeof(slot->payload), fmt, args);
+    if (n < 0)
+        n = 0;
+    slot->len  = static_cast<uint16_t>((static_cast<size_t>(n) < sizeof(slot->payload)) ? n : sizeof(slot->payload) - 1);
+    slot->kind = BlogFormat::RecordKind::Text;
+    Commit(slot, pos);
+    return true;
+}
+
+bool WriteDeferred(uint32_t formatId, const char* fmt, const uint8_t* args, size_t argBytes)
+{
+    uint32_t pos;
+    Slot* slot = Claim(pos);
+    if (!slot)
+        return false;
+
+    if (argBytes > sizeof(slot->payload))
+        argBytes = sizeof(slot->payload);
+    memcpy(slot->payload, args, argBytes);
+    slot->len      = static_cast<uint16_t>(argBytes);
+    slot->kind     = BlogFormat::RecordKind::Format;
+    slot->formatId = formatId;
+    slot->fmt      = fmt;
+    Commit(slot, pos);
+    return true;
+}
+
+void Flush()
+{
+    if (!AcquireDrain(true))
+        return;
+    DrainLocked();
+    s_draining.clear(std::memory_order_release);
+}
+
+void Shutdown()
+{
+    // Don't wait on the writer thread: this runs under the loader lock, and a
+    // thread can't exit while we hold it. Signal it and drain on our side.
+    s_stopping.store(true, std::memory_order_release);
+    if (s_wakeEvent)
+        SetEvent(s_wakeEvent);
+
+    Flush();
+}
+
+uint32_t GetDroppedCount()
+{
+    return s_ring.Dropped();
+}
+
+// ---------------------------------------------------------------------------
+// Category / level filtering
+// ---------------------------------------------------------------------------
+
+static const char* const kCategoryNames[] =
+{
+    "framework",
+    "hooks",
+    "commands",
+    "spellbookunlock",
+    "combatabilities",
+    "statsoverride",
+};
+static_assert(sizeof(kCategoryNames) / sizeof(kCategoryNames[0]) == static_cast<size_t>(LogCategory::Count),
+    "kCategoryNames must match LogCategory");
+
+static const char* const kLevelNames[] = { "trace", "debug", "info", "warn", "error", "off" };
+static_assert(sizeof(kLevelNames) / sizeof(kLevelNames[0]) == kLevelCount + 1,
+    "kLevelNames must match LogLevel (plus 'off')");
+
+// Mask with `level` and everything above it enabled for one category.
+static constexpr uint64_t ThresholdBits(LogCategory cat, LogLevel level)
+{
+    uint64_t bits = 0;
+    for (unsigned l = static_cast<unsigned>(level); l < kLevelCount; ++l)
+        bits |= MaskBit(cat, static_cast<LogLevel>(l));
+    return bits;
+}
+
+static constexpr uint64_t DefaultMask()
+{
+    uint64_t mask = 0;
+    for (unsigned c = 0; c < static_cast<unsigned>(LogCategory::Count); ++c)
+        mask |= ThresholdBits(static_cast<LogCategory>(c), LogLevel::Info);
+    return mask;
+}
+
+std::atomic<uint64_t> g_enabledMask{ DefaultMask() };
+
+void SetThreshold(LogCategory cat, LogLevel level)
+{
+    uint64_t mask = g_enabledMask.load(std::memory_order_relaxed);
+    mask = (mask & ~ThresholdBits(cat, LogLevel::Trace)) | ThresholdBits(cat, level);
+    g_enabledMask.store(mask, std::memory_order_relaxed);
+}
+
+// Lowest enabled level for a category, or LogLevel::Count if all are off.
+static LogLevel GetThreshold(LogCategory cat)
+{
+    for (unsigned l = 0; l < kLevelCount; ++l)
+    {
+        if (IsEnabled(cat, static_cast<LogLevel>(l)))
+            return static_cast<LogLevel>(l);
+    }
+    return LogLevel::Count;
+}
+
+static bool ParseLevel(const char* name, LogLevel& out)
+{
+    for (unsigned l = 0; l <= kLevelCount; ++l)
+    {
+        if (_stricmp(name, kLevelNames[l]) == 0)
+        {
+            out = static_cast<LogLevel>(l);
+            return true;
+        }
+    }
+    return false;
+}
+
+void Command(eqlib::PlayerClient* pChar, const char* szLine)
+{
+    char category[32] = {};
+    char level[16] = {};
+    int fields = sscanf_s(szLine, "%31s %15s", category, static_cast<unsigned>(sizeof(category)),
+        level, static_cast<unsigned>(sizeof(level)));
+
+    if (fields < 2)
+    {
+        WriteChatf("Usage: /log <category|all> <trace|debug|info|warn|error|off>");
+        for (unsigned c = 0; c < static_cast<unsigned>(LogCategory::Count); ++c)
+        {
+            WriteChatf("  %-16s %s", kCategoryNames[c],
+                kLevelNames[static_cast<unsigned>(GetThreshold(static_cast<LogCategory>(c)))]);
+        }
+        WriteChatf("  (levels below '%s' are compiled out)", kLevelNames[LOG_COMPILE_LEVEL]);
+        return;
+    }
+
+    LogLevel newLevel;
+    if (!ParseLevel(level, newLevel))
+    {
+        WriteChatf("/log: unknown level '%s'", level);
+        return;
+    }
+
+    bool all = _stricmp(category, "all") == 0;
+    bool matched = false;
+    for (unsigned c = 0; c < static_cast<unsigned>(LogCategory::Count); ++c)
+    {
+        if (all || _stricmp(category, kCategoryNames[c]) == 0)
+        {
+            SetThreshold(static_cast<LogCategory>(c), newLevel);
+            matched = true;
+        }
+    }
+
+    if (!matched)
+    {
+        WriteChatf("/log: unknown category '%s'", category);
+        return;
+    }
+
+    WriteChatf("/log: %s -> %s", category, kLevelNames[static_cast<unsigned>(newLevel)]);
+    LogFramework("Log threshold changed: %s -> %s", category, kLevelNames[static_cast<unsigned>(newLevel)]);
+}
+
+} // namespace Logger
+
+// ---------------------------------------------------------------------------
+// LogFramework — public entry point declared in core.h
+// ---------------------------------------------------------------------------
+void LogFramework(const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    Logger::Write(fmt, args);
+    va_end(args);
+}
@@ -0,0 +1,161 @@
+/**
+ * @file logger.h
+ * @brief Asynchronous log sink — lock-free MPSC ring drained by a background writer thread.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * LogFramework() (declared in core.h) formats directly into a ring slot on the
+ * caller's thread and returns; the writer thread owns all file I/O and issues
+ * one fflush per drained batch, so detours never block on disk.
+ *
+ * Overflow policy: when the ring is full the NEW record is dropped and counted.
+ * The writer emits a single "N records dropped" line the next time it drains.
+ * Lines longer than the slot payload are truncated.
+ *
+ * LOG_DEFERRED(fmt, ...) skips printf entirely on the caller's thread: it stores
+ * a compile-time format-string ID plus the raw argument bytes (log_format.h).
+ * By default the writer thread renders those records into dinput8_proxy.log.
+ * Building with DINPUT8_BINARY_LOG defined makes the writer emit the compact
+ * binary dinput8_proxy.blog instead; decode it with tools/blog_decode.
+ *
+ * LOG(Category, Level, fmt, ...) adds filtering on top of LOG_DEFERRED:
+ *   - levels below LOG_COMPILE_LEVEL are discarded at compile time
+ *   - the rest cost one branch on a cached (category, level) bitmask, which
+ *     the /log slash command edits at runtime
+ * so Trace/Debug diagnostics can live inside per-frame and per-packet detours.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstdarg>
+#include <type_traits>
+
+#include "log_format.h"
+
+namespace eqlib { class PlayerClient; }
+
+enum class LogLevel : uint8_t
+{
+    Trace,
+    Debug,
+    Info,
+    Warn,
+    Error,
+    Count
+};
+
+// One category per framework module and per shipped mod. New mods add an entry
+// here and a matching name in logger.cpp.
+enum class LogCategory : uint8_t
+{
+    Framework,
+    Hooks,
+    Commands,
+    SpellbookUnlock,
+    CombatAbilities,
+    StatsOverride,
+    Count
+};
+
+// Lowest level that is compiled in at all. Override via PreprocessorDefinitions.
+#ifndef LOG_COMPILE_LEVEL
+#ifdef _DEBUG
+#define LOG_COMPILE_LEVEL 0   // Trace
+#else
+#define LOG_COMPILE_LEVEL 1   // Debug
+#endif
+#endif
+
+namespace Logger
+{
+
+// Ring geometry. Capacity must be a power of two.
+constexpr uint32_t kCapacity  = 2048;
+constexpr size_t   kSlotBytes = 256;
+
+// Bytes available for a line of text or an encoded argument list in one slot.
+constexpr size_t   kPayloadBytes = 224;
+
+// Queue one line (no trailing newline). Returns false if the record was dropped.
+// Safe to call from any thread, including before the writer thread has started.
+bool Write(const char* fmt, va_list args);
+
+// Queue a deferred-format record. `fmt` must be a string literal (the writer
+// reads it later); `formatId` is BlogFormat::FormatId(fmt). Use LOG_DEFERRED.
+bool WriteDeferred(uint32_t formatId, const char* fmt, const uint8_t* args, size_t argBytes);
+
+template <typename... Args>
+inline bool Deferred(uint32_t formatId, const char* fmt, const Args&... args)
+{
+    uint8_t buf[kPayloadBytes];
+    size_t used = BlogFormat::EncodeArgs(buf, sizeof(buf), args...);
+    return WriteDeferred(formatId, fmt, buf, used);
+}
+
+// Drain everything queued so far to disk on the calling thread and fflush.
+// Called from Core::Shutdown so the final lines survive a process exit that
+// tears down the writer thread without running it again.
+void Flush();
+
+// Stop the writer thread and switch to synchronous writes. Called last in
+// DLL_PROCESS_DETACH; later LogFramework calls are flushed immediately.
+void Shutdown();
+
+// Number of records dropped because the ring was full (lifetime total).
+uint32_t GetDroppedCount();
+
+// ---------------------------------------------------------------------------
+// Category / level filtering
+// ---------------------------------------------------------------------------
+
+constexpr unsigned kLevelCount = static_cast<unsigned>(LogLevel::Count);
+
+static_assert(static_cast<unsigned>(LogCategory::Count) * kLevelCount <= 64,
+    "LogCategory x LogLevel must fit in the 64-bit enable mask");
+
+constexpr uint64_t MaskBit(LogCategory cat, LogLevel level)
+{
+    return 1ull << (static_cast<unsigned>(cat) * kLevelCount + static_cast<unsigned>(level));
+}
+
+constexpr bool Compiled(LogLevel level)
+{
+    return static_cast<int>(level) >= LOG_COMPILE_LEVEL;
+}
+
+// Bit (category * kLevelCount + level) is set when that pair is enabled.
+// Written only from the /log command on the game thread, but read from any
+// thread that logs — atomic so a 32-bit build can't see half of an update.
+extern std::atomic<uint64_t> g_enabledMask;
+
+inline bool IsEnabled(LogCategory cat, LogLevel level)
+{
+    return (g_enabledMask.load(std::memory_order_relaxed) & MaskBit(cat, level)) != 0;
+}
+
+// Enable `level` and everything above it for one category; LogLevel::Count disables all.
+void SetThreshold(LogCategory cat, LogLevel level);
+
+// /log [category|all] [trace|debug|info|warn|error|off]
+void Command(eqlib::PlayerClient* pChar, const char* szLine);
+
+} // namespace Logger
+
+// Deferred-format logging. The format ID is folded at compile time.
+#define LOG_DEFERRED(fmt, ...) \
+    ::Logger::Deferred(std::integral_constant<uint32_t, ::BlogFormat::FormatId(fmt)>::value, \
+        fmt, ##__VA_ARGS__)
+
+// Filtered logging, e.g. LOG(Hooks, Trace, "opcode=0x%04X", opcode).
+#define LOG(category, level, fmt, ...) \
+    do { \
+        if constexpr (::Logger::Compiled(::LogLevel::level)) \
+        { \
+            if (::Logger::IsEnabled(::LogCategory::category, ::LogLevel::level)) \
+                LOG_DEFERRED(fmt, ##__VA_ARGS__); \
+        } \
+    } while (0)
@@ -0,0 +1,41 @@
+/**
+ * @file mapped_file.h
+ * @brief Read-only memory-mapped file (CreateFileMapping on Windows, mmap elsewhere).
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Gives PE::Image (Layout::File) and the offline tools a zero-copy view of a
+ * file on disk. The mapping lives until Close() or destruction.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile() { Close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Map `path` read-only. False if it can't be opened, is empty or can't be mapped.
+    bool Open(const char* path);
+    void Close();
+
+    bool IsOpen() const { return m_data != nullptr; }
+    std::span<const uint8_t> Data() const { return { m_data, m_size }; }
+
+private:
+    const uint8_t* m_data = nullptr;
+    size_t         m_size = 0;
+#ifdef _WIN32
+    void*          m_file = nullptr;      // HANDLE
+    void*          m_mapping = nullptr;   // HANDLE
+#endif
+};
@@ -0,0 +1,79 @@
+/**
+ * @file memory.cpp
+ * @brief Page-batched code writer shared by the patch manager and the inline hook engine.
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "pch.h"
+#include "memory.h"
+#include "core.h"
+
+#include <algorithm>
+
+namespace Memory
+{
+
+static uintptr_t PageSize()
+{
+    static uintptr_t s_pageSize = 0;
+    if (!s_pageSize)
+    {
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        s_pageSize = info.dwPageSize ? info.dwPageSize : 0x1000;
+    }
+    return s_pageSize;
+}
+
+bool WriteBatch(const std::vector<Write>& writes, size_t* pagesTouched)
+{
+    if (pagesTouched)
+        *pagesTouched = 0;
+    if (writes.empty())
+        return true;
+
+    const uintptr_t page = PageSize();
+    std::vector<uintptr_t> pages;
+    uintptr_t lo = UINTPTR_MAX, hi = 0;
+    for (const Write& w : writes)
+    {
+        for (uintptr_t p = w.address & ~(page - 1); p < w.address + w.size; p += page)
+            pages.push_back(p);
+        lo = std::min(lo, w.address);
+        hi = std::max(hi, w.address + w.size);
+    }
+    std::sort(pages.begin(), pages.end());
+    pages.erase(std::unique(pages.begin(), pages.end()), pages.end());
+
+    std::vector<DWORD> oldProtect(pages.size());
+    for (size_t i = 0; i < pages.size(); ++i)
+    {
+        if (!VirtualProtect(reinterpret_cast<void*>(pages[i]), page, PAGE_EXECUTE_READWRITE, &oldProtect[i]))
+        {
+            LogFramework("Memory: VirtualProtect failed on page 0x%08X (error %lu)",
+                static_cast<unsigned int>(pages[i]), GetLastError());
+            DWORD ignored;
+            while (i-- > 0)
+                VirtualProtect(reinterpret_cast<void*>(pages[i]), page, oldProtect[i], &ignored);
+            return false;
+        }
+    }
+
+    for (const Write& w : writes)
+        memcpy(reinterpret_cast<void*>(w.address), w.bytes, w.size);
+
+    for (size_t i = 0; i < pages.size(); ++i)
+    {
+        DWORD ignored;
+        VirtualProtect(reinterpret_cast<void*>(pages[i]), page, oldProtect[i], &ignored);
+    }
+
+    FlushInstructionCache(GetCurrentProcess(), reinterpret_cast<void*>(lo), hi - lo);
+    if (pagesTouched)
+        *pagesTouched = pages.size();
+    return true;
+}
+
+} // namespace Memory
@@ -10,6 +10,7 @@
 
 #include <cstdint>
 #include <cstring>
+#include <vector>
 #include <windows.h>
 
 namespace Memory
@@ -28,6 +29,20 @@ inline bool PatchMemory(uintptr_t address, const void* bytes, size_t len)
     return true;
 }
 
+// One write for WriteBatch; bytes must stay valid until it returns.
+struct Write
+{
+    uintptr_t      address;
+    const uint8_t* bytes;
+    size_t         size;
+};
+
+// Apply a set of code writes together (memory.cpp). Every touched page is made
+// writable first, so a failure leaves nothing half-written; then all bytes are
+// copied, each page gets its own protection back and the instruction cache is
+// flushed once. pagesTouched, if given, receives the number of pages changed.
+bool WriteBatch(const std::vector<Write>& writes, size_t* pagesTouched = nullptr);
+
 // Typed read from a game memory address.
 template <typename T>
 inline T ReadMemory(uintptr_t address)
@@ -0,0 +1,88 @@
+/**
+ * @file mod_dispatch.h
+ * @brief Per-event mod subscriber arrays and the dispatch loop over them.
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Core::RegisterMod reads each mod's GetEventMask() once and appends the mod
+ * to one dense array per event, so a detour only iterates real subscribers
+ * and an event nobody handles costs an empty-vector check. The timed
+ * (profiler) variant of the loop lives in core.cpp.
+ *
+ * Portable — no Windows headers, so it can be benchmarked on a Linux host.
+ */
+
+#pragma once
+
+#include "mods/mod_interface.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace ModDispatch
+{
+
+// A handler array entry: the mod plus its profiler row, resolved once at
+// registration so timed dispatch never searches for it.
+struct Subscriber
+{
+    IMod*    mod;
+    uint32_t profileRow;
+};
+
+// Per-event subscriber arrays, in registration order
+class HandlerTable
+{
+public:
+    void Add(const Subscriber& sub, uint32_t mask)
+    {
+        for (size_t e = 0; e < static_cast<size_t>(ModEvent::Count); ++e)
+        {
+            if (mask & EventBit(static_cast<ModEvent>(e)))
+                m_handlers[e].push_back(sub);
+        }
+    }
+
+    void Clear()
+    {
+        for (auto& handlers : m_handlers)
+            handlers.clear();
+    }
+
+    const std::vector<Subscriber>& Get(ModEvent e) const
+    {
+        return m_handlers[static_cast<size_t>(e)];
+    }
+
+private:
+    std::vector<Subscriber> m_handlers[static_cast<size_t>(ModEvent::Count)];
+};
+
+// True when fn(mod) returns bool, i.e. a false result stops the loop
+template <typename Fn>
+inline constexpr bool kCanStop = std::is_same_v<std::invoke_result_t<Fn&, IMod*>, bool>;
+
+// Calls fn(mod) for each handler. If fn returns bool, a false result stops the
+// loop and Each returns false (used for message suppression).
+template <typename Fn>
+inline bool Each(const std::vector<Subscriber>& handlers, Fn&& fn)
+{
+    for (const Subscriber& sub : handlers)
+    {
+        if constexpr (kCanStop<Fn>)
+        {
+            if (!fn(sub.mod))
+                return false;
+        }
+        else
+        {
+            fn(sub.mod);
+        }
+    }
+    return true;
+}
+
+} // namespace ModDispatch
@@ -10,10 +10,9 @@
 #include "pch.h"
 #include "combat_abilities.h"
 #include "../core.h"
-#include "../memory.h"
+#include "../patches.h"
 
 #include <cstdint>
-#include <cstring>
 
 // ---------------------------------------------------------------------------
 // IMod interface
@@ -24,31 +23,19 @@ const char* CombatAbilities::GetName() const
     return "CombatAbilities";
 }
 
+uint32_t CombatAbilities::GetEventMask() const
+{
+    return 0;  // One-shot patch — no framework events
+}
+
 bool CombatAbilities::Initialize()
 {
     LogFramework("CombatAbilities: Initializing...");
 
-    uintptr_t base   = reinterpret_cast<uintptr_t>(GetModuleHandle("eqgame.exe"));
-    uintptr_t target = base + 0x25A087;
-
-    const uint8_t expected[] = { 0x74, 0x09 };  // JE +9
-    const uint8_t nops[]     = { 0x90, 0x90 };  // NOP NOP
-
-    if (memcmp(reinterpret_cast<const void*>(target), expected, sizeof(expected)) == 0)
-    {
-        if (Memory::PatchMemory(target, nops, sizeof(nops)))
-        {
-            LogFramework("CombatAbilities: Patched JE at 0x%08X -> NOP NOP", static_cast<unsigned int>(target));
-        }
-        else
-        {
-            LogFramework("CombatAbilities: WARNING — PatchMemory failed at 0x%08X", static_cast<unsigned int>(target));
-        }
-    }
-    else
-    {
-        LogFramework("CombatAbilities: WARNING — Expected bytes not found at 0x%08X (already patched or unexpected)", static_cast<unsigned int>(target));
-    }
+    // Applied (and reverted at shutdown) by the framework's patch manager
+    Patches::Add("CombatAbilities", Sig::CombatAbilitiesClassCheck, 0,
+        { 0x74, 0x09 },    // JE +9
+        { 0x90, 0x90 });   // NOP NOP
 
     LogFramework("CombatAbilities: Initialized");
     return true;
@@ -9,6 +9,37 @@
 #pragma once
 
 #include <cstdint>
+#include <span>
+
+// Framework events a mod can subscribe to. The core keeps one dense handler
+// array per event and only calls mods whose GetEventMask() includes it.
+enum class ModEvent : uint8_t
+{
+    Pulse,
+    IncomingMessage,
+    AddSpawn,
+    RemoveSpawn,
+    AddGroundItem,
+    RemoveGroundItem,
+    ClearGroundItems,
+    SetGameState,
+    CleanUI,
+    ReloadUI,
+    SpawnBatch,
+    GroundItemBatch,
+    Count
+};
+
+constexpr uint32_t EventBit(ModEvent e)
+{
+    return 1u << static_cast<uint32_t>(e);
+}
+
+constexpr uint32_t kAllModEvents = (1u << static_cast<uint32_t>(ModEvent::Count)) - 1;
+
+// Batched delivery is opt-in: it makes Core accumulate per-frame arrays.
+constexpr uint32_t kBatchModEvents = EventBit(ModEvent::SpawnBatch) | EventBit(ModEvent::GroundItemBatch);
+
 class IMod
 {
 public:
@@ -17,7 +48,14 @@ public:
     // Display name for logging
     virtual const char* GetName() const = 0;
 
-    // Called once after game window is ready, before hooks are installed
+    // Events this mod handles, as a set of EventBit() values. Read once by
+    // Core::RegisterMod; unsubscribed hooks are never called. The default
+    // subscribes to every per-object event so existing mods keep working
+    // unchanged; batched events must be requested explicitly.
+    virtual uint32_t GetEventMask() const { return kAllModEvents & ~kBatchModEvents; }
+
+    // Called once after game window is ready, before hooks are installed.
+    // Register detours with Hooks::Queue; Core commits them all at once.
     virtual bool Initialize() = 0;
 
     // Called once during teardown, after hooks are removed
@@ -26,7 +64,9 @@ public:
     // Called every game frame (from ProcessGameEvents detour)
     virtual void OnPulse() = 0;
 
-    // Called when a world message arrives (from HandleWorldMessage detour).
+    // Called when a world message arrives (from HandleWorldMessage detour) —
+    // for every opcode if subscribed to ModEvent::IncomingMessage, otherwise
+    // only for opcodes registered via Core::SubscribeOpcode.
     // Return true to allow the message through to the original handler,
     // return false to suppress it.
     virtual bool OnIncomingMessage(uint32_t opcode, const void* buffer, uint32_t size) = 0;
@@ -39,6 +79,21 @@ public:
     virtual void OnAddGroundItem(void* pItem) {}
     virtual void OnRemoveGroundItem(void* pItem) {}
 
+    // The zone's ground item list is about to be cleared. One call per clear.
+    // Mods that only need this shouldn't also subscribe to RemoveGroundItem,
+    // which makes Core walk the list and call OnRemoveGroundItem per item.
+    virtual void OnClearGroundItems() {}
+
+    // Batched spawn / ground item tracking (opt in with ModEvent::SpawnBatch /
+    // ModEvent::GroundItemBatch). Called once per pulse, before OnPulse, with
+    // everything added and removed since the previous pulse. An object added
+    // and removed within the same frame appears in neither span. Apply
+    // `removed` before `added`: a freed address can be reused by a new object
+    // in the same frame. Removed pointers are identity keys only. The object
+    // is already destroyed, so never dereference them.
+    virtual void OnSpawnBatch(std::span<void* const> added, std::span<void* const> removed) {}
+    virtual void OnGroundItemBatch(std::span<void* const> added, std::span<void* const> removed) {}
+
     // Game state transitions (e.g. zoning, char select)
     virtual void OnSetGameState(int gameState) {}
 
@@ -11,24 +11,11 @@
 #include "spellbook_unlock.h"
 #include "../core.h"
 #include "../hooks.h"
-
-#include <eqlib/Offsets.h>
+#include "../shared_hooks.h"
+#include "../offsets.h"
 
 #include <cstdint>
 
-// ---------------------------------------------------------------------------
-// EQGameBaseAddress — defined in core.cpp (extern "C" linkage)
-// ---------------------------------------------------------------------------
-extern "C" uintptr_t EQGameBaseAddress;
-
-// ---------------------------------------------------------------------------
-// Raw offsets (not in eqlib offsets file — manual ASLR calculation needed)
-// ---------------------------------------------------------------------------
-#define EQ_Character__IsSpellcaster_x       0x443F50
-#define EQ_Character__IsSpellcaster_2_x     0x4288E0
-#define EQ_Character__IsSpellcaster_3_x     0x59FB90
-#define CSpellBookWnd__CanStartMemming_x    0x75BD40
-
 // ---------------------------------------------------------------------------
 // Original function typedefs and pointers (thiscall via fastcall trick)
 // ---------------------------------------------------------------------------
@@ -47,10 +34,6 @@ static GetSpellLevelNeeded_t GetSpellLevelNeeded_Original = nullptr;
 using CanStartMemming_t = int (__fastcall*)(void* thisPtr, void* edx, int spellid);
 static CanStartMemming_t CanStartMemming_Original = nullptr;
 
-// CanUseItem: bool __thiscall(const ItemPtr& pItem, bool bUseRequiredLvl, bool bOutput)
-using CanUseItem_t = bool (__fastcall*)(void* thisPtr, void* edx, const void* pItem, bool bUseRequiredLvl, bool bOutput);
-static CanUseItem_t CanUseItem_Original = nullptr;
-
 // ---------------------------------------------------------------------------
 // Detours
 // ---------------------------------------------------------------------------
@@ -88,9 +71,11 @@ static int __fastcall CanStartMemming_Detour(void* thisPtr, void* edx, int spell
     return 1;
 }
 
-// CanUseItem — always return true (bypass item class/race restrictions)
-static bool __fastcall CanUseItem_Detour(void* thisPtr, void* edx, const void* pItem, bool bUseRequiredLvl, bool bOutput)
+// CanUseItem (shared hook, pre callback) — always true, skipping the original
+// (bypass item class/race restrictions)
+static bool CanUseItem_Pre(bool& result, void* thisPtr, void* edx, const void* pItem, bool bUseRequiredLvl, bool bOutput)
 {
+    result = true;
     return true;
 }
 
@@ -103,72 +88,53 @@ const char* SpellbookUnlock::GetName() const
     return "SpellbookUnlock";
 }
 
+uint32_t SpellbookUnlock::GetEventMask() const
+{
+    return 0;  // Hooks only — no framework events
+}
+
 bool SpellbookUnlock::Initialize()
 {
     LogFramework("SpellbookUnlock: Initializing...");
 
-    // All addresses need manual ASLR calculation: (raw - 0x400000 + base)
-    uintptr_t isSpellcasterAddr = static_cast<uintptr_t>(EQ_Character__IsSpellcaster_x)
-        - eqlib::EQGamePreferredAddress + EQGameBaseAddress;
-    IsSpellcaster_Original = reinterpret_cast<IsSpellcaster_t>(isSpellcasterAddr);
-    LogFramework("SpellbookUnlock: IsSpellcaster = 0x%08X", static_cast<unsigned int>(isSpellcasterAddr));
-
-    uintptr_t isSpellcaster2Addr = static_cast<uintptr_t>(EQ_Character__IsSpellcaster_2_x)
-        - eqlib::EQGamePreferredAddress + EQGameBaseAddress;
-    IsSpellcaster2_Original = reinterpret_cast<IsSpellcaster_t>(isSpellcaster2Addr);
-    LogFramework("SpellbookUnlock: IsSpellcaster_2 = 0x%08X", static_cast<unsigned int>(isSpellcaster2Addr));
-
-    uintptr_t isSpellcaster3Addr = static_cast<uintptr_t>(EQ_Character__IsSpellcaster_3_x)
-        - eqlib::EQGamePreferredAddress + EQGameBaseAddress;
-    IsSpellcaster3_Original = reinterpret_cast<IsSpellcaster_t>(isSpellcaster3Addr);
-    LogFramework("SpellbookUnlock: IsSpellcaster_3 = 0x%08X", static_cast<unsigned int>(isSpellcaster3Addr));
-
-    uintptr_t getSpellLevelAddr = static_cast<uintptr_t>(EQ_Spell__GetSpellLevelNeeded_x)
-        - eqlib::EQGamePreferredAddress + EQGameBaseAddress;
-    GetSpellLevelNeeded_Original = reinterpret_cast<GetSpellLevelNeeded_t>(getSpellLevelAddr);
-    LogFramework("SpellbookUnlock: GetSpellLevelNeeded = 0x%08X", static_cast<unsigned int>(getSpellLevelAddr));
-
-    uintptr_t canStartMemmingAddr = static_cast<uintptr_t>(CSpellBookWnd__CanStartMemming_x)
-        - eqlib::EQGamePreferredAddress + EQGameBaseAddress;
-    CanStartMemming_Original = reinterpret_cast<CanStartMemming_t>(canStartMemmingAddr);
-    LogFramework("SpellbookUnlock: CanStartMemming = 0x%08X", static_cast<unsigned int>(canStartMemmingAddr));
-
-    uintptr_t canUseItemAddr = static_cast<uintptr_t>(CharacterZoneClient__CanUseItem_x)
-        - eqlib::EQGamePreferredAddress + EQGameBaseAddress;
-    CanUseItem_Original = reinterpret_cast<CanUseItem_t>(canUseItemAddr);
-    LogFramework("SpellbookUnlock: CanUseItem = 0x%08X", static_cast<unsigned int>(canUseItemAddr));
-
-    // --- Install hooks ---
-    Hooks::Install("IsSpellcaster",
+    // Addresses resolved by Offsets::ResolveAll (signature, else fixed offset)
+    IsSpellcaster_Original       = reinterpret_cast<IsSpellcaster_t>(Offsets::Get(Sig::IsSpellcaster));
+    IsSpellcaster2_Original      = reinterpret_cast<IsSpellcaster_t>(Offsets::Get(Sig::IsSpellcaster2));
+    IsSpellcaster3_Original      = reinterpret_cast<IsSpellcaster_t>(Offsets::Get(Sig::IsSpellcaster3));
+    GetSpellLevelNeeded_Original = reinterpret_cast<GetSpellLevelNeeded_t>(Offsets::Get(Sig::GetSpellLevelNeeded));
+    CanStartMemming_Original     = reinterpret_cast<CanStartMemming_t>(Offsets::Get(Sig::CanStartMemming));
+
+    // --- Queue hooks ---
+    Hooks::Queue("IsSpellcaster",
         reinterpret_cast<void**>(&IsSpellcaster_Original),
         reinterpret_cast<void*>(&IsSpellcaster_Detour));
 
-    Hooks::Install("IsSpellcaster_2",
+    Hooks::Queue("IsSpellcaster_2",
         reinterpret_cast<void**>(&IsSpellcaster2_Original),
         reinterpret_cast<void*>(&IsSpellcaster2_Detour));
 
-    Hooks::Install("IsSpellcaster_3",
+    Hooks::Queue("IsSpellcaster_3",
         reinterpret_cast<void**>(&IsSpellcaster3_Original),
         reinterpret_cast<void*>(&IsSpellcaster3_Detour));
 
-    Hooks::Install("GetSpellLevelNeeded",
+    Hooks::Queue("GetSpellLevelNeeded",
         reinterpret_cast<void**>(&GetSpellLevelNeeded_Original),
         reinterpret_cast<void*>(&GetSpellLevelNeeded_Detour));
 
-    Hooks::Install("CanStartMemming",
+    Hooks::Queue("CanStartMemming",
         reinterpret_cast<void**>(&CanStartMemming_Original),
         reinterpret_cast<void*>(&CanStartMemming_Detour));
 
-    Hooks::Install("CanUseItem",
-        reinterpret_cast<void**>(&CanUseItem_Original),
-        reinterpret_cast<void*>(&CanUseItem_Detour));
+    // CanUseItem is hooked by the framework; other mods may also attach to it
+    SharedHooks::CanUseItem().Attach(GetName(), 0, &CanUseItem_Pre, nullptr);
 
-    LogFramework("SpellbookUnlock: Initialized — 6 hooks installed");
+    LogFramework("SpellbookUnlock: Initialized — 5 hooks queued, 1 shared callback");
     return true;
 }
 
 void SpellbookUnlock::Shutdown()
 {
+    SharedHooks::CanUseItem().Detach(GetName());
     LogFramework("SpellbookUnlock: Shutdown");
 }
 
@@ -15,6 +15,7 @@ class SpellbookUnlock : public IMod
 {
 public:
     const char* GetName() const override;
+    uint32_t    GetEventMask() const override;
     bool        Initialize() override;
     void        Shutdown() override;
     void        OnPulse() override;
@@ -21,27 +21,14 @@
 #include "stats_override.h"
 #include "../core.h"
 #include "../hooks.h"
-
-#include <eqlib/Offsets.h>
+#include "../shared_hooks.h"
+#include "../logger.h"
+#include "../offsets.h"
 
 #include <cstdint>
 #include <cstring>
 #include <unordered_map>
 
-// ---------------------------------------------------------------------------
-// EQGameBaseAddress — defined in core.cpp (extern "C" linkage)
-// ---------------------------------------------------------------------------
-extern "C" uintptr_t EQGameBaseAddress;
-
-// ---------------------------------------------------------------------------
-// Raw offsets (from eqlib offsets file)
-// ---------------------------------------------------------------------------
-#define CharacterZoneClient__Max_Mana_x       0x581E60
-#define CharacterZoneClient__Cur_Mana_x       0x4442E0
-#define CharacterZoneClient__Max_Endurance_x  0x582020
-#define __GetGaugeValueFromEQ_x               0x762410
-#define __GetLabelFromEQ_x                    0x763640
-
 // ---------------------------------------------------------------------------
 // Stat types for the override map
 // ---------------------------------------------------------------------------
@@ -90,11 +77,8 @@ static constexpr int TEST_DEFAULT_VALUE = 100;
 // Original function typedefs and pointers
 // ---------------------------------------------------------------------------
 
-// Max_Mana / Cur_Mana / Max_Endurance: int __thiscall(bool bCapAtMax)
-using StatFunc_t = int (__fastcall*)(void* thisPtr, void* edx, bool bCapAtMax);
-static StatFunc_t MaxMana_Original      = nullptr;
-static StatFunc_t CurMana_Original      = nullptr;
-static StatFunc_t MaxEndurance_Original  = nullptr;
+// Max_Mana / Cur_Mana / Max_Endurance are shared hooks (shared_hooks.h);
+// this mod adjusts their results from post callbacks.
 
 // GetGaugeValueFromEQ: int __cdecl(int gaugeType, CXStr*, bool*, unsigned long*)
 using GetGaugeValueFromEQ_t = int (__cdecl*)(int gaugeType, void* pStr, bool* pEnabled, unsigned long* pColor);
@@ -126,22 +110,19 @@ static int ResolveStat(StatType type, int originalValue)
 // Detours
 // ---------------------------------------------------------------------------
 
-static int __fastcall MaxMana_Detour(void* thisPtr, void* edx, bool bCapAtMax)
+static void MaxMana_Post(int& result, void* thisPtr, void* edx, bool bCapAtMax)
 {
-    int original = MaxMana_Original(thisPtr, edx, bCapAtMax);
-    return ResolveStat(StatType::MaxMana, original);
+    result = ResolveStat(StatType::MaxMana, result);
 }
 
-static int __fastcall CurMana_Detour(void* thisPtr, void* edx, bool bCapAtMax)
+static void CurMana_Post(int& result, void* thisPtr, void* edx, bool bCapAtMax)
 {
-    int original = CurMana_Original(thisPtr, edx, bCapAtMax);
-    return ResolveStat(StatType::CurMana, original);
+    result = ResolveStat(StatType::CurMana, result);
 }
 
-static int __fastcall MaxEndurance_Detour(void* thisPtr, void* edx, bool bCapAtMax)
+static void MaxEndurance_Post(int& result, void* thisPtr, void* edx, bool bCapAtMax)
 {
-    int original = MaxEndurance_Original(thisPtr, edx, bCapAtMax);
-    return ResolveStat(StatType::MaxEndurance, original);
+    result = ResolveStat(StatType::MaxEndurance, result);
 }
 
 // Gauge types — discovered empirically from EQ client UI.
@@ -153,6 +134,7 @@ static constexpr int GAUGE_STAMINA   = 2;  // endurance
 static int __cdecl GetGaugeValueFromEQ_Detour(int gaugeType, void* pStr, bool* pEnabled, unsigned long* pColor)
 {
     int original = GetGaugeValueFromEQ_Original(gaugeType, pStr, pEnabled, pColor);
+    LOG(StatsOverride, Trace, "StatsOverride: gauge %d original=%d", gaugeType, original);
 
     switch (gaugeType)
     {
@@ -195,64 +177,51 @@ const char* StatsOverride::GetName() const
     return "StatsOverride";
 }
 
+uint32_t StatsOverride::GetEventMask() const
+{
+    // No broadcast events — OP_EdgeStats is routed via Core::SubscribeOpcode
+    return 0;
+}
+
 bool StatsOverride::Initialize()
 {
     LogFramework("StatsOverride: Initializing...");
 
-    // --- Resolve addresses with ASLR: (raw - 0x400000 + base) ---
-
-    uintptr_t maxManaAddr = static_cast<uintptr_t>(CharacterZoneClient__Max_Mana_x)
-        - eqlib::EQGamePreferredAddress + EQGameBaseAddress;
-    MaxMana_Original = reinterpret_cast<StatFunc_t>(maxManaAddr);
-    LogFramework("StatsOverride: Max_Mana = 0x%08X", static_cast<unsigned int>(maxManaAddr));
-
-    uintptr_t curManaAddr = static_cast<uintptr_t>(CharacterZoneClient__Cur_Mana_x)
-        - eqlib::EQGamePreferredAddress + EQGameBaseAddress;
-    CurMana_Original = reinterpret_cast<StatFunc_t>(curManaAddr);
-    LogFramework("StatsOverride: Cur_Mana = 0x%08X", static_cast<unsigned int>(curManaAddr));
-
-    uintptr_t maxEndurAddr = static_cast<uintptr_t>(CharacterZoneClient__Max_Endurance_x)
-        - eqlib::EQGamePreferredAddress + EQGameBaseAddress;
-    MaxEndurance_Original = reinterpret_cast<StatFunc_t>(maxEndurAddr);
-    LogFramework("StatsOverride: Max_Endurance = 0x%08X", static_cast<unsigned int>(maxEndurAddr));
-
-    uintptr_t gaugeAddr = static_cast<uintptr_t>(__GetGaugeValueFromEQ_x)
-        - eqlib::EQGamePreferredAddress + EQGameBaseAddress;
-    GetGaugeValueFromEQ_Original = reinterpret_cast<GetGaugeValueFromEQ_t>(gaugeAddr);
-    LogFramework("StatsOverride: GetGaugeValueFromEQ = 0x%08X", static_cast<unsigned int>(gaugeAddr));
-
-    uintptr_t labelAddr = static_cast<uintptr_t>(__GetLabelFromEQ_x)
-        - eqlib::EQGamePreferredAddress + EQGameBaseAddress;
-    GetLabelFromEQ_Original = reinterpret_cast<GetLabelFromEQ_t>(labelAddr);
-    LogFramework("StatsOverride: GetLabelFromEQ = 0x%08X", static_cast<unsigned int>(labelAddr));
-
-    // --- Install hooks ---
-    Hooks::Install("Max_Mana",
-        reinterpret_cast<void**>(&MaxMana_Original),
-        reinterpret_cast<void*>(&MaxMana_Detour));
-
-    Hooks::Install("Cur_Mana",
-        reinterpret_cast<void**>(&CurMana_Original),
-        reinterpret_cast<void*>(&CurMana_Detour));
-
-    Hooks::Install("Max_Endurance",
-        reinterpret_cast<void**>(&MaxEndurance_Original),
-        reinterpret_cast<void*>(&MaxEndurance_Detour));
-
-    Hooks::Install("GetGaugeValueFromEQ",
+    // Only 0x1338 reaches OnIncomingMessage; every other world packet skips this mod
+    Core::SubscribeOpcode(this, OP_EdgeStats);
+
+    // Addresses resolved by Offsets::ResolveAll (signature, else fixed offset)
+    GetGaugeValueFromEQ_Original = reinterpret_cast<GetGaugeValueFromEQ_t>(Offsets::Get(Sig::GetGaugeValueFromEQ));
+    GetLabelFromEQ_Original      = reinterpret_cast<GetLabelFromEQ_t>(Offsets::Get(Sig::GetLabelFromEQ));
+    LogFramework("StatsOverride: Max_Mana = 0x%08X", static_cast<unsigned int>(Offsets::Get(Sig::MaxMana)));
+    LogFramework("StatsOverride: Cur_Mana = 0x%08X", static_cast<unsigned int>(Offsets::Get(Sig::CurMana)));
+    LogFramework("StatsOverride: Max_Endurance = 0x%08X", static_cast<unsigned int>(Offsets::Get(Sig::MaxEndurance)));
+    LogFramework("StatsOverride: GetGaugeValueFromEQ = 0x%08X", static_cast<unsigned int>(Offsets::Get(Sig::GetGaugeValueFromEQ)));
+    LogFramework("StatsOverride: GetLabelFromEQ = 0x%08X", static_cast<unsigned int>(Offsets::Get(Sig::GetLabelFromEQ)));
+
+    // --- Shared hooks: adjust the original's result ---
+    SharedHooks::MaxMana().Attach(GetName(), 0, nullptr, &MaxMana_Post);
+    SharedHooks::CurMana().Attach(GetName(), 0, nullptr, &CurMana_Post);
+    SharedHooks::MaxEndurance().Attach(GetName(), 0, nullptr, &MaxEndurance_Post);
+
+    // --- Queue hooks ---
+    Hooks::Queue("GetGaugeValueFromEQ",
         reinterpret_cast<void**>(&GetGaugeValueFromEQ_Original),
         reinterpret_cast<void*>(&GetGaugeValueFromEQ_Detour));
 
-    Hooks::Install("GetLabelFromEQ",
+    Hooks::Queue("GetLabelFromEQ",
         reinterpret_cast<void**>(&GetLabelFromEQ_Original),
         reinterpret_cast<void*>(&GetLabelFromEQ_Detour));
 
-    LogFramework("StatsOverride: Initialized — 5 hooks installed");
+    LogFramework("StatsOverride: Initialized — 2 hooks queued, 3 shared callbacks");
     return true;
 }
 
 void StatsOverride::Shutdown()
 {
+    SharedHooks::MaxMana().Detach(GetName());
+    SharedHooks::CurMana().Detach(GetName());
+    SharedHooks::MaxEndurance().Detach(GetName());
     s_statOverrides.clear();
     LogFramework("StatsOverride: Shutdown");
 }
@@ -265,7 +234,7 @@ void StatsOverride::OnPulse()
 bool StatsOverride::OnIncomingMessage(uint32_t opcode, const void* buffer, uint32_t size)
 {
     if (opcode != OP_EdgeStats)
-        return true;  // Not our opcode — pass through to original handler
+        return true;  // Routed by opcode, so this is only a safety net
 
     // Validate minimum packet size: at least the count field
     if (size < sizeof(uint32_t))
@@ -293,7 +262,7 @@ bool StatsOverride::OnIncomingMessage(uint32_t opcode, const void* buffer, uint3
         int  val  = pkt->entries[i].value;
 
         s_statOverrides[type] = val;
-        LogFramework("StatsOverride:   stat[%u] = %d", pkt->entries[i].statType, val);
+        LOG(StatsOverride, Info, "StatsOverride:   stat[%u] = %d", pkt->entries[i].statType, val);
     }
 
     return false;  // Suppress — don't pass unknown opcode to original handler
@@ -16,6 +16,7 @@ class StatsOverride : public IMod
 {
 public:
     const char* GetName() const override;
+    uint32_t    GetEventMask() const override;
     bool        Initialize() override;
     void        Shutdown() override;
     void        OnPulse() override;
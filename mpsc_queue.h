@@ -0,0 +1,83 @@
+/**
+ * @file mpsc_queue.h
+ * @brief Unbounded lock-free multi-producer / single-consumer queue.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Vyukov's node-based MPSC queue. Push is one atomic exchange plus a release
+ * store, so any thread can post without blocking. Only one thread may call
+ * TryPop. T must be default-constructible (the queue keeps a stub node).
+ *
+ * Portable — no Windows headers, so it builds on a Linux host as well.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+template <typename T>
+class MpscQueue
+{
+public:
+    MpscQueue()
+        : m_head(new Node())
+        , m_tail(m_head.load(std::memory_order_relaxed))
+    {
+    }
+
+    ~MpscQueue()
+    {
+        T discard;
+        while (TryPop(discard))
+        {
+        }
+        delete m_tail;
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // Any thread.
+    void Push(T value)
+    {
+        Node* node = new Node();
+        node->value = std::move(value);
+        Node* prev = m_head.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    // Consumer thread only. Returns false when the queue is empty, or when a
+    // producer is between its exchange and its link store (the item becomes
+    // visible on a later call).
+    bool TryPop(T& out)
+    {
+        Node* tail = m_tail;
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (!next)
+            return false;
+
+        out = std::move(next->value);
+        next->value = T();
+        m_tail = next;
+        delete tail;
+        return true;
+    }
+
+    // Consumer thread only; a racing Push may make this stale immediately.
+    bool Empty() const
+    {
+        return m_tail->next.load(std::memory_order_acquire) == nullptr;
+    }
+
+private:
+    struct Node
+    {
+        std::atomic<Node*> next{ nullptr };
+        T                  value{};
+    };
+
+    std::atomic<Node*> m_head;  // producers
+    Node*              m_tail;  // consumer; always the current stub
+};
@@ -0,0 +1,283 @@
+/**
+ * @file multi_scan.cpp
+ * @brief Implementation of the multi-pattern scanner — key selection, Aho-Corasick DFA, chunked scan.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "multi_scan.h"
+#include "cpu_features.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <thread>
+
+namespace SigScan
+{
+
+static constexpr uint32_t kNone = 0xFFFFFFFFu;
+
+// Keys aren't trimmed below this many bytes
+static constexpr size_t kMinKeyLength = 4;
+
+// Below this, thread start-up costs more than it saves
+static constexpr size_t kMinBytesPerThread = 1u << 20;
+
+size_t MultiScanner::Add(const Pattern& pattern)
+{
+    Key key;
+    for (size_t i = 0; i < pattern.Size();)
+    {
+        if (!pattern.mask[i])
+        {
+            ++i;
+            continue;
+        }
+        size_t run = i;
+        while (run < pattern.Size() && pattern.mask[run])
+            ++run;
+        if (run - i > key.length)
+        {
+            key.offset = i;
+            key.length = run - i;
+        }
+        i = run;
+    }
+
+    // Start the key on a less common byte where that leaves enough of it
+    while (key.length > kMinKeyLength && ByteCommonness(pattern.bytes[key.offset]) > 0)
+    {
+        ++key.offset;
+        --key.length;
+    }
+
+    m_patterns.push_back(pattern);
+    m_keys.push_back(key);
+    return m_patterns.size() - 1;
+}
+
+void MultiScanner::Build()
+{
+    m_next.assign(256, kNone);
+    std::fill(std::begin(m_isStart), std::end(m_isStart), false);
+    memset(m_startNibble, 0, sizeof(m_startNibble));
+    std::vector<std::vector<uint32_t>> outputs(1);
+    m_maxKey = 0;
+
+    // Trie of keys
+    for (size_t k = 0; k < m_patterns.size(); ++k)
+    {
+        const Key& key = m_keys[k];
+        if (!key.length)
+            continue;
+        m_maxKey = std::max(m_maxKey, key.length);
+
+        uint8_t first = m_patterns[k].bytes[key.offset];
+        m_isStart[first] = true;
+        m_startNibble[first >> 7][first & 0x0F] |= static_cast<uint8_t>(1u << ((first >> 4) & 7));
+
+        uint32_t state = 0;
+        for (size_t i = 0; i < key.length; ++i)
+        {
+            uint8_t b = m_patterns[k].bytes[key.offset + i];
+            uint32_t& slot = m_next[state * 256 + b];
+            if (slot == kNone)
+            {
+                slot = static_cast<uint32_t>(outputs.size());
+                outputs.emplace_back();
+                m_next.resize(m_next.size() + 256, kNone);
+            }
+            state = m_next[state * 256 + b];
+        }
+        outputs[state].push_back(static_cast<uint32_t>(k));
+    }
+
+    // Breadth-first: suffix links, merged outputs, and missing transitions
+    // filled in so the scan never follows a link at run time
+    const size_t states = outputs.size();
+    std::vector<uint32_t> link(states, 0);
+    std::vector<uint32_t> queue;
+    queue.reserve(states);
+
+    for (uint32_t c = 0; c < 256; ++c)
+    {
+        uint32_t& t = m_next[c];
+        if (t == kNone)
+            t = 0;
+        else
+            queue.push_back(t);
+    }
+
+    for (size_t qi = 0; qi < queue.size(); ++qi)
+    {
+        uint32_t s = queue[qi];
+        for (uint32_t c = 0; c < 256; ++c)
+        {
+            uint32_t& t = m_next[s * 256 + c];
+            uint32_t viaLink = m_next[link[s] * 256 + c];
+            if (t == kNone)
+            {
+                t = viaLink;
+                continue;
+            }
+            link[t] = viaLink;
+            const auto& inherited = outputs[viaLink];
+            outputs[t].insert(outputs[t].end(), inherited.begin(), inherited.end());
+            queue.push_back(t);
+        }
+    }
+
+    m_outStart.assign(states + 1, 0);
+    m_out.clear();
+    for (size_t s = 0; s < states; ++s)
+    {
+        m_outStart[s] = static_cast<uint32_t>(m_out.size());
+        m_out.insert(m_out.end(), outputs[s].begin(), outputs[s].end());
+    }
+    m_outStart[states] = static_cast<uint32_t>(m_out.size());
+}
+
+// ---------------------------------------------------------------------------
+// Root skip
+// ---------------------------------------------------------------------------
+
+// 32 bytes per step: row = table for the byte's high-nibble half, indexed by
+// its low nibble; the byte is a key start when row has bit (hi & 7) set.
+CPU_TARGET_AVX2
+static size_t SkipAvx2(const uint8_t* bytes, size_t i, size_t end, const uint8_t (&nibble)[2][16])
+{
+    const __m256i tLo  = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(nibble[0])));
+    const __m256i tHi  = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(nibble[1])));
+    const __m256i bits = _mm256_setr_epi8(
+        1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+        1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+    const __m256i low4  = _mm256_set1_epi8(0x0F);
+    const __m256i eight = _mm256_set1_epi8(8);
+
+    for (; i + 32 <= end; i += 32)
+    {
+        __m256i v  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + i));
+        __m256i lo = _mm256_and_si256(v, low4);
+        __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low4);
+        __m256i upper = _mm256_cmpgt_epi8(eight, hi);   // hi < 8
+        __m256i row = _mm256_blendv_epi8(_mm256_shuffle_epi8(tHi, lo), _mm256_shuffle_epi8(tLo, lo), upper);
+        __m256i bit = _mm256_shuffle_epi8(bits, hi);
+        __m256i hit = _mm256_cmpeq_epi8(_mm256_and_si256(row, bit), bit);
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(hit));
+        if (mask)
+            return i + static_cast<size_t>(std::countr_zero(mask));
+    }
+    return i;
+}
+
+size_t MultiScanner::SkipToKeyStart(const uint8_t* bytes, size_t i, size_t end) const
+{
+    if (UsingAvx2())
+        i = SkipAvx2(bytes, i, end, m_startNibble);
+    while (i < end && !m_isStart[bytes[i]])
+        ++i;
+    return i;
+}
+
+// ---------------------------------------------------------------------------
+// Scan
+// ---------------------------------------------------------------------------
+
+// Report matches whose key ends at a position in [begin, end)
+void MultiScanner::ScanRange(std::span<const uint8_t> data, size_t begin, size_t end,
+    std::vector<Hit>& out) const
+{
+    const uint8_t*  bytes = data.data();
+    const uint32_t* next = m_next.data();
+    const uint32_t* outStart = m_outStart.data();
+
+    size_t i = begin >= m_maxKey - 1 ? begin - (m_maxKey - 1) : 0;
+    uint32_t state = 0;
+
+    // Warm-up: prime the automaton with bytes owned by the previous chunk
+    for (; i < begin; ++i)
+        state = next[state * 256 + bytes[i]];
+
+    for (; i < end; ++i)
+    {
+        if (state == 0)
+        {
+            i = SkipToKeyStart(bytes, i, end);
+            if (i == end)
+                break;
+        }
+
+        state = next[state * 256 + bytes[i]];
+        if (outStart[state] == outStart[state + 1])
+            continue;
+
+        for (uint32_t o = outStart[state]; o < outStart[state + 1]; ++o)
+        {
+            uint32_t k = m_out[o];
+            const Key& key = m_keys[k];
+            const Pattern& p = m_patterns[k];
+
+            size_t keyStart = i + 1 - key.length;
+            if (keyStart < key.offset)
+                continue;
+            size_t at = keyStart - key.offset;
+            if (p.Size() > data.size() - at)
+                continue;
+            if (p.MatchAt(bytes + at))
+                out.push_back({ k, at });
+        }
+    }
+}
+
+void MultiScanner::Scan(std::span<const uint8_t> data, std::vector<std::vector<size_t>>& hits,
+    size_t maxHitsPerPattern, unsigned threads) const
+{
+    hits.assign(m_patterns.size(), {});
+    if (m_maxKey == 0 || data.empty())
+        return;
+
+    if (threads == 0)
+        threads = std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u);
+    size_t maxThreads = std::max<size_t>(1, data.size() / kMinBytesPerThread);
+    threads = static_cast<unsigned>(std::min<size_t>(threads, maxThreads));
+
+    std::vector<std::vector<Hit>> found(threads);
+    const size_t chunk = data.size() / threads;
+
+    if (threads == 1)
+    {
+        ScanRange(data, 0, data.size(), found[0]);
+    }
+    else
+    {
+        std::vector<std::thread> workers;
+        workers.reserve(threads - 1);
+        for (unsigned t = 1; t < threads; ++t)
+        {
+            size_t begin = chunk * t;
+            size_t end = (t + 1 == threads) ? data.size() : begin + chunk;
+            workers.emplace_back([this, data, begin, end, &out = found[t]] {
+                ScanRange(data, begin, end, out);
+            });
+        }
+        ScanRange(data, 0, chunk, found[0]);
+        for (auto& w : workers)
+            w.join();
+    }
+
+    for (const auto& list : found)
+    {
+        for (const Hit& h : list)
+            hits[h.pattern].push_back(h.offset);
+    }
+    for (auto& list : hits)
+    {
+        std::sort(list.begin(), list.end());
+        if (list.size() > maxHitsPerPattern)
+            list.resize(maxHitsPerPattern);
+    }
+}
+
+} // namespace SigScan
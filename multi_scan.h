@@ -0,0 +1,102 @@
+/**
+ * @file multi_scan.h
+ * @brief Single-pass multi-pattern scanner — Aho-Corasick over each pattern's longest
+ *        literal run, full-pattern verify, optionally split across threads.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Scanning a 10 MB .text once per signature costs one pass per entry in
+ * signatures.h. MultiScanner takes every pattern up front and finds all of
+ * them in one pass:
+ *
+ *     SigScan::MultiScanner scanner;
+ *     for (...) scanner.Add(pattern);
+ *     scanner.Build();
+ *     std::vector<std::vector<size_t>> hits;
+ *     scanner.Scan(text, hits, 2);          // hits[k] = offsets of pattern k
+ *
+ * Each pattern is keyed by its longest run of literal bytes, minus leading
+ * bytes that are common in x86 code (push ebp / mov ebp, esp prologues would
+ * otherwise wake the automaton at every function). The keys are
+ * compiled into a dense Aho-Corasick DFA (256 transitions per state). Every
+ * key hit is verified against the full pattern, wildcards included.
+ *
+ * While the automaton sits at the root, bytes that can't start any key are
+ * skipped without touching the DFA: 32 at a time with AVX2, using a nibble
+ * lookup (two PSHUFB) for set membership, else one table lookup per byte.
+ *
+ * With threads > 1 the data is split into chunks by key end position. Each
+ * thread starts its automaton (longest key - 1) bytes before its chunk, so
+ * a match that straddles a boundary is reported exactly once.
+ *
+ * Portable (std::thread only) like sig_scan.h.
+ */
+
+#pragma once
+
+#include "sig_scan.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace SigScan
+{
+
+class MultiScanner
+{
+public:
+    // Returns the pattern's index in Scan() results. Empty patterns are kept
+    // (so indices line up with the caller's table) but never match.
+    size_t Add(const Pattern& pattern);
+
+    // Compile the automaton. Call after the last Add() and before Scan().
+    void Build();
+
+    size_t PatternCount() const { return m_patterns.size(); }
+
+    // hits is resized to PatternCount(); hits[k] receives the sorted offsets
+    // of up to maxHitsPerPattern matches of pattern k. threads = 0 picks
+    // hardware_concurrency / 2, clamped to 1..4.
+    void Scan(std::span<const uint8_t> data, std::vector<std::vector<size_t>>& hits,
+        size_t maxHitsPerPattern = npos, unsigned threads = 1) const;
+
+private:
+    struct Key
+    {
+        size_t offset = 0;   // start of the literal run within the pattern
+        size_t length = 0;   // 0 = pattern has no key (empty)
+    };
+
+    struct Hit
+    {
+        uint32_t pattern;
+        size_t   offset;
+    };
+
+    void ScanRange(std::span<const uint8_t> data, size_t begin, size_t end,
+        std::vector<Hit>& out) const;
+
+    // First position in [i, end) whose byte starts some key, or end
+    size_t SkipToKeyStart(const uint8_t* bytes, size_t i, size_t end) const;
+
+    std::vector<Pattern>  m_patterns;
+    std::vector<Key>      m_keys;
+    size_t                m_maxKey = 0;
+
+    // DFA: m_next[state * 256 + byte]; state 0 is the root
+    std::vector<uint32_t> m_next;
+    // Patterns whose key ends in a state (own and via suffix links), flattened
+    std::vector<uint32_t> m_outStart;   // per state, index into m_out; size states + 1
+    std::vector<uint32_t> m_out;
+
+    // Bytes that begin at least one key: a flat table, and the nibble form
+    // for the SIMD skip (bit (h & 7) of m_startNibble[h >> 3][lo] set when
+    // byte (h << 4 | lo) starts a key)
+    bool                  m_isStart[256] = {};
+    uint8_t               m_startNibble[2][16] = {};
+};
+
+} // namespace SigScan
@@ -0,0 +1,189 @@
+/**
+ * @file offset_cache.h
+ * @brief On-disk layout of dinput8_offsets.cache — signature scan results keyed by
+ *        the executable's PE headers, so later launches skip the scan.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Portable header — no Windows or eqlib dependencies.
+ *
+ * File layout:
+ *   FileHeader
+ *   Entry, one per Sig in enum order
+ *
+ * imageKey is FNV-1a 64 over the executable's PE headers (SizeOfHeaders
+ * bytes) with OptionalHeader.ImageBase treated as zero. Those bytes include
+ * the link timestamp, checksum and section table, so any client rebuild
+ * changes the key. ImageBase is excluded because the loader rewrites it in
+ * the mapped headers when it rebases the image, and the key must not change
+ * from launch to launch under ASLR. defsHash covers signatures.h, so
+ * editing a pattern also invalidates the cache.
+ *
+ * Only signature results are stored (EntrySource::Signature). Other entries
+ * are written as EntrySource::None, and the loader re-derives them from
+ * the fixed offsets compiled into the DLL. Every stored entry also carries the
+ * first kCheckBytes bytes found at its address. The loader compares them
+ * before trusting the file; a single mismatch discards the whole cache.
+ */
+
+#pragma once
+
+#include "pe_image.h"
+#include "signatures.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace OffsetCache
+{
+
+constexpr char     kMagic[4]    = { 'O', 'F', 'F', 'C' };
+constexpr uint16_t kVersion     = 1;
+constexpr size_t   kCheckBytes  = 8;
+constexpr const char* kFileName = "dinput8_offsets.cache";
+
+constexpr uint64_t kFnvBasis = 0xCBF29CE484222325ull;
+constexpr uint64_t kFnvPrime = 0x00000100000001B3ull;
+
+enum class EntrySource : uint8_t
+{
+    None      = 0,
+    Signature = 1,
+};
+
+#pragma pack(push, 1)
+struct FileHeader
+{
+    char     magic[4];
+    uint16_t version;
+    uint16_t count;       // entries following the header
+    uint64_t imageKey;
+    uint64_t defsHash;
+};
+
+struct Entry
+{
+    uint32_t rva;         // relative to the image base
+    uint8_t  source;      // EntrySource
+    uint8_t  reserved[3];
+    uint8_t  check[kCheckBytes];
+};
+#pragma pack(pop)
+
+static_assert(sizeof(Entry) == 16, "cache entries are 16 bytes on disk");
+
+inline uint64_t Fnv1a64(const void* data, size_t size, uint64_t hash = kFnvBasis)
+{
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= p[i];
+        hash *= kFnvPrime;
+    }
+    return hash;
+}
+
+// PE32 layout: e_lfanew at 0x3C; ImageBase 28 bytes into the optional
+// header, which follows the 4-byte signature and 20-byte file header
+constexpr size_t kLfanewOffset    = 0x3C;
+constexpr size_t kImageBaseOffset = 4 + 20 + 28;
+
+// `headers` is the first SizeOfHeaders bytes of the image (file or memory)
+inline uint64_t ImageKey(const uint8_t* headers, size_t size)
+{
+    uint32_t lfanew = 0;
+    if (size >= kLfanewOffset + sizeof(lfanew))
+        memcpy(&lfanew, headers + kLfanewOffset, sizeof(lfanew));
+
+    size_t field = static_cast<size_t>(lfanew) + kImageBaseOffset;
+    if (lfanew == 0 || field + sizeof(uint32_t) > size)
+        return Fnv1a64(headers, size);
+
+    const uint32_t zero = 0;
+    uint64_t h = Fnv1a64(headers, field);
+    h = Fnv1a64(&zero, sizeof(zero), h);
+    return Fnv1a64(headers + field + sizeof(zero), size - field - sizeof(zero), h);
+}
+
+// The key the DLL (live module) and tools/offset_gen (file on disk) both use,
+// so a table or cache generated offline matches any load of the same build
+inline uint64_t ImageKey(const PE::Image& image)
+{
+    std::span<const uint8_t> headers = image.Headers();
+    return ImageKey(headers.data(), headers.size());
+}
+
+inline uint64_t DefinitionsHash()
+{
+    uint64_t h = kFnvBasis;
+    for (const SigDef& def : kSigDefs)
+    {
+        h = Fnv1a64(def.name, strlen(def.name) + 1, h);
+        if (def.pattern)
+            h = Fnv1a64(def.pattern, strlen(def.pattern), h);
+        h = Fnv1a64("\0", 1, h);
+        h = Fnv1a64(&def.offset, sizeof(def.offset), h);
+        h = Fnv1a64(&def.kind, sizeof(def.kind), h);
+    }
+    return h;
+}
+
+// fopen is deprecated (an error under /sdl) in MSVC builds
+inline FILE* OpenFile(const char* path, const char* mode)
+{
+#ifdef _MSC_VER
+    FILE* f = nullptr;
+    return fopen_s(&f, path, mode) == 0 ? f : nullptr;
+#else
+    return fopen(path, mode);
+#endif
+}
+
+// Reads the file and checks magic, version, keys and entry count. Entry
+// contents are validated by the caller against the live image.
+inline bool Read(const char* path, uint64_t imageKey, std::vector<Entry>& out)
+{
+    FILE* f = OpenFile(path, "rb");
+    if (!f)
+        return false;
+
+    FileHeader header;
+    bool ok = fread(&header, sizeof(header), 1, f) == 1
+        && memcmp(header.magic, kMagic, sizeof(kMagic)) == 0
+        && header.version == kVersion
+        && header.count == static_cast<uint16_t>(Sig::Count)
+        && header.imageKey == imageKey
+        && header.defsHash == DefinitionsHash();
+    if (ok)
+    {
+        out.resize(header.count);
+        ok = fread(out.data(), sizeof(Entry), out.size(), f) == out.size();
+    }
+    fclose(f);
+    return ok;
+}
+
+inline bool Write(const char* path, uint64_t imageKey, const std::vector<Entry>& entries)
+{
+    FILE* f = OpenFile(path, "wb");
+    if (!f)
+        return false;
+
+    FileHeader header = {};
+    memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version  = kVersion;
+    header.count    = static_cast<uint16_t>(entries.size());
+    header.imageKey = imageKey;
+    header.defsHash = DefinitionsHash();
+
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1
+        && fwrite(entries.data(), sizeof(Entry), entries.size(), f) == entries.size();
+    ok = (fclose(f) == 0) && ok;
+    return ok;
+}
+
+} // namespace OffsetCache
@@ -0,0 +1,330 @@
+/**
+ * @file offsets.cpp
+ * @brief Implementation of code address resolution — .text signature scan with fixed-offset fallback.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "pch.h"
+#include "offsets.h"
+#include "offset_cache.h"
+#include "multi_scan.h"
+#include "core.h"
+#include "logger.h"
+
+#include <eqlib/Offsets.h>
+#include <eqlib/offsets/eqgame.h>
+
+// Written by tools/offset_gen; optional
+#if __has_include("offsets_generated.h")
+#include "offsets_generated.h"
+#define DINPUT8_GENERATED_OFFSETS 1
+#endif
+
+#include <cstring>
+#include <span>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// Raw offsets (not in eqlib offsets file for ROF2)
+// ---------------------------------------------------------------------------
+#define CEverQuest__HandleWorldMessage_x      0x4C3250
+#define EQ_Character__IsSpellcaster_x         0x443F50
+#define EQ_Character__IsSpellcaster_2_x       0x4288E0
+#define EQ_Character__IsSpellcaster_3_x       0x59FB90
+#define CSpellBookWnd__CanStartMemming_x      0x75BD40
+#define CharacterZoneClient__Max_Mana_x       0x581E60
+#define CharacterZoneClient__Cur_Mana_x       0x4442E0
+#define CharacterZoneClient__Max_Endurance_x  0x582020
+#define __GetGaugeValueFromEQ_x               0x762410
+#define __GetLabelFromEQ_x                    0x763640
+#define CombatAbilities__ClassCheck_x         0x65A087
+
+namespace Offsets
+{
+
+// Fixed addresses at the preferred image base, in Sig order
+static const uintptr_t kFallback[] = {
+    __ProcessGameEvents_x,
+    CEverQuest__HandleWorldMessage_x,
+    PlayerManagerClient__CreatePlayer_x,
+    PlayerManagerBase__PrepForDestroyPlayer_x,
+    EQGroundItemListManager__Add_x,
+    EQGroundItemListManager__Delete_x,
+    EQGroundItemListManager__Clear_x,
+    CEverQuest__InterpretCmd_x,
+    CDisplay__CleanGameUI_x,
+    CDisplay__ReloadUI_x,
+    CEverQuest__dsp_chat_x,
+
+    EQ_Character__IsSpellcaster_x,
+    EQ_Character__IsSpellcaster_2_x,
+    EQ_Character__IsSpellcaster_3_x,
+    EQ_Spell__GetSpellLevelNeeded_x,
+    CSpellBookWnd__CanStartMemming_x,
+    CharacterZoneClient__CanUseItem_x,
+
+    CharacterZoneClient__Max_Mana_x,
+    CharacterZoneClient__Cur_Mana_x,
+    CharacterZoneClient__Max_Endurance_x,
+    __GetGaugeValueFromEQ_x,
+    __GetLabelFromEQ_x,
+
+    CombatAbilities__ClassCheck_x,
+};
+
+static_assert(sizeof(kFallback) / sizeof(kFallback[0]) == static_cast<size_t>(Sig::Count),
+    "kFallback must have one entry per Sig");
+
+struct Entry
+{
+    uintptr_t address = 0;
+    Source    source = Source::None;
+};
+
+static Entry s_entries[static_cast<size_t>(Sig::Count)];
+static PE::Image s_image;
+static std::span<const uint8_t> s_text;
+
+// ---------------------------------------------------------------------------
+// Helpers
+// ---------------------------------------------------------------------------
+
+// Apply a pattern hit: match position + offset, following a rel32 operand
+static uintptr_t AddressFromHit(const SigDef& def, std::span<const uint8_t> text, size_t hit)
+{
+    uintptr_t at = reinterpret_cast<uintptr_t>(text.data()) + hit + def.offset;
+    if (def.kind == SigKind::Rel32)
+        at = at + 4 + *reinterpret_cast<const int32_t*>(at);
+    return at;
+}
+
+// Find every pattern in one pass over .text. out[i] is the address for
+// kSigDefs[i], or 0 if it has no pattern or doesn't match exactly once.
+static void ScanAll(std::span<const uint8_t> text, std::vector<uintptr_t>& out)
+{
+    out.assign(static_cast<size_t>(Sig::Count), 0);
+    if (text.empty())
+        return;
+
+    SigScan::MultiScanner scanner;
+    size_t patterns = 0;
+    for (const SigDef& def : kSigDefs)
+    {
+        SigScan::Pattern pattern;
+        if (def.pattern && !pattern.Parse(def.pattern))
+            LogFramework("Offsets: '%s' has a malformed pattern", def.name);
+        if (!pattern.Empty())
+            ++patterns;
+        scanner.Add(pattern);
+    }
+    if (!patterns)
+        return;
+
+    scanner.Build();
+    std::vector<std::vector<size_t>> hits;
+    scanner.Scan(text, hits, 2, 0);
+
+    for (size_t i = 0; i < out.size(); ++i)
+    {
+        const SigDef& def = kSigDefs[i];
+        if (!def.pattern)
+            continue;
+        if (hits[i].size() == 1)
+            out[i] = AddressFromHit(def, text, hits[i][0]);
+        else
+            LogFramework("Offsets: '%s' pattern matched %s", def.name,
+                hits[i].empty() ? "nothing" : "more than once");
+    }
+}
+
+// Signature result (or 0) -> entry, falling back to the fixed offset
+static void SetEntry(size_t i, uintptr_t fromSignature)
+{
+    Entry& e = s_entries[i];
+    if (fromSignature)
+    {
+        e.address = fromSignature;
+        e.source = Source::Signature;
+    }
+    else
+    {
+        e.address = eqlib::FixEQGameOffset(kFallback[i]);
+        e.source = Source::Fallback;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Generated table and cache
+// ---------------------------------------------------------------------------
+
+// Use offsets_generated.h when it was made from this exact client and
+// signature set — no scan and no file I/O.
+static bool LoadGenerated(uint64_t imageKey)
+{
+#ifdef DINPUT8_GENERATED_OFFSETS
+    static_assert(sizeof(OffsetsGenerated::kAddresses) / sizeof(OffsetsGenerated::kAddresses[0]) ==
+        static_cast<size_t>(Sig::Count), "offsets_generated.h is out of date — rerun tools/offset_gen");
+
+    if (OffsetsGenerated::kImageKey != imageKey)
+    {
+        LogFramework("Offsets: offsets_generated.h is for a different client (key 0x%016llX, running 0x%016llX) — ignoring it",
+            static_cast<unsigned long long>(OffsetsGenerated::kImageKey), static_cast<unsigned long long>(imageKey));
+        return false;
+    }
+    if (OffsetsGenerated::kDefsHash != OffsetCache::DefinitionsHash())
+    {
+        LogFramework("Offsets: offsets_generated.h predates the current signatures.h — ignoring it");
+        return false;
+    }
+    for (size_t i = 0; i < static_cast<size_t>(Sig::Count); ++i)
+    {
+        uintptr_t fixed = OffsetsGenerated::kAddresses[i];
+        SetEntry(i, fixed ? eqlib::FixEQGameOffset(fixed) : 0);
+    }
+    return true;
+#else
+    (void)imageKey;
+    return false;
+#endif
+}
+
+// Apply the cache if every stored signature address still holds the bytes
+// recorded when it was written.
+static bool LoadCache(uintptr_t base, uint64_t imageKey)
+{
+    std::vector<OffsetCache::Entry> cached;
+    if (!OffsetCache::Read(OffsetCache::kFileName, imageKey, cached))
+        return false;
+
+    for (const OffsetCache::Entry& c : cached)
+    {
+        if (c.source != static_cast<uint8_t>(OffsetCache::EntrySource::Signature))
+            continue;
+        const uint8_t* at = s_image.RvaToPtr(c.rva, OffsetCache::kCheckBytes);
+        if (!at || memcmp(at, c.check, OffsetCache::kCheckBytes) != 0)
+        {
+            LogFramework("Offsets: cache entry at RVA 0x%08X no longer matches — rescanning", c.rva);
+            return false;
+        }
+    }
+
+    for (size_t i = 0; i < cached.size(); ++i)
+    {
+        bool sig = cached[i].source == static_cast<uint8_t>(OffsetCache::EntrySource::Signature);
+        SetEntry(i, sig ? base + cached[i].rva : 0);
+    }
+    return true;
+}
+
+static void SaveCache(uintptr_t base, uint64_t imageKey)
+{
+    std::vector<OffsetCache::Entry> entries(static_cast<size_t>(Sig::Count));
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        OffsetCache::Entry& c = entries[i];
+        c = {};
+        if (s_entries[i].source != Source::Signature)
+            continue;
+        c.rva = static_cast<uint32_t>(s_entries[i].address - base);
+        c.source = static_cast<uint8_t>(OffsetCache::EntrySource::Signature);
+        memcpy(c.check, reinterpret_cast<const void*>(s_entries[i].address), OffsetCache::kCheckBytes);
+    }
+
+    if (!OffsetCache::Write(OffsetCache::kFileName, imageKey, entries))
+        LogFramework("Offsets: could not write %s", OffsetCache::kFileName);
+}
+
+// ---------------------------------------------------------------------------
+// Public API
+// ---------------------------------------------------------------------------
+
+void ResolveAll()
+{
+    const uintptr_t base = EQGameBaseAddress;
+    const PE::Section* text = s_image.ParseModule(base) ? s_image.FindSection(".text") : nullptr;
+    s_text = text ? s_image.SectionData(*text) : std::span<const uint8_t>();
+    bool haveImage = !s_text.empty();
+    if (!haveImage)
+        LogFramework("Offsets: .text section not found — using fixed offsets only");
+
+    // With no patterns there is nothing to scan, and a cache would only
+    // record that every entry is fixed
+    const bool haveSigs = SigPatternCount() != 0;
+    if (!haveSigs)
+        LogFramework("Offsets: signatures.h has no patterns — using fixed offsets, no scan or cache");
+
+    uint64_t imageKey = haveImage ? OffsetCache::ImageKey(s_image) : 0;
+    bool fromTable = haveImage && LoadGenerated(imageKey);
+    bool fromCache = !fromTable && haveImage && haveSigs && LoadCache(base, imageKey);
+    bool scanned = !fromTable && !fromCache;
+
+    if (scanned)
+    {
+        std::vector<uintptr_t> found(static_cast<size_t>(Sig::Count), 0);
+        if (haveSigs)
+            ScanAll(s_text, found);
+        for (size_t i = 0; i < found.size(); ++i)
+            SetEntry(i, found[i]);
+    }
+
+    size_t fromSig = 0;
+    for (const Entry& e : s_entries)
+        fromSig += e.source == Source::Signature;
+
+    // Only a scan that found something is worth caching
+    if (scanned && haveImage && fromSig != 0)
+        SaveCache(base, imageKey);
+
+    for (size_t i = 0; i < static_cast<size_t>(Sig::Count); ++i)
+    {
+        const Entry& e = s_entries[i];
+        LOG_DEFERRED("  %-26s = 0x%08X (%s)", kSigDefs[i].name, static_cast<unsigned int>(e.address),
+            e.source == Source::Signature ? "signature" : "fixed");
+    }
+
+    LogFramework("Offsets resolved%s: %zu by signature, %zu fixed",
+        fromTable ? " from generated table" : fromCache ? " from cache" : "",
+        fromSig, static_cast<size_t>(Sig::Count) - fromSig);
+}
+
+uintptr_t Get(Sig sig)
+{
+    return s_entries[static_cast<size_t>(sig)].address;
+}
+
+Source GetSource(Sig sig)
+{
+    return s_entries[static_cast<size_t>(sig)].source;
+}
+
+const char* GetName(Sig sig)
+{
+    return kSigDefs[static_cast<size_t>(sig)].name;
+}
+
+bool FindByName(const char* name, Sig& out)
+{
+    for (size_t i = 0; i < static_cast<size_t>(Sig::Count); ++i)
+    {
+        if (strcmp(kSigDefs[i].name, name) == 0)
+        {
+            out = static_cast<Sig>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+std::span<const uint8_t> GetTextSection()
+{
+    return s_text;
+}
+
+const PE::Image& GetImage()
+{
+    return s_image;
+}
+
+} // namespace Offsets
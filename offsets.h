@@ -0,0 +1,49 @@
+/**
+ * @file offsets.h
+ * @brief Code address resolution — byte signatures first, fixed client offsets as fallback.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Core calls ResolveAll() once during Initialize(), before any mod initializes,
+ * so mods can call Get() from their Initialize(). Entries are defined in
+ * signatures.h.
+ */
+
+#pragma once
+
+#include "signatures.h"
+#include "pe_image.h"
+
+#include <cstdint>
+#include <span>
+
+namespace Offsets
+{
+
+enum class Source : uint8_t
+{
+    None,        // unresolved (Get returns 0)
+    Signature,   // unique pattern match in .text
+    Fallback,    // fixed client offset, rebased
+};
+
+// Resolve every Sig. Needs EQGameBaseAddress (eqlib::InitBaseAddress).
+void ResolveAll();
+
+// Absolute address in the running process, or 0 if unresolved.
+uintptr_t Get(Sig sig);
+
+Source      GetSource(Sig sig);
+const char* GetName(Sig sig);
+
+// Case-sensitive lookup of a signatures.h entry name (e.g. "CanUseItem")
+bool FindByName(const char* name, Sig& out);
+
+// eqgame.exe's .text section in memory (empty before ResolveAll)
+std::span<const uint8_t> GetTextSection();
+
+// Parsed eqgame.exe headers over the live module (invalid before ResolveAll)
+const PE::Image& GetImage();
+
+} // namespace Offsets
@@ -0,0 +1,320 @@
+/**
+ * @file patches.cpp
+ * @brief Implementation of the byte patch manager — verification, page-batched writes, revert, file loading.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "pch.h"
+#include "patches.h"
+#include "memory.h"
+#include "offsets.h"
+#include "sig_scan.h"
+#include "core.h"
+
+#include <eqlib/Offsets.h>
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace Patches
+{
+
+struct Patch
+{
+    std::string          name;
+    uintptr_t            address = 0;
+    std::vector<uint8_t> expected;
+    std::vector<uint8_t> expectedMask;      // 0x00 = any byte
+    std::vector<uint8_t> replacement;
+    std::vector<uint8_t> replacementMask;   // 0x00 = keep the current byte
+    std::vector<uint8_t> original;          // recorded when applied
+    bool                 applied = false;
+    bool                 rejected = false;  // failed verification; not retried
+};
+
+static std::vector<Patch> s_patches;
+
+// ---------------------------------------------------------------------------
+// Helpers
+// ---------------------------------------------------------------------------
+
+static bool Matches(const uint8_t* at, const std::vector<uint8_t>& bytes, const std::vector<uint8_t>& mask)
+{
+    for (size_t i = 0; i < bytes.size(); ++i)
+    {
+        if ((at[i] & mask[i]) != bytes[i])
+            return false;
+    }
+    return true;
+}
+
+// The whole patch must sit inside one executable section of eqgame.exe, so
+// a bad locator or offset is refused before its bytes are even read.
+static bool InCodeSection(const Patch& p)
+{
+    const PE::Image& image = Offsets::GetImage();
+    uintptr_t base = reinterpret_cast<uintptr_t>(image.Bytes().data());
+    if (!image.Valid() || p.address < base)
+        return false;
+
+    uint32_t rva = static_cast<uint32_t>(p.address - base);
+    const PE::Section* s = image.SectionForRva(rva);
+    return s && s->IsExecutable() && s->Extent() - (rva - s->rva) >= p.expected.size();
+}
+
+static Patch* Find(const char* name)
+{
+    for (auto& p : s_patches)
+    {
+        if (p.name == name)
+            return &p;
+    }
+    return nullptr;
+}
+
+static bool AddMasked(const char* name, uintptr_t address,
+    std::vector<uint8_t> expected, std::vector<uint8_t> expectedMask,
+    std::vector<uint8_t> replacement, std::vector<uint8_t> replacementMask)
+{
+    if (!address || expected.empty() || expected.size() != replacement.size())
+    {
+        LogFramework("Patches: '%s' rejected (address 0x%08X, %zu expected vs %zu replacement bytes)",
+            name, static_cast<unsigned int>(address), expected.size(), replacement.size());
+        return false;
+    }
+    if (Find(name))
+    {
+        LogFramework("Patches: '%s' is already registered", name);
+        return false;
+    }
+
+    Patch p;
+    p.name            = name;
+    p.address         = address;
+    p.expected        = std::move(expected);
+    p.expectedMask    = std::move(expectedMask);
+    p.replacement     = std::move(replacement);
+    p.replacementMask = std::move(replacementMask);
+    s_patches.push_back(std::move(p));
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Patch file parsing
+// ---------------------------------------------------------------------------
+
+static std::string_view Trim(std::string_view s)
+{
+    while (!s.empty() && isspace(static_cast<unsigned char>(s.front())))
+        s.remove_prefix(1);
+    while (!s.empty() && isspace(static_cast<unsigned char>(s.back())))
+        s.remove_suffix(1);
+    return s;
+}
+
+// Hex byte list with ?? wildcards; reuses the signature parser
+static bool ParseBytes(std::string_view text, std::vector<uint8_t>& bytes, std::vector<uint8_t>& mask)
+{
+    SigScan::Pattern p;
+    if (!p.Parse(text))
+        return false;
+    bytes = std::move(p.bytes);
+    mask = std::move(p.mask);
+    return true;
+}
+
+static uintptr_t ResolveLocator(std::string_view loc)
+{
+    if (loc.substr(0, 4) == "sig:")
+    {
+        Sig sig;
+        std::string name(Trim(loc.substr(4)));
+        return Offsets::FindByName(name.c_str(), sig) ? Offsets::Get(sig) : 0;
+    }
+    if (loc.substr(0, 4) == "rva:")
+    {
+        std::string num(Trim(loc.substr(4)));
+        char* end = nullptr;
+        unsigned long rva = strtoul(num.c_str(), &end, 0);
+        return (end && *end == '\0') ? EQGameBaseAddress + rva : 0;
+    }
+    if (loc.substr(0, 4) == "pat:")
+    {
+        SigScan::Pattern p;
+        std::span<const uint8_t> text = Offsets::GetTextSection();
+        if (!p.Parse(loc.substr(4)) || text.empty())
+            return 0;
+        std::vector<size_t> hits;
+        SigScan::FindAll(text, p, hits, 2);
+        return hits.size() == 1 ? reinterpret_cast<uintptr_t>(text.data()) + hits[0] : 0;
+    }
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// Public API
+// ---------------------------------------------------------------------------
+
+bool Add(const char* name, uintptr_t address,
+    const std::vector<uint8_t>& expected, const std::vector<uint8_t>& replacement)
+{
+    return AddMasked(name, address,
+        expected, std::vector<uint8_t>(expected.size(), 0xFF),
+        replacement, std::vector<uint8_t>(replacement.size(), 0xFF));
+}
+
+bool Add(const char* name, Sig locator, int32_t offset,
+    const std::vector<uint8_t>& expected, const std::vector<uint8_t>& replacement)
+{
+    uintptr_t base = Offsets::Get(locator);
+    return Add(name, base ? base + offset : 0, expected, replacement);
+}
+
+size_t LoadFile(const char* path)
+{
+    FILE* f = nullptr;
+    if (fopen_s(&f, path, "r") != 0 || !f)
+        return 0;
+
+    size_t added = 0;
+    int lineNo = 0;
+    char line[512];
+    while (fgets(line, sizeof(line), f))
+    {
+        ++lineNo;
+        std::string_view rest = Trim(line);
+        if (rest.empty() || rest.front() == '#')
+            continue;
+
+        std::string_view fields[5];
+        size_t count = 0;
+        while (count < 5)
+        {
+            size_t bar = rest.find('|');
+            fields[count++] = Trim(rest.substr(0, bar));
+            if (bar == std::string_view::npos)
+                break;
+            rest.remove_prefix(bar + 1);
+        }
+        if (count != 5)
+        {
+            LogFramework("Patches: %s:%d — expected 5 '|'-separated fields", path, lineNo);
+            continue;
+        }
+
+        std::string name(fields[0]);
+        uintptr_t address = ResolveLocator(fields[1]);
+        if (!address)
+        {
+            LogFramework("Patches: %s:%d — locator '%.*s' did not resolve", path, lineNo,
+                static_cast<int>(fields[1].size()), fields[1].data());
+            continue;
+        }
+
+        std::string offsetText(fields[2]);
+        char* end = nullptr;
+        long offset = strtol(offsetText.c_str(), &end, 0);
+        std::vector<uint8_t> expected, expectedMask, replacement, replacementMask;
+        if (!end || *end != '\0' ||
+            !ParseBytes(fields[3], expected, expectedMask) ||
+            !ParseBytes(fields[4], replacement, replacementMask))
+        {
+            LogFramework("Patches: %s:%d — malformed offset or byte list", path, lineNo);
+            continue;
+        }
+
+        if (AddMasked(name.c_str(), address + offset, std::move(expected), std::move(expectedMask),
+                std::move(replacement), std::move(replacementMask)))
+            ++added;
+    }
+    fclose(f);
+
+    LogFramework("Patches: %zu loaded from %s", added, path);
+    return added;
+}
+
+size_t ApplyPending()
+{
+    std::vector<Patch*> ready;
+    for (auto& p : s_patches)
+    {
+        if (p.applied || p.rejected)
+            continue;
+        if (!InCodeSection(p))
+        {
+            LogFramework("Patches: WARNING — '%s' at 0x%08X is outside eqgame.exe's code sections",
+                p.name.c_str(), static_cast<unsigned int>(p.address));
+            p.rejected = true;
+            continue;
+        }
+        if (!Matches(reinterpret_cast<const uint8_t*>(p.address), p.expected, p.expectedMask))
+        {
+            LogFramework("Patches: WARNING — '%s' expected bytes not found at 0x%08X (already patched or unexpected)",
+                p.name.c_str(), static_cast<unsigned int>(p.address));
+            p.rejected = true;
+            continue;
+        }
+
+        // Final bytes: replacement, with ?? keeping whatever is there
+        const uint8_t* at = reinterpret_cast<const uint8_t*>(p.address);
+        p.original.assign(at, at + p.expected.size());
+        for (size_t i = 0; i < p.replacement.size(); ++i)
+        {
+            if (!p.replacementMask[i])
+                p.replacement[i] = p.original[i];
+        }
+        ready.push_back(&p);
+    }
+
+    std::vector<Memory::Write> writes;
+    for (Patch* p : ready)
+        writes.push_back({ p->address, p->replacement.data(), p->replacement.size() });
+    size_t pages = 0;
+    if (!Memory::WriteBatch(writes, &pages))
+        return 0;
+    if (!writes.empty())
+        LogFramework("Patches: wrote %zu patches across %zu pages", writes.size(), pages);
+
+    for (Patch* p : ready)
+    {
+        p->applied = true;
+        LogFramework("Patches: '%s' applied at 0x%08X (%zu bytes)", p->name.c_str(),
+            static_cast<unsigned int>(p->address), p->replacement.size());
+    }
+    return ready.size();
+}
+
+void RevertAll()
+{
+    std::vector<Memory::Write> writes;
+    for (const auto& p : s_patches)
+    {
+        if (!p.applied)
+            continue;
+        // Someone else rewrote it since; leave their bytes alone
+        if (memcmp(reinterpret_cast<const void*>(p.address), p.replacement.data(), p.replacement.size()) != 0)
+        {
+            LogFramework("Patches: '%s' was modified after it was applied — not reverting", p.name.c_str());
+            continue;
+        }
+        writes.push_back({ p.address, p.original.data(), p.original.size() });
+    }
+
+    if (Memory::WriteBatch(writes) && !writes.empty())
+        LogFramework("Patches: %zu reverted", writes.size());
+    s_patches.clear();
+}
+
+bool IsApplied(const char* name)
+{
+    const Patch* p = Find(name);
+    return p && p->applied;
+}
+
+} // namespace Patches
@@ -0,0 +1,70 @@
+/**
+ * @file patches.h
+ * @brief Declarative byte patches — verified, applied in one batch per page, reverted on shutdown.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * A patch is (name, address, expected bytes, replacement bytes). Mods queue
+ * patches from Initialize():
+ *
+ *     Patches::Add("CombatAbilities", Sig::CombatAbilitiesClassCheck, 0,
+ *         { 0x74, 0x09 },    // JE +9
+ *         { 0x90, 0x90 });   // NOP NOP
+ *
+ * Core applies everything queued after the mods have initialized. Each patch
+ * must lie inside an executable section of eqgame.exe and is checked against
+ * its expected bytes first; a failure skips that patch only. The writes are
+ * grouped by page: each touched page is made writable once, all its patches
+ * are copied, its protection is restored, and a single FlushInstructionCache
+ * covers the batch. The original bytes are recorded, and RevertAll()
+ * (Core::Shutdown) restores them the same way.
+ *
+ * Patch sets can also come from a text file (LoadFile; Core reads
+ * dinput8_patches.txt from the game directory if it exists), one per line:
+ *
+ *     # name     | locator                  | offset | expected | replacement
+ *     SomeCheck  | sig:CanUseItem           | 0x1C   | 75 ??    | EB ??
+ *     OtherCheck | rva:0x25A0F0             | 0      | 74 09    | 90 90
+ *     ThirdCheck | pat:8B 0D ?? ?? ?? ?? 74 | 6      | 74       | EB
+ *
+ * Locators: `sig:` a signatures.h entry name, `rva:` an offset from the image
+ * base, or `pat:` an IDA-style pattern that must match exactly once in .text.
+ * `??` in expected accepts any byte; `??` in replacement keeps the byte.
+ *
+ * Game thread only (Initialize / Shutdown).
+ */
+
+#pragma once
+
+#include "signatures.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Patches
+{
+
+// Queue a patch. False (logged) if the address is 0, the byte lists are
+// empty or differ in length, or the name is already taken.
+bool Add(const char* name, uintptr_t address,
+    const std::vector<uint8_t>& expected, const std::vector<uint8_t>& replacement);
+
+// Address = Offsets::Get(locator) + offset
+bool Add(const char* name, Sig locator, int32_t offset,
+    const std::vector<uint8_t>& expected, const std::vector<uint8_t>& replacement);
+
+// Parse a patch file (format above) and queue its entries. Returns how many
+// were queued; a missing file returns 0 without logging.
+size_t LoadFile(const char* path);
+
+// Verify and apply every queued patch. Returns how many were applied.
+size_t ApplyPending();
+
+// Restore the original bytes of every applied patch and forget all patches.
+void RevertAll();
+
+bool IsApplied(const char* name);
+
+} // namespace Patches
@@ -0,0 +1,352 @@
+/**
+ * @file pe_image.cpp
+ * @brief Implementation of the PE32 parser — bounds-checked header, section and directory decoding.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "pe_image.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace PE
+{
+
+// winnt.h layout constants
+static constexpr uint16_t kDosMagic       = 0x5A4D;       // "MZ"
+static constexpr uint32_t kNtSignature    = 0x00004550;   // "PE\0\0"
+static constexpr uint16_t kPe32Magic      = 0x010B;
+static constexpr size_t   kFileHeaderSize = 20;
+static constexpr size_t   kSectionSize    = 40;
+static constexpr size_t   kImportDescSize = 20;
+static constexpr uint16_t kRelocHighLow   = 3;
+static constexpr uint16_t kRelocAbsolute  = 0;
+
+// Optional header (PE32) field offsets
+static constexpr size_t kOptEntryPoint = 16;
+static constexpr size_t kOptImageBase  = 28;
+static constexpr size_t kOptSizeOfImage = 56;
+static constexpr size_t kOptSizeOfHeaders = 60;
+static constexpr size_t kOptCheckSum   = 64;
+static constexpr size_t kOptDirCount   = 92;
+static constexpr size_t kOptDirectory  = 96;
+
+template <typename T>
+static bool ReadAt(std::span<const uint8_t> bytes, size_t offset, T& out)
+{
+    if (offset > bytes.size() || bytes.size() - offset < sizeof(T))
+        return false;
+    memcpy(&out, bytes.data() + offset, sizeof(T));
+    return true;
+}
+
+template <typename T>
+static T Load(const uint8_t* p)
+{
+    T v;
+    memcpy(&v, p, sizeof(T));
+    return v;
+}
+
+// ---------------------------------------------------------------------------
+// Headers
+// ---------------------------------------------------------------------------
+
+bool Image::Parse(std::span<const uint8_t> bytes, Layout layout)
+{
+    *this = Image();
+    m_bytes = bytes;
+    m_layout = layout;
+
+    uint16_t dosMagic = 0;
+    uint32_t lfanew = 0, signature = 0;
+    if (!ReadAt(bytes, 0, dosMagic) || dosMagic != kDosMagic ||
+        !ReadAt(bytes, 0x3C, lfanew) ||
+        !ReadAt(bytes, lfanew, signature) || signature != kNtSignature)
+        return false;
+
+    const size_t fileHeader = static_cast<size_t>(lfanew) + 4;
+    uint16_t sectionCount = 0, optSize = 0;
+    uint16_t optMagic = 0;
+    if (!ReadAt(bytes, fileHeader + 2, sectionCount) ||
+        !ReadAt(bytes, fileHeader + 4, m_timeDateStamp) ||
+        !ReadAt(bytes, fileHeader + 16, optSize))
+        return false;
+
+    const size_t opt = fileHeader + kFileHeaderSize;
+    if (!ReadAt(bytes, opt, optMagic) || optMagic != kPe32Magic || optSize < kOptDirectory ||
+        !ReadAt(bytes, opt + kOptEntryPoint, m_entryRva) ||
+        !ReadAt(bytes, opt + kOptImageBase, m_imageBase) ||
+        !ReadAt(bytes, opt + kOptSizeOfImage, m_sizeOfImage) ||
+        !ReadAt(bytes, opt + kOptSizeOfHeaders, m_sizeOfHeaders) ||
+        !ReadAt(bytes, opt + kOptCheckSum, m_checkSum) ||
+        !ReadAt(bytes, opt + kOptDirCount, m_dirCount))
+        return false;
+
+    // Only directories that fit in the optional header count
+    m_dirCount = std::min<uint32_t>(m_dirCount, static_cast<uint32_t>((optSize - kOptDirectory) / 8));
+    m_dirOffset = opt + kOptDirectory;
+
+    const size_t sectionTable = opt + optSize;
+    if (sectionTable > bytes.size() || (bytes.size() - sectionTable) / kSectionSize < sectionCount)
+        return false;
+
+    m_sections.reserve(sectionCount);
+    for (uint16_t i = 0; i < sectionCount; ++i)
+    {
+        const uint8_t* h = bytes.data() + sectionTable + i * kSectionSize;
+        Section s = {};
+        memcpy(s.name, h, 8);
+        s.name[8] = '\0';
+        s.virtualSize     = Load<uint32_t>(h + 8);
+        s.rva             = Load<uint32_t>(h + 12);
+        s.rawSize         = Load<uint32_t>(h + 16);
+        s.rawOffset       = Load<uint32_t>(h + 20);
+        s.characteristics = Load<uint32_t>(h + 36);
+        m_sections.push_back(s);
+    }
+
+    m_valid = true;
+    return true;
+}
+
+bool Image::ParseModule(uintptr_t base)
+{
+    if (!base)
+        return false;
+
+    // Read just enough to learn SizeOfImage, then parse the whole mapping
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(base);
+    uint16_t dosMagic = Load<uint16_t>(p);
+    if (dosMagic != kDosMagic)
+        return false;
+    uint32_t lfanew = Load<uint32_t>(p + 0x3C);
+    if (Load<uint32_t>(p + lfanew) != kNtSignature)
+        return false;
+    uint32_t sizeOfImage = Load<uint32_t>(p + lfanew + 4 + kFileHeaderSize + kOptSizeOfImage);
+
+    return Parse({ p, sizeOfImage }, Layout::Mapped);
+}
+
+std::span<const uint8_t> Image::Headers() const
+{
+    return m_bytes.first(std::min<size_t>(m_sizeOfHeaders, m_bytes.size()));
+}
+
+// ---------------------------------------------------------------------------
+// Sections and address translation
+// ---------------------------------------------------------------------------
+
+const Section* Image::FindSection(std::string_view name) const
+{
+    for (const auto& s : m_sections)
+    {
+        if (name == s.name)
+            return &s;
+    }
+    return nullptr;
+}
+
+const Section* Image::SectionForRva(uint32_t rva) const
+{
+    for (const auto& s : m_sections)
+    {
+        if (s.ContainsRva(rva))
+            return &s;
+    }
+    return nullptr;
+}
+
+std::span<const uint8_t> Image::SectionData(const Section& section) const
+{
+    size_t offset, size;
+    if (m_layout == Layout::Mapped)
+    {
+        offset = section.rva;
+        size = section.Extent();
+    }
+    else
+    {
+        offset = section.rawOffset;
+        size = section.rawSize;
+    }
+    if (offset > m_bytes.size())
+        return {};
+    return m_bytes.subspan(offset, std::min(size, m_bytes.size() - offset));
+}
+
+const uint8_t* Image::RvaToPtr(uint32_t rva, size_t size) const
+{
+    size_t offset;
+    if (m_layout == Layout::Mapped || rva < m_sizeOfHeaders)
+    {
+        offset = rva;
+    }
+    else
+    {
+        const Section* s = SectionForRva(rva);
+        if (!s || rva - s->rva >= s->rawSize || s->rawSize - (rva - s->rva) < size)
+            return nullptr;
+        offset = static_cast<size_t>(s->rawOffset) + (rva - s->rva);
+    }
+
+    if (offset > m_bytes.size() || m_bytes.size() - offset < size)
+        return nullptr;
+    return m_bytes.data() + offset;
+}
+
+bool Image::PtrToRva(const uint8_t* p, uint32_t& rva) const
+{
+    if (p < m_bytes.data() || p >= m_bytes.data() + m_bytes.size())
+        return false;
+    size_t offset = static_cast<size_t>(p - m_bytes.data());
+
+    if (m_layout == Layout::Mapped || offset < m_sizeOfHeaders)
+    {
+        rva = static_cast<uint32_t>(offset);
+        return true;
+    }
+    for (const auto& s : m_sections)
+    {
+        if (offset >= s.rawOffset && offset - s.rawOffset < s.rawSize)
+        {
+            rva = s.rva + static_cast<uint32_t>(offset - s.rawOffset);
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string_view Image::CString(uint32_t rva) const
+{
+    const uint8_t* p = RvaToPtr(rva);
+    if (!p)
+        return {};
+    size_t max = static_cast<size_t>(m_bytes.data() + m_bytes.size() - p);
+    const void* nul = memchr(p, 0, max);
+    if (!nul)
+        return {};
+    return { reinterpret_cast<const char*>(p), static_cast<size_t>(static_cast<const uint8_t*>(nul) - p) };
+}
+
+// ---------------------------------------------------------------------------
+// Data directories
+// ---------------------------------------------------------------------------
+
+std::span<const uint8_t> Image::Directory(unsigned index, uint32_t* rvaOut) const
+{
+    if (!m_valid || index >= m_dirCount)
+        return {};
+
+    uint32_t rva = 0, size = 0;
+    if (!ReadAt(m_bytes, m_dirOffset + index * 8, rva) || !ReadAt(m_bytes, m_dirOffset + index * 8 + 4, size))
+        return {};
+    if (!rva || !size)
+        return {};
+
+    const uint8_t* p = RvaToPtr(rva, size);
+    if (!p)
+        return {};
+    if (rvaOut)
+        *rvaOut = rva;
+    return { p, size };
+}
+
+bool Image::Imports(std::vector<Import>& out) const
+{
+    uint32_t dirRva = 0;
+    std::span<const uint8_t> dir = Directory(kDirImport, &dirRva);
+    if (dir.empty())
+        return true;
+
+    for (uint32_t d = 0;; d += kImportDescSize)
+    {
+        // The descriptor array is NUL-terminated and may run past the
+        // directory's declared size, so read through RvaToPtr
+        const uint8_t* desc = RvaToPtr(dirRva + d, kImportDescSize);
+        if (!desc)
+            return false;
+
+        uint32_t lookupRva = Load<uint32_t>(desc + 0);
+        uint32_t nameRva   = Load<uint32_t>(desc + 12);
+        uint32_t iatRva    = Load<uint32_t>(desc + 16);
+        if (!nameRva && !iatRva)
+            return true;
+
+        std::string_view module = CString(nameRva);
+        if (module.empty())
+            return false;
+
+        // Bound or already-patched IATs hold addresses; prefer the lookup table
+        uint32_t thunkRva = lookupRva ? lookupRva : iatRva;
+        for (uint32_t t = 0;; t += 4)
+        {
+            const uint8_t* thunk = RvaToPtr(thunkRva + t, 4);
+            if (!thunk)
+                return false;
+            uint32_t value = Load<uint32_t>(thunk);
+            if (!value)
+                break;
+
+            Import imp = {};
+            imp.module = module;
+            imp.iatRva = iatRva + t;
+            if (value & 0x80000000u)
+            {
+                imp.ordinal = static_cast<uint16_t>(value & 0xFFFF);
+            }
+            else
+            {
+                imp.name = CString(value + 2);   // skip the Hint
+                if (imp.name.empty())
+                    return false;
+            }
+            out.push_back(imp);
+        }
+    }
+}
+
+bool Image::Relocations(std::vector<uint32_t>& out) const
+{
+    std::span<const uint8_t> dir = Directory(kDirBaseReloc);
+    size_t pos = 0;
+    while (dir.size() - pos >= 8)
+    {
+        uint32_t pageRva = Load<uint32_t>(dir.data() + pos);
+        uint32_t blockSize = Load<uint32_t>(dir.data() + pos + 4);
+        if (blockSize < 8 || blockSize > dir.size() - pos)
+            return false;
+
+        for (size_t e = pos + 8; e + 2 <= pos + blockSize; e += 2)
+        {
+            uint16_t entry = Load<uint16_t>(dir.data() + e);
+            uint16_t type = entry >> 12;
+            if (type == kRelocHighLow)
+                out.push_back(pageRva + (entry & 0x0FFF));
+            else if (type != kRelocAbsolute)
+                return false;   // nothing else is valid in a PE32 x86 image
+        }
+        pos += blockSize;
+    }
+    return true;
+}
+
+bool Image::ExceptionEntries(std::vector<RuntimeFunction>& out) const
+{
+    std::span<const uint8_t> dir = Directory(kDirException);
+    if (dir.size() % sizeof(RuntimeFunction) != 0)
+        return false;
+    for (size_t pos = 0; pos < dir.size(); pos += sizeof(RuntimeFunction))
+    {
+        RuntimeFunction f;
+        f.begin      = Load<uint32_t>(dir.data() + pos);
+        f.end        = Load<uint32_t>(dir.data() + pos + 4);
+        f.unwindInfo = Load<uint32_t>(dir.data() + pos + 8);
+        out.push_back(f);
+    }
+    return true;
+}
+
+} // namespace PE
@@ -0,0 +1,156 @@
+/**
+ * @file pe_image.h
+ * @brief Zero-copy PE32 parser — headers, sections, imports, base relocations and
+ *        the exception directory, over a loaded module or a file on disk.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * PE::Image never copies the image. It reads through the byte span it was
+ * given and hands out spans and string_views into it. The same parser serves
+ * two layouts:
+ *
+ *   Layout::Mapped  a module the loader has mapped (eqgame.exe in-process):
+ *                   RVAs are offsets from the base.
+ *   Layout::File    the raw file (e.g. through MappedFile): RVAs are
+ *                   translated through the section table.
+ *
+ *     PE::Image live;
+ *     live.ParseModule(EQGameBaseAddress);
+ *     auto text = live.SectionData(*live.FindSection(".text"));
+ *
+ *     MappedFile file;
+ *     PE::Image disk;
+ *     if (file.Open("eqgame.exe") && disk.Parse(file.Data(), PE::Layout::File)) ...
+ *
+ * Every read is bounds-checked against the span, so a truncated or hostile
+ * file fails to parse instead of reading past the end. Portable (no Windows
+ * headers): the structures are decoded by offset rather than through
+ * winnt.h types.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace PE
+{
+
+enum class Layout : uint8_t
+{
+    Mapped,
+    File,
+};
+
+// Data directory indices used here (winnt.h IMAGE_DIRECTORY_ENTRY_*)
+constexpr unsigned kDirImport    = 1;
+constexpr unsigned kDirException = 3;
+constexpr unsigned kDirBaseReloc = 5;
+
+constexpr uint32_t kSectionCode    = 0x00000020;   // IMAGE_SCN_CNT_CODE
+constexpr uint32_t kSectionExecute = 0x20000000;   // IMAGE_SCN_MEM_EXECUTE
+constexpr uint32_t kSectionWrite   = 0x80000000;   // IMAGE_SCN_MEM_WRITE
+
+struct Section
+{
+    char     name[9];          // NUL-terminated copy of the 8-byte name
+    uint32_t rva;
+    uint32_t virtualSize;
+    uint32_t rawOffset;
+    uint32_t rawSize;
+    uint32_t characteristics;
+
+    bool IsExecutable() const { return (characteristics & (kSectionCode | kSectionExecute)) != 0; }
+    bool ContainsRva(uint32_t r) const { return r >= rva && r - rva < Extent(); }
+    uint32_t Extent() const { return virtualSize ? virtualSize : rawSize; }
+};
+
+struct Import
+{
+    std::string_view module;   // e.g. "KERNEL32.dll"
+    std::string_view name;     // empty when imported by ordinal
+    uint16_t         ordinal;  // valid when name is empty
+    uint32_t         iatRva;   // RVA of this import's IAT slot
+};
+
+// x64/ARM .pdata entry. A PE32 x86 image normally has no exception
+// directory (x86 SEH is frame-based), so expect this to be empty for eqgame.
+struct RuntimeFunction
+{
+    uint32_t begin;
+    uint32_t end;
+    uint32_t unwindInfo;
+};
+
+class Image
+{
+public:
+    // False on anything that isn't a well-formed PE32 within `bytes`
+    bool Parse(std::span<const uint8_t> bytes, Layout layout);
+
+    // Loaded module at `base`; the span is sized from the module's own
+    // SizeOfImage.
+    bool ParseModule(uintptr_t base);
+
+    bool     Valid() const { return m_valid; }
+    Layout   GetLayout() const { return m_layout; }
+    uint32_t ImageBase() const { return m_imageBase; }        // preferred base from the header
+    uint32_t SizeOfImage() const { return m_sizeOfImage; }
+    uint32_t EntryPointRva() const { return m_entryRva; }
+    uint32_t TimeDateStamp() const { return m_timeDateStamp; }
+    uint32_t CheckSum() const { return m_checkSum; }
+
+    // The whole span the image was parsed from
+    std::span<const uint8_t> Bytes() const { return m_bytes; }
+
+    // First SizeOfHeaders bytes (DOS + NT headers + section table)
+    std::span<const uint8_t> Headers() const;
+
+    const std::vector<Section>& Sections() const { return m_sections; }
+    const Section* FindSection(std::string_view name) const;
+    const Section* SectionForRva(uint32_t rva) const;
+
+    // A section's bytes as they appear in this layout (virtual size when
+    // mapped, raw size in a file)
+    std::span<const uint8_t> SectionData(const Section& section) const;
+
+    // Pointer to `size` bytes at `rva`, or nullptr if they aren't all backed
+    // by the span
+    const uint8_t* RvaToPtr(uint32_t rva, size_t size = 1) const;
+
+    // Inverse of RvaToPtr for pointers inside Bytes(); false if outside
+    bool PtrToRva(const uint8_t* p, uint32_t& rva) const;
+
+    // Raw data directory, empty if absent or out of bounds
+    std::span<const uint8_t> Directory(unsigned index, uint32_t* rva = nullptr) const;
+
+    // Decoders — append to `out`; false if the directory is malformed
+    // (entries decoded before the fault are kept).
+    bool Imports(std::vector<Import>& out) const;
+    bool Relocations(std::vector<uint32_t>& out) const;   // RVAs of HIGHLOW fixups
+    bool ExceptionEntries(std::vector<RuntimeFunction>& out) const;
+
+private:
+    std::string_view CString(uint32_t rva) const;
+
+    std::span<const uint8_t> m_bytes;
+    Layout                   m_layout = Layout::Mapped;
+    bool                     m_valid = false;
+
+    uint32_t m_imageBase = 0;
+    uint32_t m_sizeOfImage = 0;
+    uint32_t m_sizeOfHeaders = 0;
+    uint32_t m_entryRva = 0;
+    uint32_t m_timeDateStamp = 0;
+    uint32_t m_checkSum = 0;
+    uint32_t m_dirCount = 0;
+    size_t   m_dirOffset = 0;          // file offset of DataDirectory[0]
+
+    std::vector<Section> m_sections;
+};
+
+} // namespace PE
@@ -0,0 +1,197 @@
+/**
+ * @file profiler.cpp
+ * @brief Implementation of the hot-path profiler — log2 cycle histograms and the /perf command.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "pch.h"
+#include "profiler.h"
+#include "core.h"
+
+#include <intrin.h>
+
+#include <cstring>
+#include <vector>
+
+namespace Profiler
+{
+
+bool g_enabled = false;
+
+// Bucket b counts calls that took [2^b, 2^(b+1)) cycles; bucket 0 also takes 0.
+static constexpr int kBuckets = 40;
+
+struct Histogram
+{
+    uint64_t buckets[kBuckets];
+    uint64_t count;
+    uint64_t max;
+};
+
+struct ModRow
+{
+    IMod*     mod;
+    Histogram events[static_cast<size_t>(ModEvent::Count)];
+};
+
+static std::vector<ModRow> s_rows;
+
+// TSC calibration against QueryPerformanceCounter, taken when profiling starts.
+static uint64_t s_startTsc = 0;
+static LONGLONG s_startQpc = 0;
+
+static const char* const kEventNames[] =
+{
+    "Pulse",
+    "IncomingMessage",
+    "AddSpawn",
+    "RemoveSpawn",
+    "AddGroundItem",
+    "RemoveGroundItem",
+    "ClearGroundItems",
+    "SetGameState",
+    "CleanUI",
+    "ReloadUI",
+    "SpawnBatch",
+    "GroundItemBatch",
+};
+static_assert(sizeof(kEventNames) / sizeof(kEventNames[0]) == static_cast<size_t>(ModEvent::Count),
+    "kEventNames must match ModEvent");
+
+static int BucketOf(uint64_t cycles)
+{
+    int b = 0;
+    while (cycles > 1 && b < kBuckets - 1)
+    {
+        cycles >>= 1;
+        ++b;
+    }
+    return b;
+}
+
+// Upper bound (in cycles) of the bucket holding the given percentile.
+static uint64_t Percentile(const Histogram& h, double pct)
+{
+    uint64_t target = static_cast<uint64_t>(static_cast<double>(h.count) * pct);
+    if (target == 0)
+        target = 1;
+
+    uint64_t seen = 0;
+    for (int b = 0; b < kBuckets; ++b)
+    {
+        seen += h.buckets[b];
+        if (seen >= target)
+            return (b + 1 < 64) ? (1ull << (b + 1)) : h.max;
+    }
+    return h.max;
+}
+
+uint32_t AddMod(IMod* mod)
+{
+    ModRow row = {};
+    row.mod = mod;
+    s_rows.push_back(row);
+    return static_cast<uint32_t>(s_rows.size() - 1);
+}
+
+void Record(uint32_t row, ModEvent event, uint64_t cycles)
+{
+    Histogram& h = s_rows[row].events[static_cast<size_t>(event)];
+    ++h.buckets[BucketOf(cycles)];
+    ++h.count;
+    if (cycles > h.max)
+        h.max = cycles;
+}
+
+void Reset()
+{
+    for (auto& row : s_rows)
+        memset(row.events, 0, sizeof(row.events));
+
+    LARGE_INTEGER qpc;
+    QueryPerformanceCounter(&qpc);
+    s_startQpc = qpc.QuadPart;
+    s_startTsc = __rdtsc();
+}
+
+void Enable(bool enable)
+{
+    if (enable && !g_enabled)
+        Reset();
+    g_enabled = enable;
+    LogFramework("Profiler %s", enable ? "enabled" : "disabled");
+}
+
+void Dump()
+{
+    LARGE_INTEGER qpc, freq;
+    QueryPerformanceCounter(&qpc);
+    QueryPerformanceFrequency(&freq);
+    uint64_t tscDelta = __rdtsc() - s_startTsc;
+    double seconds = static_cast<double>(qpc.QuadPart - s_startQpc) / static_cast<double>(freq.QuadPart);
+
+    if (tscDelta == 0 || seconds <= 0.0)
+    {
+        WriteChatf("/perf: no samples (profiling %s)", g_enabled ? "on" : "off");
+        return;
+    }
+
+    double usPerCycle = seconds * 1e6 / static_cast<double>(tscDelta);
+
+    WriteChatf("/perf: %.1f s sampled, profiling %s (p50/p99 are bucket upper bounds)",
+        seconds, g_enabled ? "on" : "off");
+    WriteChatf("  mod / event: calls  p50 us  p99 us  max us");
+
+    int rows = 0;
+    for (const auto& row : s_rows)
+    {
+        for (size_t e = 0; e < static_cast<size_t>(ModEvent::Count); ++e)
+        {
+            const Histogram& h = row.events[e];
+            if (h.count == 0)
+                continue;
+
+            WriteChatf("  %s / %s: %llu  %.2f  %.2f  %.2f",
+                row.mod->GetName(), kEventNames[e],
+                static_cast<unsigned long long>(h.count),
+                static_cast<double>(Percentile(h, 0.50)) * usPerCycle,
+                static_cast<double>(Percentile(h, 0.99)) * usPerCycle,
+                static_cast<double>(h.max) * usPerCycle);
+            ++rows;
+        }
+    }
+
+    if (rows == 0)
+        WriteChatf("  (no handler calls recorded)");
+}
+
+void Command(eqlib::PlayerClient* pChar, const char* szLine)
+{
+    if (_stricmp(szLine, "on") == 0)
+    {
+        Enable(true);
+        WriteChatf("/perf: profiling on");
+    }
+    else if (_stricmp(szLine, "off") == 0)
+    {
+        Enable(false);
+        WriteChatf("/perf: profiling off");
+    }
+    else if (_stricmp(szLine, "reset") == 0)
+    {
+        Reset();
+        WriteChatf("/perf: counters reset");
+    }
+    else if (*szLine == '\0')
+    {
+        Dump();
+    }
+    else
+    {
+        WriteChatf("Usage: /perf [on|off|reset]");
+    }
+}
+
+} // namespace Profiler
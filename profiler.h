@@ -0,0 +1,49 @@
+/**
+ * @file profiler.h
+ * @brief Hot-path profiler — per (mod, event) cycle histograms for the core dispatch loops.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Core's dispatch loops test IsEnabled() once per event; when profiling is off
+ * that single branch is the whole cost. When on, each handler call is bracketed
+ * with __rdtsc() and the delta lands in a fixed log2-bucket histogram, from
+ * which /perf reports call count, p50, p99 and max.
+ */
+
+#pragma once
+
+#include "mods/mod_interface.h"
+#include <cstdint>
+
+namespace eqlib { class PlayerClient; }
+
+namespace Profiler
+{
+
+// Written only from the /perf command on the game thread.
+extern bool g_enabled;
+
+inline bool IsEnabled()
+{
+    return g_enabled;
+}
+
+// Allocate a histogram row for a mod and return its index. Called once from
+// Core::RegisterMod, which keeps the index next to the mod in its handler arrays.
+uint32_t AddMod(IMod* mod);
+
+// Record one handler call against a row from AddMod. Only called while
+// profiling is enabled.
+void Record(uint32_t row, ModEvent event, uint64_t cycles);
+
+void Enable(bool enable);
+void Reset();
+
+// Print the (mod, event) table to chat.
+void Dump();
+
+// /perf [on|off|reset]
+void Command(eqlib::PlayerClient* pChar, const char* szLine);
+
+} // namespace Profiler
@@ -0,0 +1,375 @@
+/**
+ * @file scheduler.cpp
+ * @brief Implementation of the frame-budgeted scheduler — timing wheels, task pool, ready queue.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Tasks live in a pooled vector and are linked into exactly one intrusive
+ * doubly-linked list at a time: a wheel slot, the ready queue, or the free
+ * list. TaskId packs (generation << 16 | index) so stale handles are rejected.
+ *
+ * Wheel placement: a task due `delta` ticks from now goes to the lowest level L
+ * with delta < 64^(L+1), in slot (expiry >> 6L) & 63. When a level's slot index
+ * wraps, the matching slot of the level above is cascaded back down. A task
+ * due beyond 64^4 - 1 ticks is parked in the top level at that horizon and
+ * re-placed each time its slot cascades.
+ */
+
+#include "pch.h"
+#include "scheduler.h"
+#include "core.h"
+
+#include <vector>
+
+namespace Scheduler
+{
+
+static constexpr int      kLevels   = 4;
+static constexpr int      kSlotBits = 6;
+static constexpr uint32_t kSlots    = 1u << kSlotBits;
+static constexpr uint64_t kMaxDelta = (1ull << (kLevels * kSlotBits)) - 1;
+static constexpr uint32_t kNil      = 0xFFFFFFFFu;
+static constexpr uint32_t kMaxTasks = 0xFFFF;
+
+struct TaskList
+{
+    uint32_t head = kNil;
+    uint32_t tail = kNil;
+};
+
+struct Task
+{
+    TaskFn     fn;
+    IMod*      owner      = nullptr;
+    uint64_t   expiry     = 0;
+    uint32_t   interval   = 0;      // 0 = one-shot
+    Cadence    unit       = Cadence::Frames;
+    uint16_t   generation = 0;
+    bool       live       = false;
+    bool       running    = false;
+    bool       cancelled  = false;
+    uint32_t   prev       = kNil;
+    uint32_t   next       = kNil;
+    TaskList*  list       = nullptr;
+};
+
+static std::vector<Task> s_tasks;
+static TaskList          s_free;
+static TaskList          s_ready;
+static uint32_t          s_budgetUs = 2000;
+
+// ---------------------------------------------------------------------------
+// Intrusive list helpers
+// ---------------------------------------------------------------------------
+
+static void PushBack(TaskList& list, uint32_t idx)
+{
+    Task& t = s_tasks[idx];
+    t.prev = list.tail;
+    t.next = kNil;
+    t.list = &list;
+    if (list.tail != kNil)
+        s_tasks[list.tail].next = idx;
+    else
+        list.head = idx;
+    list.tail = idx;
+}
+
+static void Unlink(uint32_t idx)
+{
+    Task& t = s_tasks[idx];
+    if (!t.list)
+        return;
+
+    if (t.prev != kNil) s_tasks[t.prev].next = t.next;
+    else                t.list->head = t.next;
+    if (t.next != kNil) s_tasks[t.next].prev = t.prev;
+    else                t.list->tail = t.prev;
+
+    t.prev = t.next = kNil;
+    t.list = nullptr;
+}
+
+static uint32_t PopFront(TaskList& list)
+{
+    uint32_t idx = list.head;
+    if (idx != kNil)
+        Unlink(idx);
+    return idx;
+}
+
+// ---------------------------------------------------------------------------
+// Timing wheel
+// ---------------------------------------------------------------------------
+
+class TimingWheel
+{
+public:
+    uint64_t now = 0;
+
+    void Insert(uint32_t idx)
+    {
+        Task& t = s_tasks[idx];
+        if (t.expiry <= now)
+        {
+            PushBack(s_ready, idx);
+            return;
+        }
+
+        // Beyond the wheel's span, park the task at the horizon. The expiry
+        // is kept, so when that slot cascades Insert parks it again or files
+        // it for real.
+        uint64_t delta = t.expiry - now;
+        uint64_t at = t.expiry;
+        if (delta > kMaxDelta)
+        {
+            delta = kMaxDelta;
+            at = now + kMaxDelta;
+        }
+
+        int level = 0;
+        while (delta >= (1ull << ((level + 1) * kSlotBits)))
+            ++level;
+
+        uint32_t slot = static_cast<uint32_t>(at >> (level * kSlotBits)) & (kSlots - 1);
+        PushBack(m_slots[level][slot], idx);
+    }
+
+    // Move everything due at or before `to` onto the ready queue.
+    void Advance(uint64_t to)
+    {
+        while (now < to)
+        {
+            ++now;
+
+            // Cascade from the top down so entries can fall through several levels
+            for (int level = kLevels - 1; level >= 1; --level)
+            {
+                uint64_t lowerMask = (1ull << (level * kSlotBits)) - 1;
+                if ((now & lowerMask) != 0)
+                    continue;
+
+                uint32_t slot = static_cast<uint32_t>(now >> (level * kSlotBits)) & (kSlots - 1);
+                TaskList pending = m_slots[level][slot];
+                m_slots[level][slot] = TaskList{};
+                for (uint32_t idx = pending.head; idx != kNil; )
+                {
+                    uint32_t next = s_tasks[idx].next;
+                    s_tasks[idx].list = nullptr;
+                    Insert(idx);
+                    idx = next;
+                }
+            }
+
+            TaskList& due = m_slots[0][now & (kSlots - 1)];
+            for (uint32_t idx = PopFront(due); idx != kNil; idx = PopFront(due))
+                PushBack(s_ready, idx);
+        }
+    }
+
+    void Clear()
+    {
+        for (auto& level : m_slots)
+            for (auto& slot : level)
+                slot = TaskList{};
+    }
+
+private:
+    TaskList m_slots[kLevels][kSlots];
+};
+
+static TimingWheel s_frameWheel;
+static TimingWheel s_msWheel;
+static LONGLONG    s_qpcOrigin = 0;
+static LONGLONG    s_qpcFreq   = 0;
+
+static TimingWheel& WheelFor(Cadence unit)
+{
+    return unit == Cadence::Frames ? s_frameWheel : s_msWheel;
+}
+
+static LONGLONG Qpc()
+{
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    return now.QuadPart;
+}
+
+// Milliseconds since the first call; the ms wheel's "now" is on this clock.
+static uint64_t NowMs()
+{
+    if (s_qpcFreq == 0)
+    {
+        LARGE_INTEGER freq;
+        QueryPerformanceFrequency(&freq);
+        s_qpcFreq   = freq.QuadPart;
+        s_qpcOrigin = Qpc();
+    }
+    return static_cast<uint64_t>((Qpc() - s_qpcOrigin) * 1000 / s_qpcFreq);
+}
+
+// ---------------------------------------------------------------------------
+// Task pool
+// ---------------------------------------------------------------------------
+
+static TaskId MakeId(uint32_t idx)
+{
+    return (static_cast<uint32_t>(s_tasks[idx].generation) << 16) | (idx + 1);
+}
+
+// Resolve a handle to a live pool index, or kNil if stale.
+static uint32_t Lookup(TaskId id)
+{
+    uint32_t idx = (id & 0xFFFF) - 1;
+    if (id == 0 || idx >= s_tasks.size())
+        return kNil;
+    const Task& t = s_tasks[idx];
+    if (!t.live || t.generation != static_cast<uint16_t>(id >> 16))
+        return kNil;
+    return idx;
+}
+
+static void Release(uint32_t idx)
+{
+    Unlink(idx);
+    Task& t = s_tasks[idx];
+    t.fn = nullptr;
+    t.live = false;
+    t.running = false;
+    t.owner = nullptr;
+    ++t.generation;
+    PushBack(s_free, idx);
+}
+
+static TaskId Schedule(IMod* owner, Cadence unit, uint32_t delay, uint32_t interval, TaskFn fn)
+{
+    uint32_t idx = PopFront(s_free);
+    if (idx == kNil)
+    {
+        if (s_tasks.size() >= kMaxTasks)
+        {
+            LogFramework("Scheduler: task pool exhausted (%u tasks)", kMaxTasks);
+            return 0;
+        }
+        idx = static_cast<uint32_t>(s_tasks.size());
+        s_tasks.emplace_back();
+    }
+
+    Task& t = s_tasks[idx];
+    t.fn        = std::move(fn);
+    t.owner     = owner;
+    t.unit      = unit;
+    t.interval  = interval;
+    t.live      = true;
+    t.running   = false;
+    t.cancelled = false;
+    t.expiry    = WheelFor(unit).now + delay;
+    WheelFor(unit).Insert(idx);
+    return MakeId(idx);
+}
+
+// ---------------------------------------------------------------------------
+// Public API
+// ---------------------------------------------------------------------------
+
+TaskId Every(IMod* owner, Cadence unit, uint32_t interval, TaskFn fn)
+{
+    if (interval == 0)
+        interval = 1;
+    return Schedule(owner, unit, interval, interval, std::move(fn));
+}
+
+TaskId After(IMod* owner, Cadence unit, uint32_t delay, TaskFn fn)
+{
+    return Schedule(owner, unit, delay, 0, std::move(fn));
+}
+
+bool Cancel(TaskId id)
+{
+    uint32_t idx = Lookup(id);
+    if (idx == kNil)
+        return false;
+
+    if (s_tasks[idx].running)
+        s_tasks[idx].cancelled = true;  // Tick releases it after the callback returns
+    else
+        Release(idx);
+    return true;
+}
+
+void CancelAll(IMod* owner)
+{
+    for (uint32_t idx = 0; idx < s_tasks.size(); ++idx)
+    {
+        if (s_tasks[idx].live && s_tasks[idx].owner == owner)
+            Cancel(MakeId(idx));
+    }
+}
+
+void SetFrameBudget(uint32_t microseconds)
+{
+    s_budgetUs = microseconds;
+}
+
+void Tick()
+{
+    s_frameWheel.Advance(s_frameWheel.now + 1);
+    s_msWheel.Advance(NowMs());
+
+    if (s_ready.head == kNil)
+        return;
+
+    LONGLONG start = Qpc();
+    LONGLONG budget = static_cast<LONGLONG>(s_budgetUs) * s_qpcFreq / 1000000;
+
+    // Only run what was ready when we started, so tasks that reschedule with
+    // a zero delay can't spin this loop forever.
+    uint32_t remaining = 0;
+    for (uint32_t idx = s_ready.head; idx != kNil; idx = s_tasks[idx].next)
+        ++remaining;
+
+    do
+    {
+        uint32_t idx = PopFront(s_ready);
+        s_tasks[idx].running = true;
+
+        // The pool may grow while fn runs (tasks scheduling tasks), so hold
+        // the callable outside s_tasks. Moving never allocates; it goes back
+        // into the slot if the task repeats.
+        TaskFn fn = std::move(s_tasks[idx].fn);
+        fn();
+
+        Task& t = s_tasks[idx];
+        t.running = false;
+        if (t.cancelled || t.interval == 0)
+        {
+            Release(idx);
+        }
+        else
+        {
+            t.fn = std::move(fn);
+
+            // Keep the cadence anchored to the original schedule; if the task
+            // fell a whole interval behind (budget overflow), skip the missed
+            // runs rather than bursting to catch up.
+            TimingWheel& wheel = WheelFor(t.unit);
+            t.expiry += t.interval;
+            if (t.expiry <= wheel.now)
+                t.expiry = wheel.now + t.interval;
+            wheel.Insert(idx);
+        }
+    } while (--remaining > 0 && s_ready.head != kNil && Qpc() - start < budget);
+}
+
+void Shutdown()
+{
+    s_frameWheel.Clear();
+    s_msWheel.Clear();
+    s_ready = TaskList{};
+    s_free = TaskList{};
+    s_tasks.clear();
+    LogFramework("Scheduler: all tasks dropped");
+}
+
+} // namespace Scheduler
@@ -0,0 +1,64 @@
+/**
+ * @file scheduler.h
+ * @brief Frame-budgeted task scheduler — periodic and one-shot mod work on the game thread.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Tasks run from ProcessGameEvents_Detour after the OnPulse dispatch. Cadence is
+ * either a frame count or a millisecond interval; each unit has its own
+ * hierarchical timing wheel (4 levels x 64 slots), so scheduling and
+ * cancelling are O(1).
+ *
+ * Due tasks go to a FIFO ready queue that is drained until the per-frame budget
+ * is spent. Anything left over waits for the next frame instead of causing a
+ * hitch. At least one task runs per frame, so a single expensive task can't
+ * starve the queue.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+class IMod;
+
+namespace Scheduler
+{
+
+using TaskFn = std::function<void()>;
+
+// Opaque handle; 0 is never a valid task.
+using TaskId = uint32_t;
+
+enum class Cadence : uint8_t
+{
+    Frames,
+    Milliseconds,
+};
+
+// Run fn every `interval` frames/ms (minimum 1). The first run is one interval from now.
+// `owner` may be null; it lets CancelAll() drop a mod's tasks in one call.
+TaskId Every(IMod* owner, Cadence unit, uint32_t interval, TaskFn fn);
+
+// Run fn once after `delay` frames/ms. A delay of 0 runs it on the next Tick().
+// The full uint32_t range is honoured: a delay or interval past the wheel's
+// 2^24 - 1 tick span (about 4.6 hours in ms) is carried at the top level and
+// re-placed as the wheel turns, so it never fires early.
+TaskId After(IMod* owner, Cadence unit, uint32_t delay, TaskFn fn);
+
+// Cancel a pending or periodic task. Safe to call from inside the task itself.
+bool Cancel(TaskId id);
+void CancelAll(IMod* owner);
+
+// Per-frame time budget for running ready tasks (default 2000 us).
+void SetFrameBudget(uint32_t microseconds);
+
+// Advance both wheels and run due tasks within the budget. Called once per
+// frame by Core.
+void Tick();
+
+// Drop every task (called during Core::Shutdown).
+void Shutdown();
+
+} // namespace Scheduler
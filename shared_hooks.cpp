@@ -0,0 +1,105 @@
+/**
+ * @file shared_hooks.cpp
+ * @brief Detours for the shared hooks — each forwards to its HookMux::Hook.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "pch.h"
+#include "shared_hooks.h"
+#include "hooks.h"
+#include "offsets.h"
+
+namespace SharedHooks
+{
+
+// ---------------------------------------------------------------------------
+// Original function typedefs and pointers (thiscall via fastcall trick)
+// ---------------------------------------------------------------------------
+
+using CanUseItem_t = bool (__fastcall*)(void* thisPtr, void* edx, const void* pItem, bool bUseRequiredLvl, bool bOutput);
+static CanUseItem_t CanUseItem_Original = nullptr;
+
+using StatFunc_t = int (__fastcall*)(void* thisPtr, void* edx, bool bCapAtMax);
+static StatFunc_t MaxMana_Original      = nullptr;
+static StatFunc_t CurMana_Original      = nullptr;
+static StatFunc_t MaxEndurance_Original = nullptr;
+
+CanUseItemHook& CanUseItem()
+{
+    static CanUseItemHook s_hook("CanUseItem");
+    return s_hook;
+}
+
+StatHook& MaxMana()
+{
+    static StatHook s_hook("Max_Mana");
+    return s_hook;
+}
+
+StatHook& CurMana()
+{
+    static StatHook s_hook("Cur_Mana");
+    return s_hook;
+}
+
+StatHook& MaxEndurance()
+{
+    static StatHook s_hook("Max_Endurance");
+    return s_hook;
+}
+
+// ---------------------------------------------------------------------------
+// Detours
+// ---------------------------------------------------------------------------
+
+static bool __fastcall CanUseItem_Detour(void* thisPtr, void* edx, const void* pItem, bool bUseRequiredLvl, bool bOutput)
+{
+    return CanUseItem().Dispatch(CanUseItem_Original, thisPtr, edx, pItem, bUseRequiredLvl, bOutput);
+}
+
+static int __fastcall MaxMana_Detour(void* thisPtr, void* edx, bool bCapAtMax)
+{
+    return MaxMana().Dispatch(MaxMana_Original, thisPtr, edx, bCapAtMax);
+}
+
+static int __fastcall CurMana_Detour(void* thisPtr, void* edx, bool bCapAtMax)
+{
+    return CurMana().Dispatch(CurMana_Original, thisPtr, edx, bCapAtMax);
+}
+
+static int __fastcall MaxEndurance_Detour(void* thisPtr, void* edx, bool bCapAtMax)
+{
+    return MaxEndurance().Dispatch(MaxEndurance_Original, thisPtr, edx, bCapAtMax);
+}
+
+// ---------------------------------------------------------------------------
+// Installation
+// ---------------------------------------------------------------------------
+
+void Queue()
+{
+    CanUseItem_Original   = reinterpret_cast<CanUseItem_t>(Offsets::Get(Sig::CanUseItem));
+    MaxMana_Original      = reinterpret_cast<StatFunc_t>(Offsets::Get(Sig::MaxMana));
+    CurMana_Original      = reinterpret_cast<StatFunc_t>(Offsets::Get(Sig::CurMana));
+    MaxEndurance_Original = reinterpret_cast<StatFunc_t>(Offsets::Get(Sig::MaxEndurance));
+
+    Hooks::Queue("CanUseItem",
+        reinterpret_cast<void**>(&CanUseItem_Original),
+        reinterpret_cast<void*>(&CanUseItem_Detour));
+
+    Hooks::Queue("Max_Mana",
+        reinterpret_cast<void**>(&MaxMana_Original),
+        reinterpret_cast<void*>(&MaxMana_Detour));
+
+    Hooks::Queue("Cur_Mana",
+        reinterpret_cast<void**>(&CurMana_Original),
+        reinterpret_cast<void*>(&CurMana_Detour));
+
+    Hooks::Queue("Max_Endurance",
+        reinterpret_cast<void**>(&MaxEndurance_Original),
+        reinterpret_cast<void*>(&MaxEndurance_Detour));
+}
+
+} // namespace SharedHooks
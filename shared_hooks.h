@@ -0,0 +1,40 @@
+/**
+ * @file shared_hooks.h
+ * @brief Game functions more than one mod may want — hooked once by the framework,
+ *        shared through HookMux callbacks.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Mods attach from Initialize() (or later — attach/detach is safe at any time
+ * and never re-patches code):
+ *
+ *     SharedHooks::CanUseItem().Attach("SpellbookUnlock", 0, &CanUseItem_Pre, nullptr);
+ *
+ * Core queues the detours together with its own hooks, so they go live in the
+ * same batch. A detour with no callbacks attached just calls the original.
+ */
+
+#pragma once
+
+#include "hook_mux.h"
+
+namespace SharedHooks
+{
+
+// CharacterZoneClient::CanUseItem(const ItemPtr&, bool bUseRequiredLvl, bool bOutput)
+using CanUseItemHook = HookMux::Hook<bool, void* /*this*/, void* /*edx*/, const void* /*pItem*/, bool, bool>;
+
+// CharacterZoneClient::Max_Mana / Cur_Mana / Max_Endurance(bool bCapAtMax)
+using StatHook = HookMux::Hook<int, void* /*this*/, void* /*edx*/, bool>;
+
+CanUseItemHook& CanUseItem();
+StatHook&       MaxMana();
+StatHook&       CurMana();
+StatHook&       MaxEndurance();
+
+// Queue the shared detours with Hooks::Queue (Core, before Hooks::CommitBatch).
+// Needs Offsets::ResolveAll.
+void Queue();
+
+} // namespace SharedHooks
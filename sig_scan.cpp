@@ -0,0 +1,251 @@
+/**
+ * @file sig_scan.cpp
+ * @brief Implementation of the byte-pattern scanner — parsing, anchor selection, SIMD filters.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "sig_scan.h"
+#include "cpu_features.h"
+
+#include <emmintrin.h>
+
+#include <bit>
+#include <cstring>
+
+namespace SigScan
+{
+
+// ---------------------------------------------------------------------------
+// Parsing
+// ---------------------------------------------------------------------------
+
+// Bytes that dominate 32-bit MSVC code (mov/push/call opcodes, ModRM and
+// small displacements, padding), most common first. A byte not listed is
+// treated as rare and preferred as the filter anchor.
+static constexpr uint8_t kCommonBytes[] = {
+    0x00, 0xFF, 0x8B, 0xCC, 0x89, 0x45, 0xE8, 0x04, 0x08, 0x24, 0x83, 0x0F,
+    0x01, 0x4D, 0x55, 0x50, 0x85, 0xC3, 0x8D, 0x74, 0x75, 0x10, 0x0C, 0xC0,
+    0x5D, 0x90, 0x6A, 0x56, 0x57, 0x5E, 0x5F, 0x51, 0x53, 0x33, 0xEC, 0xC7,
+    0x44, 0x84, 0x02, 0x14, 0x18, 0x1C, 0x20, 0xF8, 0xFC, 0x46, 0x4E,
+};
+
+int ByteCommonness(uint8_t b)
+{
+    for (size_t i = 0; i < sizeof(kCommonBytes); ++i)
+    {
+        if (kCommonBytes[i] == b)
+            return static_cast<int>(sizeof(kCommonBytes) - i);
+    }
+    return 0;
+}
+
+static int HexDigit(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+bool Pattern::Parse(std::string_view ida)
+{
+    bytes.clear();
+    mask.clear();
+
+    size_t i = 0;
+    while (i < ida.size())
+    {
+        if (ida[i] == ' ' || ida[i] == '\t')
+        {
+            ++i;
+            continue;
+        }
+
+        size_t end = i;
+        while (end < ida.size() && ida[end] != ' ' && ida[end] != '\t')
+            ++end;
+        std::string_view tok = ida.substr(i, end - i);
+        i = end;
+
+        if (tok == "?" || tok == "??")
+        {
+            bytes.push_back(0);
+            mask.push_back(0x00);
+            continue;
+        }
+
+        int hi = tok.size() == 2 ? HexDigit(tok[0]) : -1;
+        int lo = tok.size() == 2 ? HexDigit(tok[1]) : -1;
+        if (hi < 0 || lo < 0)
+        {
+            bytes.clear();
+            mask.clear();
+            return false;
+        }
+        bytes.push_back(static_cast<uint8_t>((hi << 4) | lo));
+        mask.push_back(0xFF);
+    }
+
+    // Rarest literal as the primary anchor, last literal as the second
+    bool anyLiteral = false;
+    int best = 0;
+    for (size_t k = 0; k < bytes.size(); ++k)
+    {
+        if (!mask[k])
+            continue;
+        int score = ByteCommonness(bytes[k]);
+        if (!anyLiteral || score < best)
+        {
+            anchor = k;
+            best = score;
+        }
+        anchor2 = k;
+        anyLiteral = true;
+    }
+
+    if (!anyLiteral)
+    {
+        bytes.clear();
+        mask.clear();
+        return false;
+    }
+    return true;
+}
+
+bool Pattern::MatchAt(const uint8_t* p) const
+{
+    for (size_t k = 0; k < bytes.size(); ++k)
+    {
+        if ((p[k] & mask[k]) != bytes[k])
+            return false;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Scan kernels — call onHit(offset) for every match; stop when it returns false
+// ---------------------------------------------------------------------------
+
+// Positions in [i, last] with no SIMD left to help
+template <typename OnHit>
+static bool ScanScalar(const uint8_t* data, size_t i, size_t last, const Pattern& p, OnHit& onHit)
+{
+    const uint8_t a1 = p.bytes[p.anchor], a2 = p.bytes[p.anchor2];
+    for (; i <= last; ++i)
+    {
+        if (data[i + p.anchor] == a1 && data[i + p.anchor2] == a2 && p.MatchAt(data + i))
+        {
+            if (!onHit(i))
+                return false;
+        }
+    }
+    return true;
+}
+
+// Every load at i + anchor stays inside the buffer as long as i + 15 <= last,
+// since anchor <= Size() - 1.
+template <typename OnHit>
+static void ScanSse2(const uint8_t* data, size_t start, size_t last, const Pattern& p, OnHit& onHit)
+{
+    const __m128i v1 = _mm_set1_epi8(static_cast<char>(p.bytes[p.anchor]));
+    const __m128i v2 = _mm_set1_epi8(static_cast<char>(p.bytes[p.anchor2]));
+    const uint8_t* s1 = data + p.anchor;
+    const uint8_t* s2 = data + p.anchor2;
+
+    size_t i = start;
+    for (; i + 15 <= last; i += 16)
+    {
+        __m128i e1 = _mm_cmpeq_epi8(v1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(s1 + i)));
+        __m128i e2 = _mm_cmpeq_epi8(v2, _mm_loadu_si128(reinterpret_cast<const __m128i*>(s2 + i)));
+        uint32_t bits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(e1, e2)));
+        while (bits)
+        {
+            size_t at = i + static_cast<size_t>(std::countr_zero(bits));
+            bits &= bits - 1;
+            if (p.MatchAt(data + at) && !onHit(at))
+                return;
+        }
+    }
+    ScanScalar(data, i, last, p, onHit);
+}
+
+template <typename OnHit>
+CPU_TARGET_AVX2
+static void ScanAvx2(const uint8_t* data, size_t start, size_t last, const Pattern& p, OnHit& onHit)
+{
+    const __m256i v1 = _mm256_set1_epi8(static_cast<char>(p.bytes[p.anchor]));
+    const __m256i v2 = _mm256_set1_epi8(static_cast<char>(p.bytes[p.anchor2]));
+    const uint8_t* s1 = data + p.anchor;
+    const uint8_t* s2 = data + p.anchor2;
+
+    size_t i = start;
+    for (; i + 31 <= last; i += 32)
+    {
+        __m256i e1 = _mm256_cmpeq_epi8(v1, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s1 + i)));
+        __m256i e2 = _mm256_cmpeq_epi8(v2, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s2 + i)));
+        uint32_t bits = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(e1, e2)));
+        while (bits)
+        {
+            size_t at = i + static_cast<size_t>(std::countr_zero(bits));
+            bits &= bits - 1;
+            if (p.MatchAt(data + at) && !onHit(at))
+                return;
+        }
+    }
+    ScanScalar(data, i, last, p, onHit);
+}
+
+template <typename OnHit>
+static void Scan(std::span<const uint8_t> data, const Pattern& p, size_t start, OnHit onHit)
+{
+    if (p.Empty() || data.size() < p.Size())
+        return;
+    const size_t last = data.size() - p.Size();
+    if (start > last)
+        return;
+
+    if (UsingAvx2())
+        ScanAvx2(data.data(), start, last, p, onHit);
+    else
+        ScanSse2(data.data(), start, last, p, onHit);
+}
+
+// ---------------------------------------------------------------------------
+// Public API
+// ---------------------------------------------------------------------------
+
+size_t Find(std::span<const uint8_t> data, const Pattern& pattern, size_t start)
+{
+    size_t found = npos;
+    Scan(data, pattern, start, [&](size_t at) { found = at; return false; });
+    return found;
+}
+
+size_t FindAll(std::span<const uint8_t> data, const Pattern& pattern,
+    std::vector<size_t>& out, size_t maxHits)
+{
+    size_t added = 0;
+    if (maxHits == 0)
+        return 0;
+    Scan(data, pattern, 0, [&](size_t at) {
+        out.push_back(at);
+        return ++added < maxHits;
+    });
+    return added;
+}
+
+static bool s_forceSse2 = false;
+
+bool UsingAvx2()
+{
+    return !s_forceSse2 && CpuFeatures::HasAvx2();
+}
+
+void ForceSse2(bool force)
+{
+    s_forceSse2 = force;
+}
+
+} // namespace SigScan
@@ -0,0 +1,74 @@
+/**
+ * @file sig_scan.h
+ * @brief IDA-style byte-pattern scanner with SSE2/AVX2 candidate filtering.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Patterns are written the way IDA and most sig makers print them: hex bytes
+ * separated by spaces, with `?` or `??` for a wildcard byte:
+ *
+ *     SigScan::Pattern p;
+ *     p.Parse("55 8B EC 83 E4 ?? 8B 45 08 ?? ?? 00 00");
+ *     size_t at = SigScan::Find(text, p);
+ *
+ * Two literal bytes of the pattern (the rarest one, by a static x86 byte
+ * frequency table, and the last one) are compared 16 or 32 positions at a
+ * time. Only positions where both match are verified in full.
+ *
+ * Portable (no Windows headers, works on a plain byte span) so it can be
+ * built and exercised on a Linux host against a dumped executable.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace SigScan
+{
+
+constexpr size_t npos = static_cast<size_t>(-1);
+
+struct Pattern
+{
+    std::vector<uint8_t> bytes;   // wildcard positions hold 0
+    std::vector<uint8_t> mask;    // 0xFF = must match, 0x00 = wildcard
+
+    // Filter bytes chosen by Parse()
+    size_t anchor  = 0;
+    size_t anchor2 = 0;
+
+    // False (and the pattern left empty) on a malformed string or a pattern
+    // with no literal bytes.
+    bool Parse(std::string_view ida);
+
+    size_t Size() const { return bytes.size(); }
+    bool   Empty() const { return bytes.empty(); }
+
+    // Full comparison at `p` (which must have Size() readable bytes)
+    bool MatchAt(const uint8_t* p) const;
+};
+
+// Offset of the first match at or after `start`, or npos.
+size_t Find(std::span<const uint8_t> data, const Pattern& pattern, size_t start = 0);
+
+// Append the offsets of up to `maxHits` matches; returns how many were added.
+size_t FindAll(std::span<const uint8_t> data, const Pattern& pattern,
+    std::vector<size_t>& out, size_t maxHits = npos);
+
+// How common `b` is in 32-bit MSVC code: 0 for rare bytes, larger for more
+// common ones. Used to pick filter anchors.
+int ByteCommonness(uint8_t b);
+
+// True when the AVX2 filter is in use
+bool UsingAvx2();
+
+// Use the SSE2 filter even where AVX2 is available, so tests and benchmarks
+// can exercise both kernels on one machine.
+void ForceSse2(bool force);
+
+} // namespace SigScan
@@ -0,0 +1,131 @@
+/**
+ * @file signatures.h
+ * @brief Byte signatures for every eqgame.exe code address the framework and mods use.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * One entry per Sig, in enum order. Offsets::ResolveAll() scans `.text` for
+ * each pattern. A pattern must match exactly once. If it is missing, matches
+ * nothing, or matches more than once, the entry falls back to the client's
+ * fixed address (the eqlib `_x` offset, or the raw address in offsets.cpp).
+ *
+ * Patterns are IDA-style (see sig_scan.h). `offset` is added to the match
+ * position. For SigKind::Rel32 the 4 bytes found there are a rel32 operand
+ * (E8/E9 call/jmp) and the result is the branch target.
+ *
+ * Portable (no Windows or eqlib headers).
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+enum class Sig : uint32_t
+{
+    // Core
+    ProcessGameEvents,
+    HandleWorldMessage,
+    CreatePlayer,
+    PrepForDestroyPlayer,
+    GroundItemAdd,
+    GroundItemDelete,
+    GroundItemClear,
+    InterpretCmd,
+    CleanGameUI,
+    ReloadUI,
+    DspChat,
+
+    // SpellbookUnlock
+    IsSpellcaster,
+    IsSpellcaster2,
+    IsSpellcaster3,
+    GetSpellLevelNeeded,
+    CanStartMemming,
+    CanUseItem,
+
+    // StatsOverride
+    MaxMana,
+    CurMana,
+    MaxEndurance,
+    GetGaugeValueFromEQ,
+    GetLabelFromEQ,
+
+    // CombatAbilities — the JE that skips opening the window for non-melee classes
+    CombatAbilitiesClassCheck,
+
+    Count
+};
+
+enum class SigKind : uint8_t
+{
+    Direct,   // match + offset
+    Rel32,    // target of the rel32 operand at match + offset
+};
+
+struct SigDef
+{
+    const char* name;
+    const char* pattern;   // nullptr until a signature has been made for this client
+    int32_t     offset;
+    SigKind     kind;
+};
+
+// PARTIAL: no ROF2 pattern has been captured yet, so every entry below is
+// nullptr and each address is its fixed fallback. Until patterns land, the
+// scan, the offset cache and tools/offset_gen have nothing to do at runtime
+// (their logic is covered by tests/ on synthetic data only). Outstanding,
+// most urgent first, with the RVA each must resolve to (preferred base
+// 0x400000):
+//   HandleWorldMessage          0x0C3250
+//   IsSpellcaster / _2 / _3     0x043F50 / 0x0288E0 / 0x19FB90
+//   GetSpellLevelNeeded         eqlib EQ_Spell__GetSpellLevelNeeded_x
+//   CanStartMemming             0x35BD40
+//   Max_Mana / Cur_Mana         0x181E60 / 0x0442E0
+//   Max_Endurance               0x182020
+//   CombatAbilitiesClassCheck   0x25A087
+// then the eqlib-offset core hooks. To make an entry live, capture a pattern
+// from eqgame.exe that matches exactly once in .text, fill it in here, and
+// check with tools/offset_gen (exit code 1 if any pattern fails to match
+// exactly once) that the resolved RVA equals the fallback above.
+inline constexpr SigDef kSigDefs[] = {
+    { "ProcessGameEvents",         nullptr, 0, SigKind::Direct },
+    { "HandleWorldMessage",        nullptr, 0, SigKind::Direct },
+    { "CreatePlayer",              nullptr, 0, SigKind::Direct },
+    { "PrepForDestroyPlayer",      nullptr, 0, SigKind::Direct },
+    { "GroundItemAdd",             nullptr, 0, SigKind::Direct },
+    { "GroundItemDelete",          nullptr, 0, SigKind::Direct },
+    { "GroundItemClear",           nullptr, 0, SigKind::Direct },
+    { "InterpretCmd",              nullptr, 0, SigKind::Direct },
+    { "CleanGameUI",               nullptr, 0, SigKind::Direct },
+    { "ReloadUI",                  nullptr, 0, SigKind::Direct },
+    { "dsp_chat",                  nullptr, 0, SigKind::Direct },
+
+    { "IsSpellcaster",             nullptr, 0, SigKind::Direct },
+    { "IsSpellcaster_2",           nullptr, 0, SigKind::Direct },
+    { "IsSpellcaster_3",           nullptr, 0, SigKind::Direct },
+    { "GetSpellLevelNeeded",       nullptr, 0, SigKind::Direct },
+    { "CanStartMemming",           nullptr, 0, SigKind::Direct },
+    { "CanUseItem",                nullptr, 0, SigKind::Direct },
+
+    { "Max_Mana",                  nullptr, 0, SigKind::Direct },
+    { "Cur_Mana",                  nullptr, 0, SigKind::Direct },
+    { "Max_Endurance",             nullptr, 0, SigKind::Direct },
+    { "GetGaugeValueFromEQ",       nullptr, 0, SigKind::Direct },
+    { "GetLabelFromEQ",            nullptr, 0, SigKind::Direct },
+
+    { "CombatAbilitiesClassCheck", nullptr, 0, SigKind::Direct },
+};
+
+static_assert(sizeof(kSigDefs) / sizeof(kSigDefs[0]) == static_cast<size_t>(Sig::Count),
+    "kSigDefs must have one entry per Sig");
+
+// Entries that have a pattern; 0 means nothing can be resolved by scanning.
+constexpr size_t SigPatternCount()
+{
+    size_t count = 0;
+    for (const SigDef& def : kSigDefs)
+        count += def.pattern != nullptr;
+    return count;
+}
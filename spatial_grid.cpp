@@ -0,0 +1,106 @@
+/**
+ * @file spatial_grid.cpp
+ * @brief Implementation of the hashed uniform grid's insert/move/remove paths.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Built without the precompiled header so the file stays portable.
+ */
+
+#include "spatial_grid.h"
+
+SpatialGrid::SpatialGrid(float cellSize)
+    : m_cellSize(cellSize > 0.0f ? cellSize : 64.0f)
+    , m_invCellSize(1.0f / m_cellSize)
+{
+}
+
+void SpatialGrid::Insert(const void* key, float x, float y, float z)
+{
+    auto it = m_index.find(key);
+    if (it != m_index.end())
+    {
+        Place(it->second, x, y, z);
+        return;
+    }
+
+    uint32_t index = static_cast<uint32_t>(m_entries.size());
+    m_entries.push_back(Entry{ key, x, y, z, 0, 0 });
+    m_index.emplace(key, index);
+    Link(index, CellCoord(x), CellCoord(y));
+}
+
+void SpatialGrid::Remove(const void* key)
+{
+    auto it = m_index.find(key);
+    if (it == m_index.end())
+        return;
+
+    uint32_t index = it->second;
+    m_index.erase(it);
+    Unlink(index);
+
+    // Swap-remove from the dense entry array and patch the moved entry's
+    // references (its cell slot and the key index).
+    uint32_t last = static_cast<uint32_t>(m_entries.size() - 1);
+    if (index != last)
+    {
+        m_entries[index] = m_entries[last];
+        const Entry& moved = m_entries[index];
+        m_cells[moved.cell][moved.slot] = index;
+        m_index[moved.key] = index;
+    }
+    m_entries.pop_back();
+}
+
+void SpatialGrid::Clear()
+{
+    m_entries.clear();
+    m_index.clear();
+    m_cells.clear();
+    m_minCx = m_minCy = INT32_MAX;
+    m_maxCx = m_maxCy = INT32_MIN;
+}
+
+void SpatialGrid::Place(uint32_t index, float x, float y, float z)
+{
+    Entry& e = m_entries[index];
+    e.x = x;
+    e.y = y;
+    e.z = z;
+
+    int32_t cx = CellCoord(x), cy = CellCoord(y);
+    uint64_t cell = PackCell(cx, cy);
+    if (cell == e.cell)
+        return;
+
+    Unlink(index);
+    Link(index, cx, cy);
+}
+
+void SpatialGrid::Unlink(uint32_t index)
+{
+    const Entry& e = m_entries[index];
+    Cell& cell = m_cells[e.cell];
+    uint32_t tail = cell.back();
+    cell[e.slot] = tail;
+    m_entries[tail].slot = e.slot;
+    cell.pop_back();
+    // Empty cells are kept: entries tend to come back, and the vector's
+    // capacity saves a reallocation when they do.
+}
+
+void SpatialGrid::Link(uint32_t index, int32_t cx, int32_t cy)
+{
+    Entry& e = m_entries[index];
+    e.cell = PackCell(cx, cy);
+    Cell& cell = m_cells[e.cell];
+    e.slot = static_cast<uint32_t>(cell.size());
+    cell.push_back(index);
+
+    m_minCx = std::min(m_minCx, cx);
+    m_maxCx = std::max(m_maxCx, cx);
+    m_minCy = std::min(m_minCy, cy);
+    m_maxCy = std::max(m_maxCy, cy);
+}
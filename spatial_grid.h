@@ -0,0 +1,276 @@
+/**
+ * @file spatial_grid.h
+ * @brief Hashed uniform grid over (x, y, z) points — radius, box and k-nearest queries.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Bucketing is 2D on X/Y (EQ zones are wide and shallow); Z is checked per
+ * entry, so radius and box queries are true 3D tests. Only occupied cells
+ * exist, in a hash map keyed by packed cell coordinates, so zone size doesn't
+ * matter.
+ *
+ * Entries are opaque keys (e.g. PlayerClient*). Moving an entry within its cell
+ * just stores the new position. Crossing a cell boundary is an O(1)
+ * swap-remove plus append. Refresh() re-reads every position via a callback,
+ * which is how the spawn index keeps up with movement once per pulse.
+ *
+ * Portable — no Windows headers.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class SpatialGrid
+{
+public:
+    struct AcceptAll
+    {
+        bool operator()(const void*) const { return true; }
+    };
+
+    explicit SpatialGrid(float cellSize = 64.0f);
+
+    // Insert, or move if the key is already present
+    void Insert(const void* key, float x, float y, float z);
+    void Remove(const void* key);
+    void Clear();
+
+    size_t Size() const { return m_entries.size(); }
+    float  GetCellSize() const { return m_cellSize; }
+
+    // Re-read every entry's position: pos(key, x, y, z) fills the floats.
+    template <typename PosFn>
+    void Refresh(PosFn&& pos)
+    {
+        for (uint32_t i = 0; i < m_entries.size(); ++i)
+        {
+            Entry& e = m_entries[i];
+            float x, y, z;
+            pos(e.key, x, y, z);
+            Place(i, x, y, z);
+        }
+    }
+
+    // Every entry within `radius` (3D) of the point
+    template <typename Pred = AcceptAll>
+    void QueryRadius(float x, float y, float z, float radius,
+        std::vector<const void*>& out, Pred&& pred = Pred()) const
+    {
+        float r2 = radius * radius;
+        ForCellsInRect(x - radius, y - radius, x + radius, y + radius, [&](const Cell& cell)
+        {
+            for (uint32_t idx : cell)
+            {
+                const Entry& e = m_entries[idx];
+                if (DistSq(e, x, y, z) <= r2 && pred(e.key))
+                    out.push_back(e.key);
+            }
+        });
+    }
+
+    // Every entry inside the axis-aligned box (inclusive)
+    template <typename Pred = AcceptAll>
+    void QueryBox(float minX, float minY, float minZ, float maxX, float maxY, float maxZ,
+        std::vector<const void*>& out, Pred&& pred = Pred()) const
+    {
+        ForCellsInRect(minX, minY, maxX, maxY, [&](const Cell& cell)
+        {
+            for (uint32_t idx : cell)
+            {
+                const Entry& e = m_entries[idx];
+                if (e.x >= minX && e.x <= maxX && e.y >= minY && e.y <= maxY &&
+                    e.z >= minZ && e.z <= maxZ && pred(e.key))
+                {
+                    out.push_back(e.key);
+                }
+            }
+        });
+    }
+
+    // Up to k entries nearest the point (3D), closest first. Searches rings of
+    // cells outward from the first one that can be occupied, and stops once no
+    // unvisited cell can beat the k-th best.
+    // Once a ring's perimeter has more cells than are occupied (a sparse grid
+    // or a point far outside it), the remaining occupied cells are visited
+    // directly instead.
+    template <typename Pred = AcceptAll>
+    void Nearest(float x, float y, float z, size_t k,
+        std::vector<const void*>& out, Pred&& pred = Pred()) const
+    {
+        if (k == 0 || m_entries.empty())
+            return;
+
+        // Max-heap on distance, so the current k-th best is at the front
+        std::vector<std::pair<float, const void*>> best;
+        best.reserve(k + 1);
+
+        int32_t cx = CellCoord(x), cy = CellCoord(y);
+        int32_t maxRing = std::max({ cx - m_minCx, m_maxCx - cx, cy - m_minCy, m_maxCy - cy });
+
+        // Rings closer than the occupied bounds are empty; skip them so a
+        // point far outside the zone doesn't probe every ring on the way in
+        int32_t firstRing = std::max({ 0, m_minCx - cx, cx - m_maxCx, m_minCy - cy, cy - m_maxCy });
+
+        auto consider = [&](const Cell& cell)
+        {
+            for (uint32_t idx : cell)
+            {
+                const Entry& e = m_entries[idx];
+                float d2 = DistSq(e, x, y, z);
+                if (best.size() == k && d2 >= best.front().first)
+                    continue;
+                if (!pred(e.key))
+                    continue;
+
+                best.emplace_back(d2, e.key);
+                std::push_heap(best.begin(), best.end());
+                if (best.size() > k)
+                {
+                    std::pop_heap(best.begin(), best.end());
+                    best.pop_back();
+                }
+            }
+        };
+
+        for (int32_t ring = firstRing; ring <= maxRing; ++ring)
+        {
+            if (best.size() == k)
+            {
+                float reach = static_cast<float>(ring - 1) * m_cellSize;
+                if (reach > 0.0f && best.front().first <= reach * reach)
+                    break;
+            }
+
+            if (8 * static_cast<uint64_t>(ring) > m_cells.size())
+            {
+                // Every cell at Chebyshev distance >= ring, in one pass
+                for (const auto& [packed, cell] : m_cells)
+                {
+                    int64_t dx = static_cast<int64_t>(static_cast<int32_t>(static_cast<uint32_t>(packed >> 32))) - cx;
+                    int64_t dy = static_cast<int64_t>(static_cast<int32_t>(static_cast<uint32_t>(packed))) - cy;
+                    if (std::max(std::abs(dx), std::abs(dy)) >= ring)
+                        consider(cell);
+                }
+                break;
+            }
+
+            ForRing(cx, cy, ring, consider);
+        }
+
+        std::sort_heap(best.begin(), best.end());
+        for (const auto& b : best)
+            out.push_back(b.second);
+    }
+
+private:
+    using Cell = std::vector<uint32_t>;   // indices into m_entries
+
+    struct Entry
+    {
+        const void* key;
+        float       x, y, z;
+        uint64_t    cell;
+        uint32_t    slot;                 // position inside its cell vector
+    };
+
+    int32_t CellCoord(float v) const
+    {
+        return static_cast<int32_t>(std::floor(v * m_invCellSize));
+    }
+
+    static uint64_t PackCell(int32_t cx, int32_t cy)
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cy);
+    }
+
+    static float DistSq(const Entry& e, float x, float y, float z)
+    {
+        float dx = e.x - x, dy = e.y - y, dz = e.z - z;
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    const Cell* FindCell(int32_t cx, int32_t cy) const
+    {
+        auto it = m_cells.find(PackCell(cx, cy));
+        return (it == m_cells.end() || it->second.empty()) ? nullptr : &it->second;
+    }
+
+    template <typename Fn>
+    void ForCellsInRect(float minX, float minY, float maxX, float maxY, Fn&& fn) const
+    {
+        int32_t x0 = std::max(CellCoord(minX), m_minCx), x1 = std::min(CellCoord(maxX), m_maxCx);
+        int32_t y0 = std::max(CellCoord(minY), m_minCy), y1 = std::min(CellCoord(maxY), m_maxCy);
+        if (x0 > x1 || y0 > y1)
+            return;
+
+        // A huge rectangle over a sparse grid: visit occupied cells instead
+        uint64_t span = static_cast<uint64_t>(x1 - x0 + 1) * static_cast<uint64_t>(y1 - y0 + 1);
+        if (span > m_cells.size())
+        {
+            for (const auto& [packed, cell] : m_cells)
+            {
+                int32_t cx = static_cast<int32_t>(static_cast<uint32_t>(packed >> 32));
+                int32_t cy = static_cast<int32_t>(static_cast<uint32_t>(packed));
+                if (!cell.empty() && cx >= x0 && cx <= x1 && cy >= y0 && cy <= y1)
+                    fn(cell);
+            }
+            return;
+        }
+
+        for (int32_t cx = x0; cx <= x1; ++cx)
+        {
+            for (int32_t cy = y0; cy <= y1; ++cy)
+            {
+                if (const Cell* cell = FindCell(cx, cy))
+                    fn(*cell);
+            }
+        }
+    }
+
+    // Cells at Chebyshev distance exactly `ring` from (cx, cy)
+    template <typename Fn>
+    void ForRing(int32_t cx, int32_t cy, int32_t ring, Fn&& fn) const
+    {
+        if (ring == 0)
+        {
+            if (const Cell* cell = FindCell(cx, cy))
+                fn(*cell);
+            return;
+        }
+        for (int32_t dx = -ring; dx <= ring; ++dx)
+        {
+            if (const Cell* cell = FindCell(cx + dx, cy - ring)) fn(*cell);
+            if (const Cell* cell = FindCell(cx + dx, cy + ring)) fn(*cell);
+        }
+        for (int32_t dy = -ring + 1; dy <= ring - 1; ++dy)
+        {
+            if (const Cell* cell = FindCell(cx - ring, cy + dy)) fn(*cell);
+            if (const Cell* cell = FindCell(cx + ring, cy + dy)) fn(*cell);
+        }
+    }
+
+    void Place(uint32_t index, float x, float y, float z);
+    void Unlink(uint32_t index);
+    void Link(uint32_t index, int32_t cx, int32_t cy);
+
+    float m_cellSize;
+    float m_invCellSize;
+
+    std::vector<Entry>                          m_entries;
+    std::unordered_map<const void*, uint32_t>   m_index;   // key -> m_entries slot
+    std::unordered_map<uint64_t, Cell>          m_cells;
+
+    // Bounds of every cell ever occupied since the last Clear() (conservative;
+    // only used to stop ring searches and clip rectangles).
+    int32_t m_minCx = INT32_MAX, m_maxCx = INT32_MIN;
+    int32_t m_minCy = INT32_MAX, m_maxCy = INT32_MIN;
+};
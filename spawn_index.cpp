@@ -0,0 +1,335 @@
+/**
+ * @file spawn_index.cpp
+ * @brief Implementation of the spawn ID / name hash index.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "pch.h"
+#include "spawn_index.h"
+#include "game_state.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <vector>
+
+namespace SpawnIndex
+{
+
+using eqlib::PlayerClient;
+
+// ---------------------------------------------------------------------------
+// Open-addressing table
+//
+// Entry needs `uint32_t key` and `PlayerClient* spawn` (nullptr = empty slot).
+// Capacity is a power of two kept at <= 50% load.
+// ---------------------------------------------------------------------------
+template <typename Entry>
+class ProbeTable
+{
+public:
+    size_t count = 0;
+
+    template <typename Pred>
+    Entry* Find(uint32_t key, Pred&& pred)
+    {
+        if (m_slots.empty())
+            return nullptr;
+        for (size_t i = Home(key); m_slots[i].spawn; i = (i + 1) & m_mask)
+        {
+            if (m_slots[i].key == key && pred(m_slots[i]))
+                return &m_slots[i];
+        }
+        return nullptr;
+    }
+
+    void Insert(const Entry& entry)
+    {
+        if ((count + 1) * 2 > m_slots.size())
+            Grow();
+
+        size_t i = Home(entry.key);
+        while (m_slots[i].spawn)
+            i = (i + 1) & m_mask;
+        m_slots[i] = entry;
+        ++count;
+    }
+
+    // Backward-shift deletion: pull later members of the probe run into the
+    // hole so lookups never need tombstones.
+    void Erase(Entry* entry)
+    {
+        size_t hole = static_cast<size_t>(entry - m_slots.data());
+        for (size_t j = (hole + 1) & m_mask; m_slots[j].spawn; j = (j + 1) & m_mask)
+        {
+            size_t home = Home(m_slots[j].key);
+            // Move j into the hole unless its home lies cyclically in (hole, j]
+            bool homeBetween = (hole <= j) ? (hole < home && home <= j)
+                                           : (hole < home || home <= j);
+            if (!homeBetween)
+            {
+                m_slots[hole] = m_slots[j];
+                hole = j;
+            }
+        }
+        m_slots[hole] = Entry{};
+        --count;
+    }
+
+    template <typename Fn>
+    Entry* FindIf(Fn&& fn)
+    {
+        for (auto& slot : m_slots)
+        {
+            if (slot.spawn && fn(slot))
+                return &slot;
+        }
+        return nullptr;
+    }
+
+    // fn(Entry&) for every occupied slot. fn may modify the entry but not its key.
+    template <typename Fn>
+    void ForEach(Fn&& fn)
+    {
+        for (auto& slot : m_slots)
+        {
+            if (slot.spawn)
+                fn(slot);
+        }
+    }
+
+    void Clear()
+    {
+        std::fill(m_slots.begin(), m_slots.end(), Entry{});
+        count = 0;
+    }
+
+private:
+    // Spawn IDs are small and sequential, so mix before masking
+    size_t Home(uint32_t key) const
+    {
+        key ^= key >> 16;
+        key *= 0x7FEB352Du;
+        key ^= key >> 15;
+        return static_cast<size_t>(key) & m_mask;
+    }
+
+    void Grow()
+    {
+        std::vector<Entry> old;
+        old.swap(m_slots);
+        m_slots.assign(old.empty() ? 1024 : old.size() * 2, Entry{});
+        m_mask = m_slots.size() - 1;
+        count = 0;
+        for (const auto& e : old)
+        {
+            if (e.spawn)
+                Insert(e);
+        }
+    }
+
+    std::vector<Entry> m_slots;
+    size_t             m_mask = 0;
+};
+
+struct IdEntry
+{
+    uint32_t      key = 0;        // spawn ID
+    uint32_t      nameHash = 0;   // hash the name was indexed under
+    PlayerClient* spawn = nullptr;
+};
+
+struct NameEntry
+{
+    uint32_t      key = 0;        // name hash
+    PlayerClient* spawn = nullptr;
+};
+
+static ProbeTable<IdEntry>   s_byId;
+static ProbeTable<NameEntry> s_byName;
+static SpatialGrid           s_grid(64.0f);
+
+static void ReadPosition(const void* spawn, float& x, float& y, float& z)
+{
+    x = SpawnFields::Read<float>(spawn, SpawnFields::kX);
+    y = SpawnFields::Read<float>(spawn, SpawnFields::kY);
+    z = SpawnFields::Read<float>(spawn, SpawnFields::kZ);
+}
+
+// Case-insensitive FNV-1a, bounded by the game's name buffer size
+static uint32_t HashName(const char* name)
+{
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < SpawnFields::kNameLen && name[i]; ++i)
+    {
+        h ^= static_cast<uint8_t>(tolower(static_cast<unsigned char>(name[i])));
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static void EraseName(uint32_t hash, PlayerClient* spawn)
+{
+    if (NameEntry* e = s_byName.Find(hash, [spawn](const NameEntry& n) { return n.spawn == spawn; }))
+        s_byName.Erase(e);
+}
+
+static void EraseEntry(IdEntry* entry)
+{
+    EraseName(entry->nameHash, entry->spawn);
+    s_grid.Remove(entry->spawn);
+    s_byId.Erase(entry);
+}
+
+// ---------------------------------------------------------------------------
+// Public API
+// ---------------------------------------------------------------------------
+
+void Insert(PlayerClient* spawn)
+{
+    if (!spawn)
+        return;
+
+    uint32_t id = SpawnFields::Read<uint32_t>(spawn, SpawnFields::kSpawnID);
+
+    // A reused ID replaces whatever was indexed under it
+    if (IdEntry* existing = s_byId.Find(id, [](const IdEntry&) { return true; }))
+        EraseEntry(existing);
+
+    uint32_t nameHash = HashName(SpawnFields::Name(spawn));
+    s_byId.Insert(IdEntry{ id, nameHash, spawn });
+    s_byName.Insert(NameEntry{ nameHash, spawn });
+
+    float x, y, z;
+    ReadPosition(spawn, x, y, z);
+    s_grid.Insert(spawn, x, y, z);
+}
+
+void Remove(PlayerClient* spawn)
+{
+    if (!spawn)
+        return;
+
+    uint32_t id = SpawnFields::Read<uint32_t>(spawn, SpawnFields::kSpawnID);
+    IdEntry* entry = s_byId.Find(id, [spawn](const IdEntry& e) { return e.spawn == spawn; });
+    if (!entry)
+    {
+        // ID changed after indexing — rare enough for a full scan
+        entry = s_byId.FindIf([spawn](const IdEntry& e) { return e.spawn == spawn; });
+    }
+    if (entry)
+        EraseEntry(entry);
+}
+
+void Clear()
+{
+    s_byId.Clear();
+    s_byName.Clear();
+    s_grid.Clear();
+}
+
+void Rebuild()
+{
+    Clear();
+
+    PlayerClient* spawn = GameState::GetSpawnList();
+    while (spawn)
+    {
+        Insert(spawn);
+        spawn = SpawnFields::Read<PlayerClient*>(spawn, SpawnFields::kNext);
+    }
+}
+
+PlayerClient* FindById(uint32_t spawnId)
+{
+    IdEntry* e = s_byId.Find(spawnId, [](const IdEntry&) { return true; });
+    return e ? e->spawn : nullptr;
+}
+
+PlayerClient* FindByName(const char* name)
+{
+    if (!name || !*name)
+        return nullptr;
+
+    uint32_t hash = HashName(name);
+    NameEntry* e = s_byName.Find(hash, [name](const NameEntry& n)
+    {
+        return _strnicmp(SpawnFields::Name(n.spawn), name, SpawnFields::kNameLen) == 0;
+    });
+    return e ? e->spawn : nullptr;
+}
+
+size_t GetCount()
+{
+    return s_byId.count;
+}
+
+// ---------------------------------------------------------------------------
+// Spatial queries
+// ---------------------------------------------------------------------------
+
+void RefreshPositions()
+{
+    s_grid.Refresh(&ReadPosition);
+
+    // Move renamed spawns (e.g. to a corpse name) to their new name hash, so
+    // FindByName never has to fall back to walking the spawn list
+    s_byId.ForEach([](IdEntry& e)
+    {
+        uint32_t hash = HashName(SpawnFields::Name(e.spawn));
+        if (hash == e.nameHash)
+            return;
+        EraseName(e.nameHash, e.spawn);
+        s_byName.Insert(NameEntry{ hash, e.spawn });
+        e.nameHash = hash;
+    });
+}
+
+// Grid predicate for the optional spawn-type filter
+struct TypeFilter
+{
+    int type;
+    bool operator()(const void* spawn) const
+    {
+        return type < 0 || SpawnFields::Read<uint8_t>(spawn, SpawnFields::kType) == type;
+    }
+};
+
+static void AppendSpawns(const std::vector<const void*>& keys, std::vector<PlayerClient*>& out)
+{
+    for (const void* key : keys)
+        out.push_back(static_cast<PlayerClient*>(const_cast<void*>(key)));
+}
+
+void QueryRadius(float x, float y, float z, float radius,
+    std::vector<PlayerClient*>& out, int spawnType)
+{
+    std::vector<const void*> keys;
+    s_grid.QueryRadius(x, y, z, radius, keys, TypeFilter{ spawnType });
+    AppendSpawns(keys, out);
+}
+
+void QueryBox(float minX, float minY, float minZ, float maxX, float maxY, float maxZ,
+    std::vector<PlayerClient*>& out, int spawnType)
+{
+    std::vector<const void*> keys;
+    s_grid.QueryBox(minX, minY, minZ, maxX, maxY, maxZ, keys, TypeFilter{ spawnType });
+    AppendSpawns(keys, out);
+}
+
+void Nearest(float x, float y, float z, size_t count,
+    std::vector<PlayerClient*>& out, int spawnType)
+{
+    std::vector<const void*> keys;
+    s_grid.Nearest(x, y, z, count, keys, TypeFilter{ spawnType });
+    AppendSpawns(keys, out);
+}
+
+const SpatialGrid& GetGrid()
+{
+    return s_grid;
+}
+
+} // namespace SpawnIndex
@@ -0,0 +1,93 @@
+/**
+ * @file spawn_index.h
+ * @brief Framework-owned hash index over live spawns — O(1) lookup by spawn ID or name.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Maintained from CreatePlayer_Detour / PrepForDestroyPlayer_Detour, and rebuilt
+ * from the game's spawn list on every game-state transition. Both tables use
+ * open addressing with linear probing and backward-shift deletion (no
+ * tombstones), so lookups stay short however much a raid zone churns.
+ *
+ * Every indexed spawn is also in a SpatialGrid (64-unit cells) whose positions
+ * are refreshed once per pulse, for radius, box and nearest-N queries.
+ *
+ * Game thread only. Mods normally go through GameState::FindSpawnById /
+ * FindSpawnByName.
+ */
+
+#pragma once
+
+#include "spatial_grid.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace eqlib { class PlayerClient; }
+
+// ROF2 PlayerClient field offsets (eqlib PlayerClient.h, PlayerZoneClient).
+// The framework reads spawns through these rather than the full eqlib types.
+namespace SpawnFields
+{
+constexpr uintptr_t kPrev    = 0x004;   // TListNode<PlayerClient>::m_pPrev
+constexpr uintptr_t kNext    = 0x008;   // TListNode<PlayerClient>::m_pNext
+constexpr uintptr_t kY       = 0x064;   // float
+constexpr uintptr_t kX       = 0x068;   // float
+constexpr uintptr_t kZ       = 0x06C;   // float
+constexpr uintptr_t kName    = 0x0A4;   // char[0x40]
+constexpr uintptr_t kType    = 0x125;   // uint8_t (0 = PC, 1 = NPC, 2 = corpse)
+constexpr uintptr_t kSpawnID = 0x148;   // uint32_t
+constexpr uintptr_t kLevel   = 0x250;   // uint8_t
+constexpr size_t    kNameLen = 0x40;
+
+template <typename T>
+inline T Read(const void* spawn, uintptr_t offset)
+{
+    return *reinterpret_cast<const T*>(reinterpret_cast<uintptr_t>(spawn) + offset);
+}
+
+inline const char* Name(const void* spawn)
+{
+    return reinterpret_cast<const char*>(reinterpret_cast<uintptr_t>(spawn) + kName);
+}
+} // namespace SpawnFields
+
+namespace SpawnIndex
+{
+
+void Insert(eqlib::PlayerClient* spawn);
+void Remove(eqlib::PlayerClient* spawn);
+
+// Drop everything and re-index the game's current spawn list.
+void Rebuild();
+void Clear();
+
+eqlib::PlayerClient* FindById(uint32_t spawnId);
+
+// Case-insensitive, hash table only. Names are verified against the live
+// spawn; a rename (e.g. to a corpse name) is picked up by the next
+// RefreshPositions, and until then the spawn is found under neither name.
+eqlib::PlayerClient* FindByName(const char* name);
+
+size_t GetCount();
+
+// Re-read X/Y/Z of every indexed spawn into the grid and re-index any spawn
+// whose name changed. Called once per pulse.
+void RefreshPositions();
+
+// Spatial queries over positions as of the last refresh (or insert).
+// spawnType filters on SpawnFields::kType; -1 accepts everything. Results
+// are appended to `out`; Nearest returns closest first.
+void QueryRadius(float x, float y, float z, float radius,
+    std::vector<eqlib::PlayerClient*>& out, int spawnType = -1);
+void QueryBox(float minX, float minY, float minZ, float maxX, float maxY, float maxZ,
+    std::vector<eqlib::PlayerClient*>& out, int spawnType = -1);
+void Nearest(float x, float y, float z, size_t count,
+    std::vector<eqlib::PlayerClient*>& out, int spawnType = -1);
+
+// Underlying grid (keys are PlayerClient*), for queries with custom predicates.
+const SpatialGrid& GetGrid();
+
+} // namespace SpawnIndex
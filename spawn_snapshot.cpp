@@ -0,0 +1,361 @@
+/**
+ * @file spawn_snapshot.cpp
+ * @brief Implementation of the SoA spawn snapshot — build, double-buffering, SSE2/AVX2 filters.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "pch.h"
+#include "spawn_snapshot.h"
+#include "spawn_index.h"
+#include "game_state.h"
+#include "core.h"
+#include "cpu_features.h"
+
+#include <cstring>
+#include <new>
+
+size_t SpawnMask::Count() const
+{
+    size_t n = 0;
+    for (uint32_t w : words)
+        n += static_cast<size_t>(std::popcount(w));
+    return n;
+}
+
+namespace SpawnSnapshot
+{
+
+static constexpr size_t kAlign = 32;
+
+static Frame                s_frames[2];
+static std::atomic<Frame*>  s_current{ nullptr };
+static uint32_t             s_users = 0;
+static uint64_t             s_frameCounter = 0;
+static uint32_t             s_skipped = 0;
+
+bool UsingAvx2()
+{
+    return CpuFeatures::HasAvx2();
+}
+
+// ---------------------------------------------------------------------------
+// Frame storage — one aligned block per frame, carved into the column arrays
+// ---------------------------------------------------------------------------
+
+static void FreeFrame(Frame& f)
+{
+    if (f.x)
+        ::operator delete(static_cast<void*>(f.x), std::align_val_t(kAlign));
+    f.x = f.y = f.z = nullptr;
+    f.type = f.level = nullptr;
+    f.spawnId = nullptr;
+    f.spawn = nullptr;
+    f.capacity = 0;
+}
+
+// Grow to hold at least `rows`, keeping the first `keep` rows.
+static void Reserve(Frame& f, uint32_t rows, uint32_t keep)
+{
+    if (rows <= f.capacity)
+        return;
+
+    uint32_t cap = f.capacity ? f.capacity : 512;
+    while (cap < rows)
+        cap *= 2;
+
+    // Every column size is a multiple of 32 bytes because cap is a multiple of 32
+    size_t floats = sizeof(float) * cap;
+    size_t bytes  = cap;
+    size_t ids    = sizeof(uint32_t) * cap;
+    size_t ptrs   = sizeof(void*) * cap;
+    char* block = static_cast<char*>(::operator new(3 * floats + 2 * bytes + ids + ptrs, std::align_val_t(kAlign)));
+
+    Frame grown;
+    grown.capacity = cap;
+    grown.x       = reinterpret_cast<float*>(block);
+    grown.y       = reinterpret_cast<float*>(block + floats);
+    grown.z       = reinterpret_cast<float*>(block + 2 * floats);
+    grown.type    = reinterpret_cast<uint8_t*>(block + 3 * floats);
+    grown.level   = reinterpret_cast<uint8_t*>(block + 3 * floats + bytes);
+    grown.spawnId = reinterpret_cast<uint32_t*>(block + 3 * floats + 2 * bytes);
+    grown.spawn   = reinterpret_cast<eqlib::PlayerClient**>(block + 3 * floats + 2 * bytes + ids);
+
+    if (keep)
+    {
+        memcpy(grown.x, f.x, sizeof(float) * keep);
+        memcpy(grown.y, f.y, sizeof(float) * keep);
+        memcpy(grown.z, f.z, sizeof(float) * keep);
+        memcpy(grown.type, f.type, keep);
+        memcpy(grown.level, f.level, keep);
+        memcpy(grown.spawnId, f.spawnId, sizeof(uint32_t) * keep);
+        memcpy(grown.spawn, f.spawn, sizeof(void*) * keep);
+    }
+
+    FreeFrame(f);
+    f.capacity = grown.capacity;
+    f.x = grown.x;
+    f.y = grown.y;
+    f.z = grown.z;
+    f.type = grown.type;
+    f.level = grown.level;
+    f.spawnId = grown.spawnId;
+    f.spawn = grown.spawn;
+}
+
+void Frame::SelectAll(SpawnMask& mask) const
+{
+    size_t words = (count + 31) / 32;
+    mask.words.assign(words, 0xFFFFFFFFu);
+    if (count % 32)
+        mask.words.back() = (1u << (count % 32)) - 1;
+}
+
+// ---------------------------------------------------------------------------
+// Lifecycle
+// ---------------------------------------------------------------------------
+
+void Enable()
+{
+    if (s_users++ == 0)
+        LogFramework("SpawnSnapshot enabled (%s kernels)", UsingAvx2() ? "AVX2" : "SSE2");
+}
+
+void Disable()
+{
+    if (s_users > 0)
+        --s_users;
+}
+
+bool IsEnabled()
+{
+    return s_users > 0;
+}
+
+const Frame* Current()
+{
+    return s_users ? s_current.load(std::memory_order_acquire) : nullptr;
+}
+
+const Frame* Acquire()
+{
+    // Pin, then confirm the frame is still the published one. If Build()
+    // swapped in between, it may already be reusing what we pinned.
+    for (;;)
+    {
+        Frame* f = s_current.load(std::memory_order_seq_cst);
+        if (!f)
+            return nullptr;
+        f->readers.fetch_add(1, std::memory_order_seq_cst);
+        if (s_current.load(std::memory_order_seq_cst) == f)
+            return f;
+        f->readers.fetch_sub(1, std::memory_order_seq_cst);
+    }
+}
+
+void Release(const Frame* frame)
+{
+    if (frame)
+        const_cast<Frame*>(frame)->readers.fetch_sub(1, std::memory_order_release);
+}
+
+void Build()
+{
+    if (!s_users)
+        return;
+
+    Frame* cur  = s_current.load(std::memory_order_relaxed);
+    Frame* back = (cur == &s_frames[0]) ? &s_frames[1] : &s_frames[0];
+    if (back->readers.load(std::memory_order_seq_cst) != 0)
+    {
+        // A worker is still on the older frame; keep publishing the current one
+        if ((++s_skipped & 0xFF) == 1)
+            LogFramework("SpawnSnapshot: rebuild skipped, back buffer still pinned (%u so far)", s_skipped);
+        return;
+    }
+
+    Reserve(*back, 512, 0);
+    uint32_t n = 0;
+    for (eqlib::PlayerClient* spawn = GameState::GetSpawnList(); spawn;
+         spawn = SpawnFields::Read<eqlib::PlayerClient*>(spawn, SpawnFields::kNext))
+    {
+        if (n == back->capacity)
+            Reserve(*back, n + 1, n);
+
+        back->x[n]       = SpawnFields::Read<float>(spawn, SpawnFields::kX);
+        back->y[n]       = SpawnFields::Read<float>(spawn, SpawnFields::kY);
+        back->z[n]       = SpawnFields::Read<float>(spawn, SpawnFields::kZ);
+        back->type[n]    = SpawnFields::Read<uint8_t>(spawn, SpawnFields::kType);
+        back->level[n]   = SpawnFields::Read<uint8_t>(spawn, SpawnFields::kLevel);
+        back->spawnId[n] = SpawnFields::Read<uint32_t>(spawn, SpawnFields::kSpawnID);
+        back->spawn[n]   = spawn;
+        ++n;
+    }
+
+    // Zero the padding up to the next block so kernels read defined values
+    uint32_t padded = (n + kRowBlock - 1) / kRowBlock * kRowBlock;
+    if (padded > back->capacity)
+        Reserve(*back, padded, n);
+    for (uint32_t i = n; i < padded; ++i)
+    {
+        back->x[i] = back->y[i] = back->z[i] = 0.0f;
+        back->type[i] = back->level[i] = 0;
+        back->spawnId[i] = 0;
+        back->spawn[i] = nullptr;
+    }
+
+    back->count = n;
+    back->frameNumber = ++s_frameCounter;
+    s_current.store(back, std::memory_order_seq_cst);
+}
+
+void Shutdown()
+{
+    s_current.store(nullptr, std::memory_order_seq_cst);
+    s_users = 0;
+    FreeFrame(s_frames[0]);
+    FreeFrame(s_frames[1]);
+}
+
+// ---------------------------------------------------------------------------
+// Kernels — each produces 32 result bits per mask word and ANDs them in.
+// Words that are already zero are skipped.
+// ---------------------------------------------------------------------------
+
+static void DistanceSse2(const Frame& f, float x, float y, float z, float r2, SpawnMask& mask)
+{
+    const __m128 qx = _mm_set1_ps(x), qy = _mm_set1_ps(y), qz = _mm_set1_ps(z), lim = _mm_set1_ps(r2);
+    for (size_t w = 0; w < mask.words.size(); ++w)
+    {
+        if (!mask.words[w])
+            continue;
+        uint32_t bits = 0;
+        for (int i = 0; i < 8; ++i)
+        {
+            size_t row = w * 32 + i * 4;
+            __m128 dx = _mm_sub_ps(_mm_load_ps(f.x + row), qx);
+            __m128 dy = _mm_sub_ps(_mm_load_ps(f.y + row), qy);
+            __m128 dz = _mm_sub_ps(_mm_load_ps(f.z + row), qz);
+            __m128 d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+            bits |= static_cast<uint32_t>(_mm_movemask_ps(_mm_cmple_ps(d2, lim))) << (i * 4);
+        }
+        mask.words[w] &= bits;
+    }
+}
+
+CPU_TARGET_AVX2
+static void DistanceAvx2(const Frame& f, float x, float y, float z, float r2, SpawnMask& mask)
+{
+    const __m256 qx = _mm256_set1_ps(x), qy = _mm256_set1_ps(y), qz = _mm256_set1_ps(z), lim = _mm256_set1_ps(r2);
+    for (size_t w = 0; w < mask.words.size(); ++w)
+    {
+        if (!mask.words[w])
+            continue;
+        uint32_t bits = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            size_t row = w * 32 + i * 8;
+            __m256 dx = _mm256_sub_ps(_mm256_load_ps(f.x + row), qx);
+            __m256 dy = _mm256_sub_ps(_mm256_load_ps(f.y + row), qy);
+            __m256 dz = _mm256_sub_ps(_mm256_load_ps(f.z + row), qz);
+            // Plain mul/add, not FMA: FMA is a separate CPUID feature, and this
+            // keeps results bit-identical to the SSE2 path at the boundary
+            __m256 d2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)),
+                                      _mm256_mul_ps(dz, dz));
+            bits |= static_cast<uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(d2, lim, _CMP_LE_OQ))) << (i * 8);
+        }
+        mask.words[w] &= bits;
+    }
+}
+
+// Unsigned byte range test: v in [lo, hi] <=> max(v, lo) == v && min(v, hi) == v
+static void LevelSse2(const Frame& f, uint8_t lo, uint8_t hi, SpawnMask& mask)
+{
+    const __m128i vlo = _mm_set1_epi8(static_cast<char>(lo)), vhi = _mm_set1_epi8(static_cast<char>(hi));
+    for (size_t w = 0; w < mask.words.size(); ++w)
+    {
+        if (!mask.words[w])
+            continue;
+        uint32_t bits = 0;
+        for (int i = 0; i < 2; ++i)
+        {
+            __m128i v = _mm_load_si128(reinterpret_cast<const __m128i*>(f.level + w * 32 + i * 16));
+            __m128i in = _mm_and_si128(_mm_cmpeq_epi8(_mm_max_epu8(v, vlo), v),
+                                       _mm_cmpeq_epi8(_mm_min_epu8(v, vhi), v));
+            bits |= static_cast<uint32_t>(_mm_movemask_epi8(in)) << (i * 16);
+        }
+        mask.words[w] &= bits;
+    }
+}
+
+CPU_TARGET_AVX2
+static void LevelAvx2(const Frame& f, uint8_t lo, uint8_t hi, SpawnMask& mask)
+{
+    const __m256i vlo = _mm256_set1_epi8(static_cast<char>(lo)), vhi = _mm256_set1_epi8(static_cast<char>(hi));
+    for (size_t w = 0; w < mask.words.size(); ++w)
+    {
+        if (!mask.words[w])
+            continue;
+        __m256i v = _mm256_load_si256(reinterpret_cast<const __m256i*>(f.level + w * 32));
+        __m256i in = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_max_epu8(v, vlo), v),
+                                      _mm256_cmpeq_epi8(_mm256_min_epu8(v, vhi), v));
+        mask.words[w] &= static_cast<uint32_t>(_mm256_movemask_epi8(in));
+    }
+}
+
+static void TypeSse2(const Frame& f, uint8_t type, SpawnMask& mask)
+{
+    const __m128i want = _mm_set1_epi8(static_cast<char>(type));
+    for (size_t w = 0; w < mask.words.size(); ++w)
+    {
+        if (!mask.words[w])
+            continue;
+        uint32_t bits = 0;
+        for (int i = 0; i < 2; ++i)
+        {
+            __m128i v = _mm_load_si128(reinterpret_cast<const __m128i*>(f.type + w * 32 + i * 16));
+            bits |= static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, want))) << (i * 16);
+        }
+        mask.words[w] &= bits;
+    }
+}
+
+CPU_TARGET_AVX2
+static void TypeAvx2(const Frame& f, uint8_t type, SpawnMask& mask)
+{
+    const __m256i want = _mm256_set1_epi8(static_cast<char>(type));
+    for (size_t w = 0; w < mask.words.size(); ++w)
+    {
+        if (!mask.words[w])
+            continue;
+        __m256i v = _mm256_load_si256(reinterpret_cast<const __m256i*>(f.type + w * 32));
+        mask.words[w] &= static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, want)));
+    }
+}
+
+void FilterDistance(const Frame& frame, float x, float y, float z, float radius, SpawnMask& mask)
+{
+    if (UsingAvx2())
+        DistanceAvx2(frame, x, y, z, radius * radius, mask);
+    else
+        DistanceSse2(frame, x, y, z, radius * radius, mask);
+}
+
+void FilterLevel(const Frame& frame, uint8_t minLevel, uint8_t maxLevel, SpawnMask& mask)
+{
+    if (UsingAvx2())
+        LevelAvx2(frame, minLevel, maxLevel, mask);
+    else
+        LevelSse2(frame, minLevel, maxLevel, mask);
+}
+
+void FilterType(const Frame& frame, uint8_t spawnType, SpawnMask& mask)
+{
+    if (UsingAvx2())
+        TypeAvx2(frame, spawnType, mask);
+    else
+        TypeSse2(frame, spawnType, mask);
+}
+
+} // namespace SpawnSnapshot
@@ -0,0 +1,115 @@
+/**
+ * @file spawn_snapshot.h
+ * @brief Per-frame structure-of-arrays copy of hot spawn fields, with SIMD filters.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * While at least one user has called Enable(), Core walks the spawn list once
+ * per pulse. It copies position, type, level and ID into contiguous 32-byte
+ * aligned arrays. Filters then run as SSE2 (or AVX2, picked at runtime) kernels
+ * over those arrays instead of chasing PlayerClient pointers.
+ *
+ * Filters AND into a SpawnMask (one bit per row), so they compose:
+ *
+ *     const auto* snap = SpawnSnapshot::Current();
+ *     SpawnMask mask;
+ *     snap->SelectAll(mask);
+ *     SpawnSnapshot::FilterType(*snap, 1, mask);               // NPCs
+ *     SpawnSnapshot::FilterDistance(*snap, x, y, z, 100.0f, mask);
+ *     mask.ForEach([&](uint32_t row) { use(snap->spawn[row]); });
+ *
+ * Two frames are double-buffered. The game thread reads Current() freely. A
+ * worker thread must Acquire() / Release() a frame, and the frame it holds is
+ * never overwritten. If a worker still holds the back buffer, that pulse's
+ * rebuild is skipped and Current() stays on the previous frame.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace eqlib { class PlayerClient; }
+
+// One bit per snapshot row
+class SpawnMask
+{
+public:
+    std::vector<uint32_t> words;
+
+    template <typename Fn>
+    void ForEach(Fn&& fn) const
+    {
+        for (size_t w = 0; w < words.size(); ++w)
+        {
+            uint32_t bits = words[w];
+            while (bits)
+            {
+                fn(static_cast<uint32_t>(w * 32 + std::countr_zero(bits)));
+                bits &= bits - 1;
+            }
+        }
+    }
+
+    size_t Count() const;
+};
+
+namespace SpawnSnapshot
+{
+
+// Rows are padded to a multiple of kRowBlock with entries no filter accepts.
+constexpr uint32_t kRowBlock = 32;
+
+struct Frame
+{
+    uint64_t frameNumber = 0;
+    uint32_t count = 0;           // live rows
+    uint32_t capacity = 0;        // padded rows (multiple of kRowBlock)
+
+    // 32-byte aligned, `capacity` elements each
+    float*                x = nullptr;
+    float*                y = nullptr;
+    float*                z = nullptr;
+    uint8_t*              type = nullptr;
+    uint8_t*              level = nullptr;
+    uint32_t*             spawnId = nullptr;
+    eqlib::PlayerClient** spawn = nullptr;   // identity only off the game thread
+
+    std::atomic<uint32_t> readers{ 0 };
+
+    // Set one bit per live row
+    void SelectAll(SpawnMask& mask) const;
+};
+
+// Reference-counted opt-in; Core only builds while the count is non-zero.
+void Enable();
+void Disable();
+bool IsEnabled();
+
+// Game thread: the latest frame, or nullptr if disabled / not built yet.
+const Frame* Current();
+
+// Any thread: pin the latest frame so it isn't rebuilt while in use.
+const Frame* Acquire();
+void Release(const Frame* frame);
+
+// Called by Core once per pulse.
+void Build();
+
+// Free both buffers (Core::Shutdown).
+void Shutdown();
+
+// True when the AVX2 kernels are in use (decided once, on first Build()).
+bool UsingAvx2();
+
+// Filters — each ANDs its result into `mask` (which must come from SelectAll
+// or a previous filter on the same frame).
+void FilterDistance(const Frame& frame, float x, float y, float z, float radius, SpawnMask& mask);
+void FilterLevel(const Frame& frame, uint8_t minLevel, uint8_t maxLevel, SpawnMask& mask);
+void FilterType(const Frame& frame, uint8_t spawnType, SpawnMask& mask);
+
+} // namespace SpawnSnapshot
@@ -0,0 +1,75 @@
+/**
+ * @file bench.h
+ * @brief Wall-clock micro-benchmark helper for the portable sources.
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Bench::Run() repeats a body until it has run for at least the target time,
+ * keeps the best of a few such rounds, and prints ns per iteration (plus
+ * MB/s if bytes per iteration are given). Numbers are only comparable on one
+ * machine and build; use them to compare approaches, not as absolutes.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+namespace Bench
+{
+
+// Keep a computed value alive without the optimizer seeing through it
+template <typename T>
+inline void DoNotOptimize(const T& value)
+{
+#if defined(__GNUC__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* s_sink;
+    s_sink = &value;
+#endif
+}
+
+struct Result
+{
+    double   nsPerIter;
+    uint64_t iterations;
+};
+
+template <typename Fn>
+Result Run(const char* name, Fn&& body, double bytesPerIter = 0.0, double minSeconds = 0.2)
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr int kRounds = 3;
+
+    Result best = { 0.0, 0 };
+    for (int round = 0; round < kRounds; ++round)
+    {
+        uint64_t iters = 0;
+        uint64_t batch = 1;
+        const Clock::time_point start = Clock::now();
+        double elapsed = 0.0;
+        while (elapsed < minSeconds)
+        {
+            for (uint64_t i = 0; i < batch; ++i)
+                body();
+            iters += batch;
+            batch *= 2;
+            elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        }
+        const double ns = elapsed * 1e9 / static_cast<double>(iters);
+        if (round == 0 || ns < best.nsPerIter)
+            best = { ns, iters };
+    }
+
+    if (bytesPerIter > 0.0)
+        std::printf("  %-44s %12.1f ns/iter %10.1f MB/s\n", name, best.nsPerIter,
+            bytesPerIter * 1e3 / best.nsPerIter);
+    else
+        std::printf("  %-44s %12.1f ns/iter\n", name, best.nsPerIter);
+    return best;
+}
+
+} // namespace Bench
@@ -0,0 +1,64 @@
+/**
+ * @file hook_prologues.h
+ * @brief First bytes of every function the framework hooks in eqgame.exe (ROF2), keyed by hook name.
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * x86_decode_test relocates each entry that has bytes the way the hook
+ * engine would, so a decoder gap on a real target fails on Linux instead of
+ * at Hooks::Commit in the game.
+ *
+ * NOT CAPTURED YET: no eqgame.exe was available when this table was made,
+ * so every entry is empty and the test only covers the synthetic prologue
+ * shapes in x86_decode_test.cpp. To fill an entry, copy at least
+ * kMaxStolen + 15 bytes (34) from the hook's fixed address (the `_x` offset
+ * in eqlib or offsets.cpp, minus 0x400000 for the file RVA) of an
+ * unpatched client.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+struct HookPrologue
+{
+    const char*          hook;    // name passed to Hooks::Queue
+    std::vector<uint8_t> bytes;   // empty until captured
+};
+
+inline const std::vector<HookPrologue>& HookPrologues()
+{
+    static const std::vector<HookPrologue> s_prologues = {
+        // core.cpp
+        { "ProcessGameEvents",    {} },
+        { "HandleWorldMessage",   {} },
+        { "CreatePlayer",         {} },
+        { "PrepForDestroyPlayer", {} },
+        { "GroundItemAdd",        {} },
+        { "GroundItemDelete",     {} },
+        { "GroundItemClear",      {} },
+        { "InterpretCmd",         {} },
+        { "CleanGameUI",          {} },
+        { "ReloadUI",             {} },
+
+        // shared_hooks.cpp
+        { "CanUseItem",           {} },
+        { "Max_Mana",             {} },
+        { "Cur_Mana",             {} },
+        { "Max_Endurance",        {} },
+
+        // mods/spellbook_unlock.cpp
+        { "IsSpellcaster",        {} },
+        { "IsSpellcaster_2",      {} },
+        { "IsSpellcaster_3",      {} },
+        { "GetSpellLevelNeeded",  {} },
+        { "CanStartMemming",      {} },
+
+        // mods/stats_override.cpp
+        { "GetGaugeValueFromEQ",  {} },
+        { "GetLabelFromEQ",       {} },
+    };
+    return s_prologues;
+}
@@ -0,0 +1,124 @@
+/**
+ * @file mod_dispatch_bench.cpp
+ * @brief Benchmark of per-event subscriber dispatch against broadcasting to every mod, 1 to 256 mods.
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * "Broadcast" is the loop the detours used before subscriptions: a virtual
+ * call on every registered mod, landing in IMod's empty default when the mod
+ * doesn't handle the event. "Subscribed" is ModDispatch::Each over the
+ * HandlerTable that Core builds from GetEventMask(). The mods are spread over
+ * four classes so the calls stay genuinely virtual. In each set:
+ * - every mod handles OnPulse
+ * - one in eight handles OnAddSpawn
+ * - none handles OnReloadUI
+ */
+
+#include "bench.h"
+#include "mod_dispatch.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+// Shared sink so handler bodies have an effect the optimizer must keep
+uint64_t g_sink = 0;
+
+// Every mod handles OnPulse and OnIncomingMessage; the other hooks keep
+// IMod's empty defaults unless a subclass overrides them
+class BenchMod : public IMod
+{
+public:
+    const char* GetName() const override { return "bench"; }
+    bool Initialize() override { return true; }
+    void Shutdown() override {}
+    void OnPulse() override { ++g_sink; }
+    bool OnIncomingMessage(uint32_t opcode, const void*, uint32_t) override { g_sink += opcode; return true; }
+    uint32_t GetEventMask() const override { return EventBit(ModEvent::Pulse) | EventBit(ModEvent::IncomingMessage); }
+};
+
+class PulseModA : public BenchMod
+{
+public:
+    void OnPulse() override { g_sink += 2; }
+};
+
+class PulseModB : public BenchMod
+{
+public:
+    void OnPulse() override { g_sink += 3; }
+};
+
+class SpawnMod : public BenchMod
+{
+public:
+    void OnAddSpawn(void* spawn) override { g_sink += reinterpret_cast<uintptr_t>(spawn) & 1; }
+    uint32_t GetEventMask() const override { return BenchMod::GetEventMask() | EventBit(ModEvent::AddSpawn); }
+};
+
+} // namespace
+
+int main()
+{
+    std::printf("mod_dispatch: ns per event, broadcast to every mod vs subscribed handlers only\n");
+
+    for (size_t count : { size_t(1), size_t(2), size_t(4), size_t(8), size_t(16), size_t(32),
+                          size_t(64), size_t(128), size_t(256) })
+    {
+        std::vector<std::unique_ptr<IMod>> mods;
+        ModDispatch::HandlerTable handlers;
+        for (size_t i = 0; i < count; ++i)
+        {
+            std::unique_ptr<IMod> mod;
+            switch (i % 8)
+            {
+            case 0:  mod = std::make_unique<SpawnMod>(); break;
+            case 1:
+            case 4:  mod = std::make_unique<PulseModA>(); break;
+            case 2:
+            case 6:  mod = std::make_unique<PulseModB>(); break;
+            default: mod = std::make_unique<BenchMod>(); break;
+            }
+            handlers.Add({ mod.get(), static_cast<uint32_t>(i) }, mod->GetEventMask());
+            mods.push_back(std::move(mod));
+        }
+
+        std::printf(" %zu mod%s (%zu handle AddSpawn)\n", count, count == 1 ? "" : "s",
+            handlers.Get(ModEvent::AddSpawn).size());
+        void* spawn = &g_sink;
+
+        Bench::Run("OnPulse, broadcast", [&]() {
+            for (auto& mod : mods)
+                mod->OnPulse();
+        });
+        Bench::Run("OnPulse, subscribed (all)", [&]() {
+            ModDispatch::Each(handlers.Get(ModEvent::Pulse), [](IMod* mod) { mod->OnPulse(); });
+        });
+        Bench::Run("OnAddSpawn, broadcast", [&]() {
+            for (auto& mod : mods)
+                mod->OnAddSpawn(spawn);
+        });
+        Bench::Run("OnAddSpawn, subscribed (1 in 8)", [&]() {
+            ModDispatch::Each(handlers.Get(ModEvent::AddSpawn), [&](IMod* mod) { mod->OnAddSpawn(spawn); });
+        });
+        Bench::Run("OnReloadUI, broadcast", [&]() {
+            for (auto& mod : mods)
+                mod->OnReloadUI();
+        });
+        Bench::Run("OnReloadUI, subscribed (none)", [&]() {
+            ModDispatch::Each(handlers.Get(ModEvent::ReloadUI), [](IMod* mod) { mod->OnReloadUI(); });
+        });
+        Bench::Run("OnIncomingMessage, subscribed, can stop", [&]() {
+            Bench::DoNotOptimize(ModDispatch::Each(handlers.Get(ModEvent::IncomingMessage),
+                [](IMod* mod) { return mod->OnIncomingMessage(0x4A, nullptr, 0); }));
+        });
+    }
+
+    Bench::DoNotOptimize(g_sink);
+    return 0;
+}
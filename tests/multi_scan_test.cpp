@@ -0,0 +1,211 @@
+/**
+ * @file multi_scan_test.cpp
+ * @brief Tests that the one-pass multi-pattern scanner finds exactly what per-pattern scans find.
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "test.h"
+#include "multi_scan.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+SigScan::Pattern Parse(const char* ida)
+{
+    SigScan::Pattern p;
+    p.Parse(ida);
+    return p;
+}
+
+// Reference result: SigScan::FindAll once per pattern
+std::vector<std::vector<size_t>> PerPattern(const std::vector<SigScan::Pattern>& patterns,
+    const std::vector<uint8_t>& data)
+{
+    std::vector<std::vector<size_t>> hits(patterns.size());
+    for (size_t k = 0; k < patterns.size(); ++k)
+        SigScan::FindAll(data, patterns[k], hits[k]);
+    return hits;
+}
+
+std::vector<std::vector<size_t>> Multi(const std::vector<SigScan::Pattern>& patterns,
+    const std::vector<uint8_t>& data, unsigned threads, size_t maxHits = SigScan::npos)
+{
+    SigScan::MultiScanner scanner;
+    for (const auto& p : patterns)
+        scanner.Add(p);
+    scanner.Build();
+    std::vector<std::vector<size_t>> hits;
+    scanner.Scan(data, hits, maxHits, threads);
+    return hits;
+}
+
+// x86-flavoured filler: common opcode and ModRM bytes, some noise
+std::vector<uint8_t> Filler(size_t size, uint32_t seed)
+{
+    const uint8_t common[] = { 0x00, 0xFF, 0x8B, 0x45, 0x89, 0xE8, 0xCC, 0x55, 0xEC, 0x83, 0x74, 0x0F };
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> data(size);
+    for (auto& b : data)
+        b = (rng() % 4) ? common[rng() % sizeof(common)] : static_cast<uint8_t>(rng());
+    return data;
+}
+
+void Plant(std::vector<uint8_t>& data, size_t at, const SigScan::Pattern& p)
+{
+    for (size_t k = 0; k < p.Size(); ++k)
+    {
+        if (p.mask[k])
+            data[at + k] = p.bytes[k];
+    }
+}
+
+} // namespace
+
+TEST(OverlappingKeys)
+{
+    // Keys that are suffixes/prefixes of each other exercise the suffix links;
+    // the empty pattern keeps its index but never matches
+    const std::vector<SigScan::Pattern> patterns = {
+        Parse("E8 11 22 33 44"),
+        Parse("11 22 33 44"),
+        Parse("22 33 44 ?? 90"),
+        SigScan::Pattern(),
+        Parse("?? ?? E8 11 22"),                 // key at offset 2: never before position 0
+        Parse("55 8B EC 83 EC ?? 56 57"),        // common-byte prologue, key trimmed
+        Parse("E8 11 22 33 44"),                 // duplicate pattern
+    };
+    std::vector<uint8_t> data = Filler(4096, 1);
+    const uint8_t run[] = { 0xE8, 0x11, 0x22, 0x33, 0x44, 0x90, 0x55, 0x8B, 0xEC, 0x83, 0xEC, 0x10, 0x56, 0x57 };
+    for (size_t at : { size_t(0), size_t(1), size_t(100), size_t(4096 - sizeof(run)) })
+        std::copy(std::begin(run), std::end(run), data.begin() + at);
+
+    const auto expected = PerPattern(patterns, data);
+    const auto got = Multi(patterns, data, 1);
+    CHECK_EQ(got.size(), patterns.size());
+    for (size_t k = 0; k < patterns.size() && k < got.size(); ++k)
+        CHECK(got[k] == expected[k]);
+    CHECK(got[3].empty());
+    CHECK(!got[0].empty() && got[0] == got[6]);
+    CHECK(!got[4].empty());
+}
+
+TEST(MaxHitsKeepsFirstOffsets)
+{
+    const std::vector<SigScan::Pattern> patterns = { Parse("DE AD BE EF") };
+    std::vector<uint8_t> data = Filler(8192, 2);
+    for (size_t at = 10; at + 4 <= data.size(); at += 1000)
+        Plant(data, at, patterns[0]);
+
+    const auto all = Multi(patterns, data, 1);
+    const auto two = Multi(patterns, data, 1, 2);
+    CHECK_EQ(all[0].size(), 9u);
+    CHECK_EQ(two[0].size(), 2u);
+    CHECK(two[0].size() == 2 && two[0][0] == 10 && two[0][1] == 1010);
+}
+
+TEST(RandomPatternsMatchPerPatternScans)
+{
+    std::mt19937 rng(99);
+    for (int kernel = 0; kernel < 2; ++kernel)
+    {
+        SigScan::ForceSse2(kernel == 0);
+        for (int iter = 0; iter < 60; ++iter)
+        {
+            std::vector<uint8_t> data = Filler(1 + rng() % 20000, rng());
+
+            // Patterns cut from the data (so they hit), with random wildcards
+            std::vector<SigScan::Pattern> patterns;
+            const size_t count = 1 + rng() % 24;
+            for (size_t n = 0; n < count; ++n)
+            {
+                const size_t len = 1 + rng() % std::min<size_t>(data.size(), 24);
+                const size_t from = rng() % (data.size() - len + 1);
+                std::string ida;
+                for (size_t k = 0; k < len; ++k)
+                {
+                    char hex[4];
+                    std::snprintf(hex, sizeof(hex), "%02X ", data[from + k]);
+                    ida += (k != len / 2 && rng() % 5 == 0) ? "?? " : hex;
+                }
+                patterns.push_back(Parse(ida.c_str()));
+            }
+
+            const auto expected = PerPattern(patterns, data);
+            const auto got = Multi(patterns, data, 1);
+            for (size_t k = 0; k < patterns.size(); ++k)
+                CHECK(got[k] == expected[k]);
+            if (Test::Failures())
+                break;
+        }
+    }
+    SigScan::ForceSse2(false);
+}
+
+TEST(FourThreadChunkBoundaries)
+{
+    // Big enough that Scan really uses 4 threads (1 MB minimum per thread);
+    // the odd size leaves a remainder in the last chunk
+    const size_t size = 4 * 1024 * 1024 + 13;
+    const size_t chunk = size / 4;
+    const std::vector<uint8_t> base = Filler(size, 3);
+
+    const std::vector<SigScan::Pattern> patterns = {
+        Parse("E9 ?? ?? ?? ?? 3D 5A 7F 00 00 74 ?? 8B 4D F0 C3"),   // 16 bytes, key in the middle
+        Parse("A1 B2 C3 D4"),                                       // short key
+        Parse("?? ?? ?? F1 F2 F3 F4 F5 F6 F7 F8 F9"),               // key after wildcards
+    };
+
+    for (const SigScan::Pattern& p : patterns)
+    {
+        // Every alignment of the pattern across each boundary, one scan each
+        for (size_t shift = 0; shift <= p.Size(); ++shift)
+        {
+            std::vector<uint8_t> data = base;
+            for (size_t b = 1; b < 4; ++b)
+                Plant(data, b * chunk - shift, p);
+            Plant(data, 0, p);
+            Plant(data, size - p.Size(), p);
+
+            const std::vector<SigScan::Pattern> one = { p };
+            const auto expected = PerPattern(one, data);
+            const auto single = Multi(one, data, 1);
+            const auto four = Multi(one, data, 4);
+            CHECK(expected[0].size() >= 5);
+            CHECK(single[0] == expected[0]);
+            CHECK(four[0] == expected[0]);
+            if (Test::Failures())
+                return;
+        }
+    }
+}
+
+TEST(EmptyInputs)
+{
+    SigScan::MultiScanner empty;
+    empty.Build();
+    std::vector<std::vector<size_t>> hits;
+    std::vector<uint8_t> data(64, 0xE8);
+    empty.Scan(data, hits);
+    CHECK(hits.empty());
+
+    SigScan::MultiScanner scanner;
+    scanner.Add(Parse("E8 E8"));
+    scanner.Build();
+    scanner.Scan(std::span<const uint8_t>(), hits);
+    CHECK_EQ(hits.size(), 1u);
+    CHECK(hits[0].empty());
+    scanner.Scan(std::span<const uint8_t>(data.data(), 1), hits);
+    CHECK(hits[0].empty());
+    scanner.Scan(data, hits, SigScan::npos, 0);
+    CHECK_EQ(hits[0].size(), 63u);
+}
+
+TEST_MAIN()
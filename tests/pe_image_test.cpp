@@ -0,0 +1,439 @@
+/**
+ * @file pe_image_test.cpp
+ * @brief Tests for the PE32 parser over a small synthetic image, in file and mapped layout.
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "test.h"
+#include "pe_image.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+
+// The fixture: three sections, one import descriptor (by name and by
+// ordinal) and one relocation block.
+//
+//   file    rva
+//   0x000   0x0000  DOS header, e_lfanew = 0x80
+//   0x080   0x0080  PE signature, file header, optional header, section table
+//   0x200   0x1000  .text   (virtual 0x20)
+//   0x400   0x2000  .rdata  imports: descriptors 0x2000, ILT 0x2040, IAT 0x2060,
+//                           "KERNEL32.dll" 0x2080, hint/name 0x20A0
+//   0x600   0x3000  .reloc  one block for page 0x1000
+constexpr uint32_t kLfanew       = 0x80;
+constexpr uint32_t kFileHeader   = kLfanew + 4;
+constexpr uint32_t kOpt          = kFileHeader + 20;
+constexpr uint32_t kOptSize      = 0xE0;
+constexpr uint32_t kSections     = kOpt + kOptSize;
+constexpr uint32_t kHeadersSize  = 0x200;
+constexpr uint32_t kImageSize    = 0x4000;
+constexpr uint32_t kFileSize     = 0x800;
+constexpr uint32_t kImageBase    = 0x00400000;
+
+void Put16(std::vector<uint8_t>& b, size_t at, uint16_t v) { memcpy(b.data() + at, &v, 2); }
+void Put32(std::vector<uint8_t>& b, size_t at, uint32_t v) { memcpy(b.data() + at, &v, 4); }
+void PutStr(std::vector<uint8_t>& b, size_t at, std::string_view s) { memcpy(b.data() + at, s.data(), s.size()); }
+
+struct SectionSpec
+{
+    const char* name;
+    uint32_t    rva, virtualSize, rawOffset, rawSize, characteristics;
+};
+
+constexpr SectionSpec kSpecs[] = {
+    { ".text",  0x1000, 0x20, 0x200, 0x200, 0x60000020 },
+    { ".rdata", 0x2000, 0x200, 0x400, 0x200, 0x40000040 },
+    { ".reloc", 0x3000, 0x200, 0x600, 0x200, 0x42000040 },
+};
+
+// Section raw data sits at rawOffset + (rva - section rva)
+size_t FileOffset(uint32_t rva)
+{
+    for (const SectionSpec& s : kSpecs)
+    {
+        if (rva >= s.rva && rva < s.rva + s.rawSize)
+            return s.rawOffset + (rva - s.rva);
+    }
+    return rva;
+}
+
+std::vector<uint8_t> BuildFile()
+{
+    std::vector<uint8_t> b(kFileSize, 0);
+
+    Put16(b, 0, 0x5A4D);                        // "MZ"
+    Put32(b, 0x3C, kLfanew);
+    Put32(b, kLfanew, 0x00004550);              // "PE\0\0"
+
+    Put16(b, kFileHeader + 0, 0x014C);          // i386
+    Put16(b, kFileHeader + 2, 3);               // sections
+    Put32(b, kFileHeader + 4, 0x5A5A0001);      // TimeDateStamp
+    Put16(b, kFileHeader + 16, kOptSize);
+    Put16(b, kFileHeader + 18, 0x0102);
+
+    Put16(b, kOpt + 0, 0x010B);                 // PE32
+    Put32(b, kOpt + 16, 0x1000);                // AddressOfEntryPoint
+    Put32(b, kOpt + 28, kImageBase);
+    Put32(b, kOpt + 32, 0x1000);                // SectionAlignment
+    Put32(b, kOpt + 36, 0x200);                 // FileAlignment
+    Put32(b, kOpt + 56, kImageSize);
+    Put32(b, kOpt + 60, kHeadersSize);
+    Put32(b, kOpt + 64, 0x00012345);            // CheckSum
+    Put32(b, kOpt + 92, 16);                    // NumberOfRvaAndSizes
+    Put32(b, kOpt + 96 + PE::kDirImport * 8, 0x2000);
+    Put32(b, kOpt + 96 + PE::kDirImport * 8 + 4, 40);
+    Put32(b, kOpt + 96 + PE::kDirBaseReloc * 8, 0x3000);
+    Put32(b, kOpt + 96 + PE::kDirBaseReloc * 8 + 4, 12);
+
+    for (size_t i = 0; i < std::size(kSpecs); ++i)
+    {
+        const SectionSpec& s = kSpecs[i];
+        const size_t h = kSections + i * 40;
+        PutStr(b, h, s.name);
+        Put32(b, h + 8, s.virtualSize);
+        Put32(b, h + 12, s.rva);
+        Put32(b, h + 16, s.rawSize);
+        Put32(b, h + 20, s.rawOffset);
+        Put32(b, h + 36, s.characteristics);
+    }
+
+    // .text: push ebp / mov ebp,esp / mov eax,[abs32] / pop ebp / ret
+    const uint8_t code[] = { 0x55, 0x8B, 0xEC, 0xA1, 0x00, 0x30, 0x40, 0x00, 0x5D, 0xC3 };
+    memcpy(b.data() + FileOffset(0x1000), code, sizeof(code));
+
+    // .rdata: one descriptor plus the all-zero terminator
+    Put32(b, FileOffset(0x2000) + 0, 0x2040);   // OriginalFirstThunk
+    Put32(b, FileOffset(0x2000) + 12, 0x2080);  // Name
+    Put32(b, FileOffset(0x2000) + 16, 0x2060);  // FirstThunk
+    for (uint32_t table : { 0x2040u, 0x2060u })
+    {
+        Put32(b, FileOffset(table) + 0, 0x20A0);        // by name
+        Put32(b, FileOffset(table) + 4, 0x80000010);    // by ordinal 16
+    }
+    PutStr(b, FileOffset(0x2080), "KERNEL32.dll");
+    PutStr(b, FileOffset(0x20A2), "GetTickCount");
+
+    // .reloc: page 0x1000, HIGHLOW at +4 (the abs32 above), then ABSOLUTE padding
+    Put32(b, FileOffset(0x3000) + 0, 0x1000);
+    Put32(b, FileOffset(0x3000) + 4, 12);
+    Put16(b, FileOffset(0x3000) + 8, 0x3004);
+    Put16(b, FileOffset(0x3000) + 10, 0x0000);
+    return b;
+}
+
+// What the loader would produce: headers at 0, each section at its RVA
+std::vector<uint8_t> BuildMapped(const std::vector<uint8_t>& file)
+{
+    std::vector<uint8_t> m(kImageSize, 0);
+    memcpy(m.data(), file.data(), kHeadersSize);
+    for (const SectionSpec& s : kSpecs)
+        memcpy(m.data() + s.rva, file.data() + s.rawOffset, std::min(s.rawSize, s.virtualSize));
+    return m;
+}
+
+bool ParseFile(const std::vector<uint8_t>& b, PE::Image& image)
+{
+    return image.Parse(b, PE::Layout::File);
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Well-formed image
+// ---------------------------------------------------------------------------
+
+TEST(Headers)
+{
+    const std::vector<uint8_t> file = BuildFile();
+    PE::Image image;
+    CHECK(ParseFile(file, image));
+    CHECK(image.Valid());
+    CHECK(image.GetLayout() == PE::Layout::File);
+    CHECK_EQ(image.ImageBase(), kImageBase);
+    CHECK_EQ(image.SizeOfImage(), kImageSize);
+    CHECK_EQ(image.EntryPointRva(), 0x1000u);
+    CHECK_EQ(image.TimeDateStamp(), 0x5A5A0001u);
+    CHECK_EQ(image.CheckSum(), 0x00012345u);
+    CHECK_EQ(image.Headers().size(), kHeadersSize);
+    CHECK_EQ(image.Bytes().size(), kFileSize);
+}
+
+TEST(Sections)
+{
+    const std::vector<uint8_t> file = BuildFile();
+    const std::vector<uint8_t> mapped = BuildMapped(file);
+    PE::Image onDisk, loaded;
+    CHECK(ParseFile(file, onDisk));
+    CHECK(loaded.Parse(mapped, PE::Layout::Mapped));
+
+    CHECK_EQ(onDisk.Sections().size(), 3u);
+    const PE::Section* text = onDisk.FindSection(".text");
+    CHECK(text != nullptr);
+    if (!text)
+        return;
+    CHECK_EQ(text->rva, 0x1000u);
+    CHECK(text->IsExecutable());
+    CHECK(!onDisk.FindSection(".rdata")->IsExecutable());
+    CHECK(onDisk.FindSection(".data") == nullptr);
+    CHECK(onDisk.FindSection(".tex") == nullptr);
+
+    CHECK(onDisk.SectionForRva(0x101F) == text);
+    CHECK(onDisk.SectionForRva(0x1020) == nullptr);    // past the virtual size
+    CHECK(onDisk.SectionForRva(0x3008) == onDisk.FindSection(".reloc"));
+    CHECK(onDisk.SectionForRva(0x5000) == nullptr);
+
+    // File layout spans the raw size, mapped layout the virtual size
+    std::span<const uint8_t> rawText = onDisk.SectionData(*text);
+    std::span<const uint8_t> mappedText = loaded.SectionData(*loaded.FindSection(".text"));
+    CHECK_EQ(rawText.size(), 0x200u);
+    CHECK_EQ(mappedText.size(), 0x20u);
+    CHECK(memcmp(rawText.data(), mappedText.data(), mappedText.size()) == 0);
+    CHECK_EQ(rawText[0], 0x55);
+}
+
+TEST(Imports)
+{
+    const std::vector<uint8_t> file = BuildFile();
+    const std::vector<uint8_t> mapped = BuildMapped(file);
+    PE::Image onDisk, loaded;
+    CHECK(ParseFile(file, onDisk));
+    CHECK(loaded.Parse(mapped, PE::Layout::Mapped));
+
+    for (const PE::Image* image : { &onDisk, &loaded })
+    {
+        std::vector<PE::Import> imports;
+        CHECK(image->Imports(imports));
+        CHECK_EQ(imports.size(), 2u);
+        if (imports.size() != 2)
+            continue;
+        CHECK(imports[0].module == "KERNEL32.dll");
+        CHECK(imports[0].name == "GetTickCount");
+        CHECK_EQ(imports[0].iatRva, 0x2060u);
+        CHECK(imports[1].name.empty());
+        CHECK_EQ(imports[1].ordinal, 16);
+        CHECK_EQ(imports[1].iatRva, 0x2064u);
+    }
+}
+
+TEST(Relocations)
+{
+    const std::vector<uint8_t> file = BuildFile();
+    const std::vector<uint8_t> mapped = BuildMapped(file);
+    PE::Image onDisk, loaded;
+    CHECK(ParseFile(file, onDisk));
+    CHECK(loaded.Parse(mapped, PE::Layout::Mapped));
+
+    for (const PE::Image* image : { &onDisk, &loaded })
+    {
+        std::vector<uint32_t> fixups;
+        CHECK(image->Relocations(fixups));
+        CHECK_EQ(fixups.size(), 1u);
+        if (!fixups.empty())
+            CHECK_EQ(fixups[0], 0x1004u);
+
+        std::vector<PE::RuntimeFunction> pdata;
+        CHECK(image->ExceptionEntries(pdata));
+        CHECK(pdata.empty());
+    }
+}
+
+TEST(RvaToPtrBounds)
+{
+    const std::vector<uint8_t> file = BuildFile();
+    PE::Image image;
+    CHECK(ParseFile(file, image));
+    const uint8_t* base = image.Bytes().data();
+
+    CHECK(image.RvaToPtr(0x3C, 4) == base + 0x3C);         // headers map 1:1
+    CHECK(image.RvaToPtr(0x1000) == base + 0x200);
+    CHECK(image.RvaToPtr(0x101F, 1) == base + 0x21F);
+    CHECK(image.RvaToPtr(0x101F, 2) == base + 0x21F);      // raw data runs on past the virtual size
+    CHECK(image.RvaToPtr(0x1020) == nullptr);              // ...but the RVA is outside every section
+    CHECK(image.RvaToPtr(0x3000, 0x200) != nullptr);
+    CHECK(image.RvaToPtr(0x3000, 0x201) == nullptr);       // runs off the end of .reloc's raw data
+    CHECK(image.RvaToPtr(0x5000) == nullptr);
+    CHECK(image.RvaToPtr(0x1000, SIZE_MAX) == nullptr);
+    CHECK(image.RvaToPtr(UINT32_MAX) == nullptr);
+
+    uint32_t rva = 0;
+    CHECK(image.PtrToRva(base + 0x205, rva));
+    CHECK_EQ(rva, 0x1005u);
+    CHECK(image.PtrToRva(base + 0x10, rva));
+    CHECK_EQ(rva, 0x10u);
+    CHECK(!image.PtrToRva(base + kFileSize, rva));
+    CHECK(!image.PtrToRva(base - 1, rva));
+
+    const std::vector<uint8_t> mapped = BuildMapped(file);
+    PE::Image loaded;
+    CHECK(loaded.Parse(mapped, PE::Layout::Mapped));
+    CHECK(loaded.RvaToPtr(kImageSize - 4, 4) != nullptr);
+    CHECK(loaded.RvaToPtr(kImageSize - 4, 5) == nullptr);
+    CHECK(loaded.RvaToPtr(kImageSize) == nullptr);
+}
+
+TEST(DirectoryBounds)
+{
+    std::vector<uint8_t> file = BuildFile();
+    PE::Image image;
+    CHECK(ParseFile(file, image));
+    CHECK_EQ(image.Directory(PE::kDirImport).size(), 40u);
+    CHECK(image.Directory(PE::kDirException).empty());    // absent
+    CHECK(image.Directory(16).empty());                   // past NumberOfRvaAndSizes
+
+    // A directory that points outside the image is empty, not a wild pointer
+    Put32(file, kOpt + 96 + PE::kDirBaseReloc * 8, 0x9000);
+    CHECK(ParseFile(file, image));
+    CHECK(image.Directory(PE::kDirBaseReloc).empty());
+    std::vector<uint32_t> fixups;
+    CHECK(image.Relocations(fixups));
+    CHECK(fixups.empty());
+
+    // NumberOfRvaAndSizes larger than the optional header holds is clamped
+    file = BuildFile();
+    Put32(file, kOpt + 92, 0x7FFFFFFF);
+    CHECK(ParseFile(file, image));
+    CHECK(image.Directory(15).empty());
+    CHECK(image.Directory(16).empty());
+    CHECK_EQ(image.Directory(PE::kDirImport).size(), 40u);
+}
+
+// ---------------------------------------------------------------------------
+// Truncated and malformed input
+// ---------------------------------------------------------------------------
+
+TEST(TruncatedHeaders)
+{
+    const std::vector<uint8_t> file = BuildFile();
+    const size_t tableEnd = kSections + 3 * 40;
+
+    // Every prefix short of the full section table must be refused
+    for (size_t n = 0; n < tableEnd; ++n)
+    {
+        PE::Image image;
+        CHECK(!image.Parse(std::span<const uint8_t>(file.data(), n), PE::Layout::File));
+        CHECK(!image.Valid());
+    }
+
+    // Longer prefixes parse, but every decoder stays inside the span
+    for (size_t n = tableEnd; n <= file.size(); ++n)
+    {
+        PE::Image image;
+        CHECK(image.Parse(std::span<const uint8_t>(file.data(), n), PE::Layout::File));
+        std::vector<PE::Import> imports;
+        std::vector<uint32_t> fixups;
+        // A directory cut off by the truncation reads as absent (see
+        // Image::Directory); one cut inside its names or thunks fails
+        const bool importsOk = image.Imports(imports);
+        image.Relocations(fixups);
+        CHECK(importsOk ? (imports.empty() || imports.size() == 2) : imports.size() < 2);
+        CHECK(image.Headers().size() <= n);
+        for (const PE::Section& s : image.Sections())
+            CHECK(image.SectionData(s).size() <= n);
+    }
+}
+
+TEST(MalformedHeaders)
+{
+    struct Case { const char* what; size_t at; uint32_t value; int width; };
+    const Case cases[] = {
+        { "DOS magic",            0,                 0x5A4E,     2 },
+        { "e_lfanew past end",    0x3C,              0x10000,    4 },
+        { "e_lfanew wraps",       0x3C,              0xFFFFFFFE, 4 },
+        { "PE signature",         kLfanew,           0x00004551, 4 },
+        { "PE32+ magic",          kOpt,              0x020B,     2 },
+        { "optional header small", kFileHeader + 16, 0x5C,       2 },
+        { "section count",        kFileHeader + 2,   0xFFFF,     2 },
+        { "optional header huge", kFileHeader + 16,  0xFFFF,     2 },
+    };
+    for (const Case& c : cases)
+    {
+        std::vector<uint8_t> file = BuildFile();
+        if (c.width == 2)
+            Put16(file, c.at, static_cast<uint16_t>(c.value));
+        else
+            Put32(file, c.at, c.value);
+        PE::Image image;
+        const bool parsed = ParseFile(file, image);
+        CHECK(!parsed);
+        if (parsed)
+            std::printf("    accepted bad %s\n", c.what);
+    }
+}
+
+TEST(MalformedRelocations)
+{
+    const size_t block = FileOffset(0x3000);
+
+    std::vector<uint8_t> file = BuildFile();
+    Put32(file, block + 4, 4);                   // block smaller than its header
+    PE::Image image;
+    std::vector<uint32_t> fixups;
+    CHECK(ParseFile(file, image));
+    CHECK(!image.Relocations(fixups));
+
+    file = BuildFile();
+    Put32(file, block + 4, 0x100);               // block larger than the directory
+    CHECK(ParseFile(file, image));
+    CHECK(!image.Relocations(fixups));
+
+    file = BuildFile();
+    Put16(file, block + 10, 0xA008);             // DIR64 has no place in PE32
+    fixups.clear();
+    CHECK(ParseFile(file, image));
+    CHECK(!image.Relocations(fixups));
+    CHECK_EQ(fixups.size(), 1u);                 // entries before the fault are kept
+}
+
+TEST(MalformedImports)
+{
+    const size_t desc = FileOffset(0x2000);
+    PE::Image image;
+    std::vector<PE::Import> imports;
+
+    std::vector<uint8_t> file = BuildFile();
+    Put32(file, desc + 12, 0x9000);              // module name outside the image
+    CHECK(ParseFile(file, image));
+    CHECK(!image.Imports(imports));
+
+    file = BuildFile();
+    Put32(file, FileOffset(0x2040), 0x9000);     // hint/name outside the image
+    CHECK(ParseFile(file, image));
+    CHECK(!image.Imports(imports));
+
+    // Unterminated module name in the last byte of the file
+    file = BuildFile();
+    Put32(file, desc + 12, 0x31FF);
+    file[FileOffset(0x31FF)] = 'X';
+    CHECK(ParseFile(file, image));
+    CHECK(!image.Imports(imports));
+
+    // Last descriptor fills .rdata's raw data, so there is no terminator
+    file = BuildFile();
+    Put32(file, kOpt + 96 + PE::kDirImport * 8, 0x21EC);
+    Put32(file, kOpt + 96 + PE::kDirImport * 8 + 4, 20);
+    Put32(file, FileOffset(0x21EC) + 0, 0x2040);
+    Put32(file, FileOffset(0x21EC) + 12, 0x2080);
+    Put32(file, FileOffset(0x21EC) + 16, 0x2060);
+    CHECK(ParseFile(file, image));
+    imports.clear();
+    CHECK(!image.Imports(imports));
+    CHECK_EQ(imports.size(), 2u);                // the good descriptor was decoded first
+
+    // Thunk list that never terminates: point the lookup table at the tail of
+    // .rdata and fill it with ordinals
+    file = BuildFile();
+    Put32(file, desc + 0, 0x2100);
+    for (uint32_t at = 0x2100; at < 0x2200; at += 4)
+        Put32(file, FileOffset(at), 0x80000001);
+    CHECK(ParseFile(file, image));
+    CHECK(!image.Imports(imports));
+}
+
+TEST_MAIN()
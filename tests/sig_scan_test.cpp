@@ -0,0 +1,256 @@
+/**
+ * @file sig_scan_test.cpp
+ * @brief Tests for the IDA-style pattern parser and the SSE2/AVX2 scan kernels.
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "test.h"
+#include "sig_scan.h"
+#include "signatures.h"
+
+#include <cstdint>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+// Every match of p in data, by brute force
+std::vector<size_t> Naive(const std::vector<uint8_t>& data, const SigScan::Pattern& p)
+{
+    std::vector<size_t> hits;
+    for (size_t i = 0; i + p.Size() <= data.size(); ++i)
+    {
+        if (p.MatchAt(data.data() + i))
+            hits.push_back(i);
+    }
+    return hits;
+}
+
+std::string ToIda(const std::vector<uint8_t>& bytes, const std::vector<bool>& wild)
+{
+    static const char kHex[] = "0123456789ABCDEF";
+    std::string s;
+    for (size_t i = 0; i < bytes.size(); ++i)
+    {
+        if (i)
+            s += ' ';
+        if (wild[i])
+        {
+            s += "??";
+        }
+        else
+        {
+            s += kHex[bytes[i] >> 4];
+            s += kHex[bytes[i] & 15];
+        }
+    }
+    return s;
+}
+
+// Run body once per kernel (SSE2, then AVX2 where the CPU has it)
+template <typename Fn>
+void ForEachKernel(Fn&& body)
+{
+    SigScan::ForceSse2(true);
+    body();
+    SigScan::ForceSse2(false);
+    if (SigScan::UsingAvx2())
+        body();
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Parsing
+// ---------------------------------------------------------------------------
+
+TEST(ParseForms)
+{
+    SigScan::Pattern p;
+    CHECK(p.Parse("55 8b EC ?? ? \t 0F"));
+    CHECK_EQ(p.Size(), 6u);
+    const uint8_t bytes[] = { 0x55, 0x8B, 0xEC, 0x00, 0x00, 0x0F };
+    const uint8_t mask[] = { 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0xFF };
+    for (size_t i = 0; i < 6; ++i)
+    {
+        CHECK_EQ(p.bytes[i], bytes[i]);
+        CHECK_EQ(p.mask[i], mask[i]);
+    }
+
+    CHECK(p.Parse("  E9  "));
+    CHECK_EQ(p.Size(), 1u);
+}
+
+TEST(ParseRejects)
+{
+    const char* bad[] = { "", "   ", "?? ??", "5", "555", "GG", "55 8B E", "55,8B", "0x55" };
+    for (const char* s : bad)
+    {
+        SigScan::Pattern p;
+        CHECK(!p.Parse(s));
+        CHECK(p.Empty());
+    }
+}
+
+TEST(AnchorsPreferRareBytes)
+{
+    // E9 is not in the common-byte table; 8B and 45 are
+    SigScan::Pattern p;
+    CHECK(p.Parse("8B 45 E9 ?? 8B"));
+    CHECK_EQ(p.anchor, 2u);
+    CHECK_EQ(p.anchor2, 4u);                     // last literal, not the trailing wildcard
+    CHECK(SigScan::ByteCommonness(0x00) > SigScan::ByteCommonness(0x8B));
+    CHECK_EQ(SigScan::ByteCommonness(0xE9), 0);
+}
+
+// ---------------------------------------------------------------------------
+// Scanning
+// ---------------------------------------------------------------------------
+
+TEST(EdgesAndArguments)
+{
+    ForEachKernel([]() {
+        SigScan::Pattern p;
+        CHECK(p.Parse("AA ?? BB"));
+
+        std::vector<uint8_t> data(100, 0x11);
+        CHECK_EQ(SigScan::Find(data, p), SigScan::npos);
+
+        // Match in the very last position, found by the scalar tail
+        data[97] = 0xAA;
+        data[99] = 0xBB;
+        CHECK_EQ(SigScan::Find(data, p), 97u);
+        CHECK_EQ(SigScan::Find(data, p, 97), 97u);
+        CHECK_EQ(SigScan::Find(data, p, 98), SigScan::npos);
+        CHECK_EQ(SigScan::Find(data, p, 1000), SigScan::npos);
+
+        // Match at 0
+        data[0] = 0xAA;
+        data[2] = 0xBB;
+        CHECK_EQ(SigScan::Find(data, p), 0u);
+
+        std::vector<size_t> hits;
+        CHECK_EQ(SigScan::FindAll(data, p, hits, 0), 0u);
+        CHECK_EQ(SigScan::FindAll(data, p, hits, 1), 1u);
+        CHECK_EQ(hits.size(), 1u);
+        hits.clear();
+        CHECK_EQ(SigScan::FindAll(data, p, hits), 2u);
+
+        // Data shorter than the pattern, and an empty pattern
+        std::vector<uint8_t> tiny = { 0xAA, 0x00 };
+        CHECK_EQ(SigScan::Find(tiny, p), SigScan::npos);
+        SigScan::Pattern empty;
+        CHECK_EQ(SigScan::Find(data, empty), SigScan::npos);
+    });
+}
+
+TEST(LeadingWildcards)
+{
+    ForEachKernel([]() {
+        SigScan::Pattern p;
+        CHECK(p.Parse("?? ?? ?? E8"));
+        std::vector<uint8_t> data(64, 0x90);
+        data[2] = 0xE8;                          // too early: no room for the wildcards
+        data[40] = 0xE8;
+        std::vector<size_t> hits;
+        SigScan::FindAll(data, p, hits);
+        CHECK_EQ(hits.size(), 1u);
+        if (!hits.empty())
+            CHECK_EQ(hits[0], 37u);
+    });
+}
+
+TEST(MatchesBruteForce)
+{
+    // Random x86-ish bytes (so the filter bytes are genuinely common), with
+    // patterns cut from the data itself and planted near every block edge
+    std::mt19937 rng(1234);
+    const uint8_t alphabet[] = { 0x00, 0xFF, 0x8B, 0x45, 0x89, 0xE8, 0xCC, 0x55, 0xEC, 0x83, 0x74, 0x0F };
+
+    ForEachKernel([&]() {
+        for (int iter = 0; iter < 400; ++iter)
+        {
+            // Sizes straddle the 16/32-byte kernel blocks; exact-size vectors
+            // let ASan catch any read past the end
+            const size_t n = 1 + rng() % 300;
+            std::vector<uint8_t> data(n);
+            for (auto& b : data)
+                b = (rng() % 4) ? alphabet[rng() % sizeof(alphabet)] : static_cast<uint8_t>(rng());
+
+            const size_t len = 1 + rng() % std::min<size_t>(n, 40);
+            const size_t from = rng() % (n - len + 1);
+            std::vector<uint8_t> bytes(data.begin() + from, data.begin() + from + len);
+            std::vector<bool> wild(len);
+            bool anyLiteral = false;
+            for (size_t k = 0; k < len; ++k)
+            {
+                wild[k] = rng() % 4 == 0;
+                anyLiteral |= !wild[k];
+            }
+            if (!anyLiteral)
+                wild[len - 1] = false;
+
+            SigScan::Pattern p;
+            CHECK(p.Parse(ToIda(bytes, wild)));
+
+            // Plant extra copies at block boundaries
+            for (size_t at : { size_t(15), size_t(16), size_t(31), size_t(32), n - len })
+            {
+                if (at + len <= n && rng() % 2)
+                    std::copy(bytes.begin(), bytes.end(), data.begin() + at);
+            }
+
+            const std::vector<size_t> expected = Naive(data, p);
+            std::vector<size_t> got;
+            SigScan::FindAll(data, p, got);
+            CHECK(got == expected);
+            CHECK_EQ(SigScan::Find(data, p), expected.empty() ? SigScan::npos : expected[0]);
+
+            const size_t start = rng() % (n + 1);
+            size_t next = SigScan::npos;
+            for (size_t e : expected)
+            {
+                if (e >= start)
+                {
+                    next = e;
+                    break;
+                }
+            }
+            CHECK_EQ(SigScan::Find(data, p, start), next);
+            if (Test::Failures())
+                return;
+        }
+    });
+}
+
+// ---------------------------------------------------------------------------
+// signatures.h
+// ---------------------------------------------------------------------------
+
+TEST(SignatureTableIsWellFormed)
+{
+    // Every captured pattern parses, a Rel32 operand lies inside its pattern,
+    // and names are unique (the cache and offset_gen key on them)
+    std::set<std::string> names;
+    size_t patterns = 0;
+    for (const SigDef& def : kSigDefs)
+    {
+        CHECK(names.insert(def.name).second);
+        if (!def.pattern)
+            continue;
+        ++patterns;
+        SigScan::Pattern p;
+        CHECK(p.Parse(def.pattern));
+        CHECK(def.offset >= 0 && static_cast<size_t>(def.offset) <= p.Size());
+        if (def.kind == SigKind::Rel32)
+            CHECK(static_cast<size_t>(def.offset) + 4 <= p.Size());
+    }
+    CHECK_EQ(patterns, SigPatternCount());
+}
+
+TEST_MAIN()
@@ -0,0 +1,231 @@
+/**
+ * @file spatial_grid_bench.cpp
+ * @brief Benchmark of SpatialGrid queries against a linear scan of every spawn, 100 to 10,000 entities.
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Each cloud is laid out like a busy zone: most spawns sit in camps of a few
+ * dozen around random centres in a 4000 x 4000 area, the rest wander
+ * anywhere, and Z varies a little. The grid uses the spawn index's 64-unit
+ * cells. The linear scan is what a mod does today with GetSpawnList, and
+ * every grid result is checked against it before anything is timed.
+ */
+
+#include "bench.h"
+#include "spatial_grid.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+struct Spawn
+{
+    float x, y, z;
+};
+
+std::vector<Spawn> Cloud(size_t count, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> zone(-2000.0f, 2000.0f);
+    std::normal_distribution<float> camp(0.0f, 60.0f);
+    std::normal_distribution<float> height(0.0f, 15.0f);
+
+    std::vector<Spawn> centres(std::max<size_t>(count / 30, 1));
+    for (auto& c : centres)
+        c = { zone(rng), zone(rng), 0.0f };
+
+    std::vector<Spawn> spawns(count);
+    for (auto& s : spawns)
+    {
+        if (rng() % 5)
+        {
+            const Spawn& c = centres[rng() % centres.size()];
+            s = { c.x + camp(rng), c.y + camp(rng), height(rng) };
+        }
+        else
+        {
+            s = { zone(rng), zone(rng), height(rng) };
+        }
+    }
+    return spawns;
+}
+
+float DistSq(const Spawn& s, float x, float y, float z)
+{
+    float dx = s.x - x, dy = s.y - y, dz = s.z - z;
+    return dx * dx + dy * dy + dz * dz;
+}
+
+// The linear scans the grid replaces
+void LinearRadius(const std::vector<Spawn>& spawns, float x, float y, float z, float radius,
+    std::vector<const void*>& out)
+{
+    float r2 = radius * radius;
+    for (const Spawn& s : spawns)
+    {
+        if (DistSq(s, x, y, z) <= r2)
+            out.push_back(&s);
+    }
+}
+
+void LinearNearest(const std::vector<Spawn>& spawns, float x, float y, float z, size_t k,
+    std::vector<std::pair<float, const void*>>& scratch, std::vector<const void*>& out)
+{
+    scratch.clear();
+    for (const Spawn& s : spawns)
+        scratch.emplace_back(DistSq(s, x, y, z), &s);
+    k = std::min(k, scratch.size());
+    std::partial_sort(scratch.begin(), scratch.begin() + k, scratch.end());
+    for (size_t i = 0; i < k; ++i)
+        out.push_back(scratch[i].second);
+}
+
+bool SameSet(std::vector<const void*> a, std::vector<const void*> b)
+{
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+    return a == b;
+}
+
+// Nearest results may order equal distances differently; compare distances
+bool SameDistances(const std::vector<const void*>& a, const std::vector<const void*>& b,
+    float x, float y, float z)
+{
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        if (DistSq(*static_cast<const Spawn*>(a[i]), x, y, z) != DistSq(*static_cast<const Spawn*>(b[i]), x, y, z))
+            return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main()
+{
+    constexpr size_t kQueries = 256;
+    bool ok = true;
+
+    for (size_t count : { size_t(100), size_t(1000), size_t(10000) })
+    {
+        std::vector<Spawn> spawns = Cloud(count, static_cast<uint32_t>(count));
+        SpatialGrid grid(64.0f);
+        for (const Spawn& s : spawns)
+            grid.Insert(&s, s.x, s.y, s.z);
+
+        // Query points: near a spawn (where a player stands), plus one far
+        // outside the zone for the Nearest fallback
+        std::mt19937 rng(1);
+        std::vector<Spawn> points(kQueries);
+        for (auto& p : points)
+        {
+            const Spawn& s = spawns[rng() % spawns.size()];
+            p = { s.x + 10.0f, s.y - 10.0f, s.z };
+        }
+        const Spawn far = { 50000.0f, -50000.0f, 0.0f };
+
+        // Correctness first
+        std::vector<const void*> a, b;
+        std::vector<std::pair<float, const void*>> scratch;
+        for (const Spawn& p : points)
+        {
+            a.clear();
+            b.clear();
+            grid.QueryRadius(p.x, p.y, p.z, 100.0f, a);
+            LinearRadius(spawns, p.x, p.y, p.z, 100.0f, b);
+            ok &= SameSet(a, b);
+
+            a.clear();
+            b.clear();
+            grid.Nearest(p.x, p.y, p.z, 5, a);
+            LinearNearest(spawns, p.x, p.y, p.z, 5, scratch, b);
+            ok &= SameDistances(a, b, p.x, p.y, p.z);
+        }
+        a.clear();
+        b.clear();
+        grid.Nearest(far.x, far.y, far.z, 5, a);
+        LinearNearest(spawns, far.x, far.y, far.z, 5, scratch, b);
+        ok &= SameDistances(a, b, far.x, far.y, far.z);
+
+        std::printf("spatial_grid: %zu spawns, per query\n", count);
+
+        size_t q = 0;
+        auto next = [&]() -> const Spawn& { return points[q++ % kQueries]; };
+
+        Bench::Run("QueryRadius 100 (grid)", [&]() {
+            const Spawn& p = next();
+            a.clear();
+            grid.QueryRadius(p.x, p.y, p.z, 100.0f, a);
+            Bench::DoNotOptimize(a.size());
+        });
+        Bench::Run("QueryRadius 100 (linear)", [&]() {
+            const Spawn& p = next();
+            a.clear();
+            LinearRadius(spawns, p.x, p.y, p.z, 100.0f, a);
+            Bench::DoNotOptimize(a.size());
+        });
+        Bench::Run("QueryBox 200x200 (grid)", [&]() {
+            const Spawn& p = next();
+            a.clear();
+            grid.QueryBox(p.x - 100.0f, p.y - 100.0f, p.z - 50.0f, p.x + 100.0f, p.y + 100.0f, p.z + 50.0f, a);
+            Bench::DoNotOptimize(a.size());
+        });
+        Bench::Run("Nearest 1 (grid)", [&]() {
+            const Spawn& p = next();
+            a.clear();
+            grid.Nearest(p.x, p.y, p.z, 1, a);
+            Bench::DoNotOptimize(a.size());
+        });
+        Bench::Run("Nearest 5 (grid)", [&]() {
+            const Spawn& p = next();
+            a.clear();
+            grid.Nearest(p.x, p.y, p.z, 5, a);
+            Bench::DoNotOptimize(a.size());
+        });
+        Bench::Run("Nearest 5 (linear)", [&]() {
+            const Spawn& p = next();
+            a.clear();
+            LinearNearest(spawns, p.x, p.y, p.z, 5, scratch, a);
+            Bench::DoNotOptimize(a.size());
+        });
+        Bench::Run("Nearest 5, point outside the zone (grid)", [&]() {
+            a.clear();
+            grid.Nearest(far.x, far.y, far.z, 5, a);
+            Bench::DoNotOptimize(a.size());
+        });
+
+        // One pulse: every spawn re-read, a tenth of them moved a few units
+        // (some across a cell boundary), the rest standing still
+        std::vector<Spawn> moved = spawns;
+        uint32_t pulse = 0;
+        Bench::Run("Refresh, 10% moving (grid, whole cloud)", [&]() {
+            ++pulse;
+            for (size_t i = pulse % 10; i < moved.size(); i += 10)
+                moved[i].x += (pulse & 1) ? 7.0f : -7.0f;
+            grid.Refresh([&](const void* key, float& x, float& y, float& z) {
+                const Spawn& s = moved[static_cast<const Spawn*>(key) - spawns.data()];
+                x = s.x;
+                y = s.y;
+                z = s.z;
+            });
+        });
+        std::printf("\n");
+    }
+
+    if (!ok)
+    {
+        std::printf("FAIL: grid results differ from the linear scan\n");
+        return 1;
+    }
+    return 0;
+}
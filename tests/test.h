@@ -0,0 +1,106 @@
+/**
+ * @file test.h
+ * @brief Minimal unit test harness for the portable sources — TEST registration and CHECK macros.
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Each *_test.cpp is its own executable, built by tests/Makefile against the
+ * portable framework sources, and ends with TEST_MAIN(). A failed CHECK logs
+ * file:line and marks the test failed, then the test keeps running. The exit
+ * code is the number of failed tests. A command-line argument runs only the
+ * tests whose name contains it.
+ */
+
+#pragma once
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace Test
+{
+
+struct Case
+{
+    const char* name;
+    void      (*fn)();
+};
+
+inline std::vector<Case>& Registry()
+{
+    static std::vector<Case> s_cases;
+    return s_cases;
+}
+
+inline int& Failures()
+{
+    static int s_failures = 0;
+    return s_failures;
+}
+
+struct Registrar
+{
+    Registrar(const char* name, void (*fn)()) { Registry().push_back({ name, fn }); }
+};
+
+inline void Fail(const char* file, int line, const char* expr)
+{
+    std::printf("    %s:%d: CHECK(%s) failed\n", file, line, expr);
+    ++Failures();
+}
+
+inline void FailEq(const char* file, int line, const char* a, const char* b, long long va, long long vb)
+{
+    std::printf("    %s:%d: CHECK_EQ(%s, %s) failed: %lld != %lld\n", file, line, a, b, va, vb);
+    ++Failures();
+}
+
+inline int RunAll(int argc, char** argv)
+{
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+    int run = 0, failed = 0;
+    for (const Case& c : Registry())
+    {
+        if (filter && !std::strstr(c.name, filter))
+            continue;
+        const int before = Failures();
+        c.fn();
+        ++run;
+        if (Failures() != before)
+        {
+            ++failed;
+            std::printf("  FAIL %s\n", c.name);
+        }
+        else
+        {
+            std::printf("  ok   %s\n", c.name);
+        }
+    }
+    std::printf("%d/%d passed\n", run - failed, run);
+    return failed;
+}
+
+} // namespace Test
+
+#define TEST(name)                                                    \
+    static void name();                                               \
+    static const Test::Registrar s_register_##name(#name, &name);     \
+    static void name()
+
+#define CHECK(expr)                                                   \
+    do { if (!(expr)) Test::Fail(__FILE__, __LINE__, #expr); } while (0)
+
+// Integral or pointer-sized values; both sides are shown on failure
+#define CHECK_EQ(a, b)                                                \
+    do {                                                              \
+        const auto check_a_ = (a);                                    \
+        const auto check_b_ = (b);                                    \
+        if (!(check_a_ == check_b_))                                  \
+            Test::FailEq(__FILE__, __LINE__, #a, #b,                  \
+                static_cast<long long>(check_a_), static_cast<long long>(check_b_)); \
+    } while (0)
+
+#define TEST_MAIN() \
+    int main(int argc, char** argv) { return Test::RunAll(argc, argv); }
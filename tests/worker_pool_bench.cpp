@@ -0,0 +1,117 @@
+/**
+ * @file worker_pool_bench.cpp
+ * @brief Benchmark of the MPSC completion queue and the worker pool's submit/steal/drain paths.
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Per-item costs: queue push/pop on one thread and with four producers, a
+ * batch of tiny jobs submitted from outside the pool, the same batch fanned
+ * out from inside a job (own-deque pushes plus steals), and a Submit(work,
+ * done) round trip through DrainCompletions. Thread counts above the
+ * machine's core count only measure contention, not scaling.
+ */
+
+#include "bench.h"
+#include "worker_pool.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+constexpr int kBatch = 10000;
+
+void WaitCount(const std::atomic<int>& count, int target)
+{
+    while (count.load(std::memory_order_acquire) != target)
+        std::this_thread::yield();
+}
+
+} // namespace
+
+int main()
+{
+    std::printf("worker_pool: %u hardware threads, costs per item (batches of %d)\n",
+        std::thread::hardware_concurrency(), kBatch);
+
+    // Queue alone
+    {
+        MpscQueue<uint64_t> q;
+        uint64_t v = 0;
+        double ns = Bench::Run("MpscQueue push+pop, one thread", [&]() {
+            for (int i = 0; i < kBatch; ++i)
+                q.Push(i);
+            while (q.TryPop(v))
+                Bench::DoNotOptimize(v);
+        }).nsPerIter;
+        std::printf("    (%.1f ns per item)\n", ns / kBatch);
+
+        ns = Bench::Run("MpscQueue 4 producers -> 1 consumer", [&]() {
+            std::vector<std::thread> producers;
+            for (int p = 0; p < 4; ++p)
+            {
+                producers.emplace_back([&q]()
+                {
+                    for (int i = 0; i < kBatch / 4; ++i)
+                        q.Push(i);
+                });
+            }
+            int got = 0;
+            while (got < kBatch)
+            {
+                while (q.TryPop(v))
+                    ++got;
+            }
+            for (auto& t : producers)
+                t.join();
+        }).nsPerIter;
+        std::printf("    (%.1f ns per item, thread start-up included)\n", ns / kBatch);
+    }
+
+    // Pool paths, at 1, 2 and 4 workers
+    for (unsigned threads : { 1u, 2u, 4u })
+    {
+        WorkerPool pool;
+        pool.Start(threads);
+        std::printf(" %u worker%s\n", threads, threads == 1 ? "" : "s");
+
+        std::atomic<int> ran{ 0 };
+        auto job = [&ran]() { ran.fetch_add(1, std::memory_order_release); };
+
+        double ns = Bench::Run("Submit from outside, run, wait", [&]() {
+            ran.store(0, std::memory_order_relaxed);
+            for (int i = 0; i < kBatch; ++i)
+                pool.Submit(job);
+            WaitCount(ran, kBatch);
+        }).nsPerIter;
+        std::printf("    (%.1f ns per job)\n", ns / kBatch);
+
+        ns = Bench::Run("Fan-out from a worker (own deque + steals)", [&]() {
+            ran.store(0, std::memory_order_relaxed);
+            pool.Submit([&]()
+            {
+                for (int i = 0; i < kBatch; ++i)
+                    pool.Submit(job);
+            });
+            WaitCount(ran, kBatch);
+        }).nsPerIter;
+        std::printf("    (%.1f ns per job)\n", ns / kBatch);
+
+        ns = Bench::Run("Submit(work, done) + DrainCompletions", [&]() {
+            int completed = 0;
+            for (int i = 0; i < kBatch; ++i)
+                pool.Submit([i]() { return i; }, [&completed](int) { ++completed; });
+            while (completed < kBatch)
+                pool.DrainCompletions();
+        }).nsPerIter;
+        std::printf("    (%.1f ns per round trip)\n", ns / kBatch);
+
+        pool.Stop();
+    }
+    return 0;
+}
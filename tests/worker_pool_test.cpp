@@ -0,0 +1,307 @@
+/**
+ * @file worker_pool_test.cpp
+ * @brief Tests for the work-stealing pool (submit, steal, drain, Stop) and its MPSC completion queue.
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Written to be deterministic under ThreadSanitizer (`make tsan`): tests
+ * wait on atomics with a deadline instead of sleeping, and each scenario is
+ * forced (a busy worker, a blocked job) rather than hoped for.
+ */
+
+#include "test.h"
+#include "worker_pool.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+// Spin (yielding) until pred() holds or the deadline passes
+template <typename Pred>
+bool WaitFor(Pred&& pred, unsigned timeoutMs = 10000)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (!pred())
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+            return false;
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// MpscQueue
+// ---------------------------------------------------------------------------
+
+TEST(QueueFifoSingleThread)
+{
+    MpscQueue<int> q;
+    int v = -1;
+    CHECK(q.Empty());
+    CHECK(!q.TryPop(v));
+    for (int i = 0; i < 100; ++i)
+        q.Push(i);
+    CHECK(!q.Empty());
+    for (int i = 0; i < 100; ++i)
+    {
+        CHECK(q.TryPop(v));
+        CHECK_EQ(v, i);
+    }
+    CHECK(!q.TryPop(v));
+    CHECK(q.Empty());
+}
+
+TEST(QueueDestructorFreesItems)
+{
+    // Items left in the queue are destroyed with it
+    auto tracker = std::make_shared<int>(0);
+    {
+        MpscQueue<std::shared_ptr<int>> q;
+        for (int i = 0; i < 10; ++i)
+            q.Push(tracker);
+        std::shared_ptr<int> one;
+        CHECK(q.TryPop(one));
+        CHECK_EQ(tracker.use_count(), 11);
+    }
+    CHECK_EQ(tracker.use_count(), 1);
+}
+
+TEST(QueueManyProducersKeepPerProducerOrder)
+{
+    constexpr uint32_t kProducers = 4;
+    constexpr uint32_t kEach = 20000;
+
+    MpscQueue<uint64_t> q;
+    std::vector<std::thread> producers;
+    for (uint32_t p = 0; p < kProducers; ++p)
+    {
+        producers.emplace_back([&q, p]()
+        {
+            for (uint32_t i = 0; i < kEach; ++i)
+                q.Push((static_cast<uint64_t>(p) << 32) | i);
+        });
+    }
+
+    // Consume while they push: each producer's items arrive in order
+    std::vector<uint32_t> next(kProducers, 0);
+    uint64_t v = 0;
+    uint32_t received = 0;
+    bool ordered = true;
+    bool done = WaitFor([&]()
+    {
+        while (q.TryPop(v))
+        {
+            uint32_t p = static_cast<uint32_t>(v >> 32);
+            ordered &= p < kProducers && static_cast<uint32_t>(v) == next[p];
+            if (p < kProducers)
+                next[p] = static_cast<uint32_t>(v) + 1;
+            ++received;
+        }
+        return received == kProducers * kEach;
+    });
+    for (auto& t : producers)
+        t.join();
+
+    CHECK(done);
+    CHECK(ordered);
+    CHECK(!q.TryPop(v));
+}
+
+// ---------------------------------------------------------------------------
+// WorkerPool
+// ---------------------------------------------------------------------------
+
+TEST(StartPicksThreadCount)
+{
+    WorkerPool pool;
+    CHECK(!pool.IsRunning());
+    pool.Start();
+    CHECK(pool.IsRunning());
+    CHECK(pool.GetThreadCount() >= 1 && pool.GetThreadCount() <= 4);
+    pool.Start(8);                                   // already running: ignored
+    CHECK(pool.GetThreadCount() <= 4);
+    CHECK(pool.Stop());
+    CHECK(!pool.IsRunning());
+    CHECK_EQ(pool.GetThreadCount(), 0u);
+
+    // Restart after a clean stop
+    pool.Start(3);
+    CHECK_EQ(pool.GetThreadCount(), 3u);
+    CHECK(pool.Stop());
+}
+
+TEST(SubmitRunsEveryJob)
+{
+    WorkerPool pool;
+    CHECK(!pool.Submit([]() {}));                    // not running yet
+    pool.Start(4);
+    CHECK(!pool.Submit(WorkerPool::Job()));          // empty job
+
+    std::atomic<int> ran{ 0 };
+    for (int i = 0; i < 2000; ++i)
+        CHECK(pool.Submit([&ran]() { ran.fetch_add(1, std::memory_order_relaxed); }));
+    CHECK(WaitFor([&]() { return ran.load() == 2000; }));
+    CHECK(pool.Stop());
+}
+
+TEST(IdleWorkersStealFromBusyOne)
+{
+    // The parent job stays on its worker until every child has run. Nested
+    // submits go to that worker's own deque, so the children can only
+    // finish by being stolen.
+    constexpr int kChildren = 64;
+    WorkerPool pool;
+    pool.Start(4);
+
+    std::atomic<int> done{ 0 };
+    std::atomic<bool> parentFinished{ false };
+    std::mutex idsLock;
+    std::set<std::thread::id> childThreads;
+    std::thread::id parentThread;
+
+    pool.Submit([&]()
+    {
+        parentThread = std::this_thread::get_id();
+        for (int i = 0; i < kChildren; ++i)
+        {
+            pool.Submit([&]()
+            {
+                {
+                    std::lock_guard<std::mutex> g(idsLock);
+                    childThreads.insert(std::this_thread::get_id());
+                }
+                done.fetch_add(1, std::memory_order_release);
+            });
+        }
+        WaitFor([&]() { return done.load(std::memory_order_acquire) == kChildren; });
+        parentFinished.store(true, std::memory_order_release);
+    });
+
+    CHECK(WaitFor([&]() { return parentFinished.load(std::memory_order_acquire); }));
+    CHECK_EQ(done.load(), kChildren);
+    {
+        std::lock_guard<std::mutex> g(idsLock);
+        CHECK(!childThreads.empty());
+        CHECK(childThreads.count(parentThread) == 0);
+    }
+    CHECK(pool.Stop());
+}
+
+TEST(CompletionsRunOnlyWhenDrained)
+{
+    WorkerPool pool;
+    pool.Start(2);
+
+    const std::thread::id self = std::this_thread::get_id();
+    std::atomic<int> worked{ 0 };
+    int sum = 0;                                     // touched by completions only
+    int voids = 0;
+    bool onDrainingThread = true;
+
+    for (int i = 1; i <= 100; ++i)
+    {
+        pool.Submit([i, &worked]() { worked.fetch_add(1); return i; },
+            [&](int r) { sum += r; onDrainingThread &= std::this_thread::get_id() == self; });
+        pool.Submit([&worked]() { worked.fetch_add(1); },
+            [&]() { ++voids; });
+    }
+    CHECK(WaitFor([&]() { return worked.load() == 200; }));
+    CHECK_EQ(sum, 0);                                // nothing runs until the drain
+
+    // A completion is posted just after its work; drain until all have come in
+    size_t drained = 0;
+    CHECK(WaitFor([&]() { drained += pool.DrainCompletions(); return drained == 200; }));
+    CHECK_EQ(sum, 5050);
+    CHECK_EQ(voids, 100);
+    CHECK(onDrainingThread);
+    CHECK_EQ(pool.DrainCompletions(), 0u);
+    CHECK(pool.Stop());
+}
+
+TEST(DiscardDropsCompletions)
+{
+    WorkerPool pool;
+    int ran = 0;
+    for (int i = 0; i < 5; ++i)
+        pool.PostToMain([&ran]() { ++ran; });
+    pool.PostToMain(WorkerPool::Job());              // ignored
+    pool.DiscardCompletions();
+    CHECK_EQ(pool.DrainCompletions(), 0u);
+    CHECK_EQ(ran, 0);
+}
+
+TEST(ThrowingJobsAreCounted)
+{
+    WorkerPool pool;
+    pool.Start(2);
+    std::atomic<int> after{ 0 };
+    for (int i = 0; i < 10; ++i)
+        pool.Submit([]() { throw std::runtime_error("job"); });
+    CHECK(WaitFor([&]() { return pool.GetFailedCount() == 10; }));
+
+    // The workers survive and keep taking jobs
+    for (int i = 0; i < 10; ++i)
+        pool.Submit([&after]() { after.fetch_add(1); });
+    CHECK(WaitFor([&]() { return after.load() == 10; }));
+
+    // A completion that throws is counted too, and the drain carries on
+    pool.PostToMain([]() { throw std::runtime_error("completion"); });
+    pool.PostToMain([&after]() { after.fetch_add(1); });
+    CHECK_EQ(pool.DrainCompletions(), 2u);
+    CHECK_EQ(pool.GetFailedCount(), 11u);
+    CHECK_EQ(after.load(), 11);
+    CHECK(pool.Stop());
+}
+
+TEST(StopDropsQueuedJobsAndJoins)
+{
+    // One worker held inside a job while more work queues up behind it; the
+    // job is released only once Stop has flipped the pool to not running
+    WorkerPool pool;
+    pool.Start(1);
+
+    std::atomic<bool> entered{ false };
+    std::atomic<int> queuedRan{ 0 };
+    pool.Submit([&]()
+    {
+        entered.store(true);
+        WaitFor([&]() { return !pool.IsRunning(); });
+    });
+    CHECK(WaitFor([&]() { return entered.load(); }));
+    for (int i = 0; i < 50; ++i)
+        pool.Submit([&queuedRan]() { queuedRan.fetch_add(1); });
+
+    CHECK(pool.Stop(true, 10000));
+    CHECK_EQ(queuedRan.load(), 0);
+    CHECK_EQ(pool.GetThreadCount(), 0u);
+    CHECK(!pool.Submit([]() {}));
+    CHECK(pool.Stop());                              // second Stop is a no-op
+}
+
+TEST(StopWakesSleepingWorkers)
+{
+    // Workers idle in their wait; Stop must wake and join all of them
+    for (int round = 0; round < 20; ++round)
+    {
+        WorkerPool pool;
+        pool.Start(4);
+        if (round % 2)
+            pool.Submit([]() {});
+        CHECK(pool.Stop(true, 10000));
+    }
+}
+
+TEST_MAIN()
@@ -0,0 +1,73 @@
+/**
+ * @file x86_decode_bench.cpp
+ * @brief Benchmark of the x86 length decoder and the hook relocator.
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Decode: a linear sweep over 64 KB of typical MSVC x86 code (the shape of
+ * the work a prologue or function-extent scan does). Relocate: one call per
+ * hook target, as Hooks::CommitBatch does while the game waits, for a plain
+ * prologue and for one that needs rel8 branches widened.
+ */
+
+#include "bench.h"
+#include "x86_decode.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+int main()
+{
+    const std::vector<std::vector<uint8_t>> pieces = {
+        { 0x55 }, { 0x8B, 0xEC }, { 0x83, 0xEC, 0x10 }, { 0x56 }, { 0x8B, 0xF1 },
+        { 0x6A, 0xFF }, { 0x64, 0xA1, 0x00, 0x00, 0x00, 0x00 }, { 0x8B, 0x44, 0x24, 0x04 },
+        { 0x8B, 0x84, 0x24, 0x00, 0x01, 0x00, 0x00 }, { 0xC7, 0x45, 0xFC, 0xFF, 0xFF, 0xFF, 0xFF },
+        { 0x85, 0xC9 }, { 0x33, 0xC0 }, { 0x0F, 0xB6, 0x44, 0x24, 0x04 }, { 0xD9, 0xEE },
+        { 0xF3, 0x0F, 0x10, 0x45, 0x08 }, { 0x74, 0x10 }, { 0xE8, 0x00, 0x01, 0x00, 0x00 },
+        { 0x0F, 0x84, 0x00, 0x01, 0x00, 0x00 }, { 0xC2, 0x08, 0x00 },
+    };
+
+    std::mt19937 rng(42);
+    std::vector<uint8_t> code;
+    size_t insns = 0;
+    while (code.size() < 64 * 1024)
+    {
+        const auto& piece = pieces[rng() % pieces.size()];
+        code.insert(code.end(), piece.begin(), piece.end());
+        ++insns;
+    }
+
+    std::printf("x86_decode: %zu instructions in %zu bytes\n", insns, code.size());
+
+    Bench::Run("Decode linear sweep (64 KB)", [&]() {
+        size_t pos = 0, count = 0;
+        X86::Insn insn;
+        while (pos < code.size())
+        {
+            size_t len = X86::Decode(code.data() + pos, code.size() - pos, insn);
+            pos += len ? len : 1;
+            ++count;
+        }
+        Bench::DoNotOptimize(count);
+    }, static_cast<double>(code.size()));
+
+    const uint8_t plain[] = { 0x55, 0x8B, 0xEC, 0x6A, 0xFF, 0x68, 0x78, 0x56, 0x34, 0x12 };
+    const uint8_t branchy[] = { 0x85, 0xC9, 0x74, 0x10, 0x8B, 0x01, 0xC3 };
+    uint8_t dst[64];
+
+    Bench::Run("Relocate plain prologue", [&]() {
+        X86::RelocResult r;
+        X86::Relocate(plain, sizeof(plain), 0x401000, X86::kJmpRel32Size, dst, sizeof(dst), 0x10000000, r);
+        Bench::DoNotOptimize(r);
+    });
+
+    Bench::Run("Relocate prologue with rel8 Jcc", [&]() {
+        X86::RelocResult r;
+        X86::Relocate(branchy, sizeof(branchy), 0x401000, X86::kJmpRel32Size, dst, sizeof(dst), 0x10000000, r);
+        Bench::DoNotOptimize(r);
+    });
+    return 0;
+}
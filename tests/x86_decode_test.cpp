@@ -0,0 +1,419 @@
+/**
+ * @file x86_decode_test.cpp
+ * @brief Tests for the x86 length decoder and the hook relocator, over MSVC x86 prologue shapes.
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "test.h"
+#include "x86_decode.h"
+#include "hook_prologues.h"
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+constexpr uint32_t kSrc = 0x00401000;   // where the "game" code lives
+constexpr uint32_t kDst = 0x10000000;   // where the trampoline lives
+constexpr size_t   kHook = X86::kJmpRel32Size;
+
+// Longest stolen window the hook engine allows (inline_hook.h kMaxStolen)
+constexpr size_t kMaxStolen = 5 + 15 - 1;
+
+struct Prologue
+{
+    const char*          name;
+    std::vector<uint8_t> bytes;
+    size_t               consumed;   // whole instructions covering >= 5 bytes
+};
+
+// Entry sequences MSVC emits for 32-bit code: frame setup, hot-patch pad, SEH
+// frames, thiscall loads and globals. These are synthetic shapes with
+// placeholder operands (0x11223344 and the like), not bytes captured from
+// eqgame.exe; real prologues of the hooked functions go in hook_prologues.h.
+// None has a relative branch, so the relocated copy must be byte-identical.
+const std::vector<Prologue>& Prologues()
+{
+    static const std::vector<Prologue> s_prologues = {
+        { "push ebp / mov ebp,esp / sub esp,imm8",  { 0x55, 0x8B, 0xEC, 0x83, 0xEC, 0x10, 0x56 }, 6 },
+        { "hot-patch mov edi,edi",                  { 0x8B, 0xFF, 0x55, 0x8B, 0xEC, 0x51 }, 5 },
+        { "frame + SEH push -1",                    { 0x55, 0x8B, 0xEC, 0x6A, 0xFF, 0x68, 0x78, 0x56, 0x34, 0x12 }, 5 },
+        { "SEH push -1 / push handler",             { 0x6A, 0xFF, 0x68, 0x78, 0x56, 0x34, 0x12, 0x64, 0xA1, 0, 0, 0, 0 }, 7 },
+        { "sub esp,imm8 / push ebx / push ebp",     { 0x83, 0xEC, 0x0C, 0x53, 0x55, 0x56 }, 5 },
+        { "mov eax,[esp+4] / push esi (thiscall)",  { 0x8B, 0x44, 0x24, 0x04, 0x56, 0x8B, 0xF1 }, 5 },
+        { "sub esp,imm32",                          { 0x81, 0xEC, 0x04, 0x01, 0x00, 0x00, 0x53 }, 6 },
+        { "mov eax,[abs32]",                        { 0xA1, 0x44, 0x33, 0x22, 0x11, 0x85, 0xC0 }, 5 },
+        { "mov eax,fs:[0]",                         { 0x64, 0xA1, 0x00, 0x00, 0x00, 0x00, 0x6A, 0xFF }, 6 },
+        { "push ebx / mov ebx,[esp+8]",             { 0x53, 0x8B, 0x5C, 0x24, 0x08, 0x55 }, 5 },
+        { "fldz / push esi / mov esi,ecx",          { 0xD9, 0xEE, 0x56, 0x8B, 0xF1, 0x57 }, 5 },
+        { "movzx eax,byte [esp+4]",                 { 0x0F, 0xB6, 0x44, 0x24, 0x04, 0xC3 }, 5 },
+        { "mov ecx,[abs32] (global this)",          { 0x8B, 0x0D, 0x44, 0x33, 0x22, 0x11, 0xE8 }, 6 },
+        { "push esi / push edi / mov edi,ecx",      { 0x56, 0x57, 0x8B, 0xF9, 0x33, 0xF6, 0x39 }, 6 },
+        { "cmp byte [ecx+disp32],imm8",             { 0x80, 0xB9, 0x10, 0x02, 0x00, 0x00, 0x00, 0x74 }, 7 },
+    };
+    return s_prologues;
+}
+
+bool Reloc(const std::vector<uint8_t>& src, uint8_t* dst, size_t dstCap, X86::RelocResult& r)
+{
+    return X86::Relocate(src.data(), src.size(), kSrc, kHook, dst, dstCap, kDst, r);
+}
+
+// Condition code of a Jcc (7x rel8 or 0F 8x rel32); -1 for anything else
+int Condition(const uint8_t* code, const X86::Insn& insn)
+{
+    const uint8_t* op = code + insn.opcodeOffset;
+    if ((op[0] & 0xF0) == 0x70)
+        return op[0] & 0x0F;
+    if (op[0] == 0x0F && (op[1] & 0xF0) == 0x80)
+        return op[1] & 0x0F;
+    return -1;
+}
+
+// Walk the source and the relocated copy side by side: plain instructions
+// must be copied verbatim, branches must decode and reach the same target.
+bool SameBehaviour(const uint8_t* src, size_t srcAvail, const uint8_t* dst, const X86::RelocResult& r)
+{
+    size_t in = 0, out = 0;
+    while (out < r.produced)
+    {
+        X86::Insn a, b;
+        if (!X86::Decode(src + in, srcAvail - in, a) || !X86::Decode(dst + out, r.produced - out, b))
+            return false;
+        if (a.relSize)
+        {
+            if (b.relSize != 4 || b.flow != a.flow || Condition(src + in, a) != Condition(dst + out, b) ||
+                X86::BranchTarget(src + in, a, kSrc + static_cast<uint32_t>(in)) !=
+                X86::BranchTarget(dst + out, b, kDst + static_cast<uint32_t>(out)))
+            {
+                return false;
+            }
+        }
+        else if (a.length != b.length || memcmp(src + in, dst + out, a.length) != 0)
+        {
+            return false;
+        }
+        in += a.length;
+        out += b.length;
+    }
+    return out == r.produced && in <= r.consumed;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Decoder
+// ---------------------------------------------------------------------------
+
+TEST(DecodeLengths)
+{
+    struct Case { std::vector<uint8_t> bytes; size_t length; };
+    const Case cases[] = {
+        { { 0x55 }, 1 },                                            // push ebp
+        { { 0x8B, 0xEC }, 2 },                                      // mov ebp,esp
+        { { 0x83, 0xEC, 0x10 }, 3 },                                // sub esp,10h
+        { { 0x81, 0xEC, 0x00, 0x01, 0x00, 0x00 }, 6 },              // sub esp,100h
+        { { 0x8B, 0x44, 0x24, 0x04 }, 4 },                          // mov eax,[esp+4] (SIB + disp8)
+        { { 0x8B, 0x84, 0x24, 0x00, 0x01, 0x00, 0x00 }, 7 },        // mov eax,[esp+100h] (SIB + disp32)
+        { { 0x8B, 0x04, 0x85, 0x00, 0x10, 0x40, 0x00 }, 7 },        // mov eax,[eax*4+401000h] (SIB, no base)
+        { { 0xC7, 0x45, 0xFC, 0xFF, 0xFF, 0xFF, 0xFF }, 7 },        // mov dword [ebp-4],-1
+        { { 0x66, 0xC7, 0x45, 0xFC, 0x01, 0x00 }, 6 },              // mov word [ebp-4],1 (imm16)
+        { { 0x64, 0xA1, 0x00, 0x00, 0x00, 0x00 }, 6 },              // mov eax,fs:[0]
+        { { 0xF6, 0x41, 0x10, 0x01 }, 4 },                          // test byte [ecx+10h],1 (group 3 imm8)
+        { { 0xF7, 0xD8 }, 2 },                                      // neg eax (group 3, no imm)
+        { { 0x0F, 0xB6, 0xC0 }, 3 },                                // movzx eax,al
+        { { 0xF3, 0x0F, 0x10, 0x45, 0x08 }, 5 },                    // movss xmm0,[ebp+8]
+        { { 0x66, 0x0F, 0x3A, 0x0F, 0xC1, 0x08 }, 6 },              // palignr xmm0,xmm1,8
+        { { 0xC2, 0x08, 0x00 }, 3 },                                // ret 8
+        { { 0xE8, 0x00, 0x00, 0x00, 0x00 }, 5 },                    // call rel32
+        { { 0x0F, 0x84, 0x00, 0x00, 0x00, 0x00 }, 6 },              // je rel32
+        { { 0x0F, 0x20, 0xC0 }, 3 },                                // mov eax,cr0 (ModRM is register-only)
+    };
+    for (const Case& c : cases)
+    {
+        X86::Insn insn;
+        CHECK_EQ(X86::Decode(c.bytes.data(), c.bytes.size(), insn), c.length);
+    }
+}
+
+TEST(DecodeRejectsTruncatedAndVex)
+{
+    const uint8_t truncated[] = { 0x81, 0xEC, 0x00, 0x01 };
+    const uint8_t vex[] = { 0xC5, 0xF8, 0x77 };                     // vzeroupper
+    X86::Insn insn;
+    CHECK_EQ(X86::Decode(truncated, sizeof(truncated), insn), 0u);
+    CHECK_EQ(X86::Decode(vex, sizeof(vex), insn), 0u);
+}
+
+TEST(DecodeBranchFields)
+{
+    const uint8_t jcc8[] = { 0x74, 0x10 };
+    X86::Insn insn;
+    CHECK_EQ(X86::Decode(jcc8, sizeof(jcc8), insn), 2u);
+    CHECK_EQ(insn.relSize, 1);
+    CHECK(insn.flow == X86::Flow::Branch);
+    CHECK_EQ(X86::BranchTarget(jcc8, insn, kSrc), kSrc + 2 + 0x10);
+
+    const uint8_t back[] = { 0xEB, 0xFE };                          // jmp $
+    CHECK_EQ(X86::Decode(back, sizeof(back), insn), 2u);
+    CHECK(insn.flow == X86::Flow::Jump);
+    CHECK_EQ(X86::BranchTarget(back, insn, kSrc), kSrc);
+}
+
+// ---------------------------------------------------------------------------
+// Relocator
+// ---------------------------------------------------------------------------
+
+TEST(RelocateProloguesVerbatim)
+{
+    for (const Prologue& p : Prologues())
+    {
+        uint8_t dst[64];
+        X86::RelocResult r;
+        const bool ok = Reloc(p.bytes, dst, sizeof(dst), r);
+        CHECK(ok);
+        if (!ok)
+        {
+            std::printf("    %s: %s\n", p.name, X86::RelocErrorName(r.error));
+            continue;
+        }
+        CHECK_EQ(r.consumed, p.consumed);
+        CHECK_EQ(r.produced, p.consumed);
+        CHECK(memcmp(dst, p.bytes.data(), p.consumed) == 0);
+    }
+}
+
+TEST(RelocateHookedPrologues)
+{
+    // Captured entries only; see hook_prologues.h for the ones still missing
+    size_t captured = 0;
+    for (const HookPrologue& p : HookPrologues())
+    {
+        if (p.bytes.empty())
+            continue;
+        ++captured;
+        uint8_t dst[64];
+        X86::RelocResult r;
+        const bool ok = Reloc(p.bytes, dst, sizeof(dst), r);
+        CHECK(ok);
+        if (!ok)
+        {
+            std::printf("    %s: %s\n", p.hook, X86::RelocErrorName(r.error));
+            continue;
+        }
+        CHECK(r.consumed >= kHook && r.consumed <= kMaxStolen);
+        CHECK(r.produced <= X86::MaxRelocatedSize(r.consumed));
+        CHECK(SameBehaviour(p.bytes.data(), p.bytes.size(), dst, r));
+    }
+    std::printf("    %zu of %zu hooked prologues captured\n", captured, HookPrologues().size());
+}
+
+TEST(WidenJccRel8)
+{
+    // test ecx,ecx / je +10h / mov eax,[ecx]
+    const std::vector<uint8_t> src = { 0x85, 0xC9, 0x74, 0x10, 0x8B, 0x01, 0xC3 };
+    uint8_t dst[64];
+    X86::RelocResult r;
+    CHECK(Reloc(src, dst, sizeof(dst), r));
+    CHECK_EQ(r.consumed, 6u);
+    CHECK_EQ(r.produced, 2u + 6u + 2u);
+    CHECK_EQ(dst[2], 0x0F);
+    CHECK_EQ(dst[3], 0x84);
+    CHECK(SameBehaviour(src.data(), src.size(), dst, r));
+
+    X86::Insn insn;
+    X86::Decode(dst + 2, r.produced - 2, insn);
+    CHECK_EQ(X86::BranchTarget(dst + 2, insn, kDst + 2), kSrc + 4 + 0x10);
+}
+
+TEST(WidenJmpRel8)
+{
+    // jmp short +10h, then INT3 padding up to the hook size
+    const std::vector<uint8_t> src = { 0xEB, 0x10, 0xCC, 0xCC, 0xCC, 0xCC };
+    uint8_t dst[64];
+    X86::RelocResult r;
+    CHECK(Reloc(src, dst, sizeof(dst), r));
+    CHECK_EQ(r.consumed, kHook);
+    CHECK_EQ(r.produced, X86::kJmpRel32Size);
+    CHECK_EQ(dst[0], 0xE9);
+    CHECK(SameBehaviour(src.data(), src.size(), dst, r));
+}
+
+TEST(WidenKeepsBranchHintPrefix)
+{
+    // ds: (branch-taken hint) jne -> 3E 0F 85 rel32
+    const std::vector<uint8_t> src = { 0x3E, 0x75, 0x20, 0x33, 0xC0, 0xC3 };
+    uint8_t dst[64];
+    X86::RelocResult r;
+    CHECK(Reloc(src, dst, sizeof(dst), r));
+    CHECK_EQ(dst[0], 0x3E);
+    CHECK_EQ(dst[1], 0x0F);
+    CHECK_EQ(dst[2], 0x85);
+    CHECK(SameBehaviour(src.data(), src.size(), dst, r));
+}
+
+TEST(RebaseRel32)
+{
+    // call rel32 / jmp rel32 thunks keep their absolute targets
+    const std::vector<uint8_t> call = { 0xE8, 0x00, 0x01, 0x00, 0x00, 0x90 };
+    const std::vector<uint8_t> thunk = { 0xE9, 0xFB, 0xEF, 0xFF, 0xFF, 0xCC };
+    for (const auto* src : { &call, &thunk })
+    {
+        uint8_t dst[64];
+        X86::RelocResult r;
+        CHECK(Reloc(*src, dst, sizeof(dst), r));
+        CHECK_EQ(r.consumed, 5u);
+        CHECK_EQ(r.produced, 5u);
+        CHECK(SameBehaviour(src->data(), src->size(), dst, r));
+    }
+}
+
+TEST(RejectBranchIntoStolenBytes)
+{
+    const std::vector<std::vector<uint8_t>> cases = {
+        { 0x74, 0x01, 0x90, 0x90, 0x90, 0x90 },          // je forward over one stolen byte
+        { 0x85, 0xC9, 0x74, 0xFD, 0x90, 0x90 },          // je back to offset 1
+        { 0x90, 0x0F, 0x85, 0xFA, 0xFF, 0xFF, 0xFF },    // jne rel32 back to offset 1
+    };
+    for (const auto& src : cases)
+    {
+        uint8_t dst[64];
+        X86::RelocResult r;
+        CHECK(!Reloc(src, dst, sizeof(dst), r));
+        CHECK(r.error == X86::RelocError::BranchInside);
+    }
+}
+
+TEST(BranchToEntryIsAllowed)
+{
+    // A loop back to the first byte re-enters through the hook, which is fine
+    const std::vector<uint8_t> src = { 0x33, 0xC0, 0x74, 0xFC, 0x90, 0x90 };
+    uint8_t dst[64];
+    X86::RelocResult r;
+    CHECK(Reloc(src, dst, sizeof(dst), r));
+    CHECK(SameBehaviour(src.data(), src.size(), dst, r));
+}
+
+TEST(RefuseLoopJecxzRel16)
+{
+    const std::vector<std::vector<uint8_t>> cases = {
+        { 0xE2, 0x10, 0x90, 0x90, 0x90 },                // loop
+        { 0xE1, 0x10, 0x90, 0x90, 0x90 },                // loope
+        { 0xE3, 0x10, 0x90, 0x90, 0x90 },                // jecxz
+        { 0x66, 0xE9, 0x10, 0x00, 0x90 },                // jmp rel16
+        { 0x66, 0x0F, 0x84, 0x10, 0x00 },                // je rel16
+        { 0x66, 0xE8, 0x10, 0x00, 0x90 },                // call rel16
+    };
+    for (const auto& src : cases)
+    {
+        uint8_t dst[64];
+        X86::RelocResult r;
+        CHECK(!Reloc(src, dst, sizeof(dst), r));
+        CHECK(r.error == X86::RelocError::Unsupported);
+    }
+}
+
+TEST(TooShort)
+{
+    // xor eax,eax / ret, then the next function's code: the JMP would eat it
+    const std::vector<uint8_t> next = { 0x33, 0xC0, 0xC3, 0x55, 0x8B };
+    // ret at the very end of readable memory
+    const std::vector<uint8_t> edge = { 0x33, 0xC0, 0xC3 };
+    for (const auto* src : { &next, &edge })
+    {
+        uint8_t dst[64];
+        X86::RelocResult r;
+        CHECK(!Reloc(*src, dst, sizeof(dst), r));
+        CHECK(r.error == X86::RelocError::TooShort);
+    }
+
+    // Same function followed by INT3 padding is fine: only the real code is copied
+    const std::vector<uint8_t> padded = { 0x33, 0xC0, 0xC3, 0xCC, 0xCC, 0xCC };
+    uint8_t dst[64];
+    X86::RelocResult r;
+    CHECK(Reloc(padded, dst, sizeof(dst), r));
+    CHECK_EQ(r.consumed, kHook);
+    CHECK_EQ(r.produced, 3u);
+}
+
+TEST(NoSpace)
+{
+    const std::vector<uint8_t> src = { 0x85, 0xC9, 0x74, 0x10, 0x8B, 0x01 };
+    uint8_t dst[64];
+    X86::RelocResult r;
+    CHECK(!Reloc(src, dst, 7, r));                   // widened je needs 2 + 6
+    CHECK(r.error == X86::RelocError::NoSpace);
+}
+
+TEST(MaxRelocatedSizeBound)
+{
+    // Worst case: every stolen byte is part of a rel8 branch that triples
+    const std::vector<uint8_t> jccs = { 0x74, 0x40, 0x75, 0x40, 0x7C, 0x40, 0xCC };
+    uint8_t dst[64];
+    X86::RelocResult r;
+    CHECK(Reloc(jccs, dst, sizeof(dst), r));
+    CHECK_EQ(r.consumed, 6u);
+    CHECK_EQ(r.produced, X86::MaxRelocatedSize(r.consumed));
+
+    // Longest window: 4 bytes, then a 15-byte instruction split by the JMP
+    const std::vector<uint8_t> longest = {
+        0x90, 0x90, 0x90, 0x90,
+        0x2E, 0x2E, 0x2E, 0x2E, 0x81, 0x84, 0x24, 0x00, 0x01, 0x00, 0x00, 0x78, 0x56, 0x34, 0x12,
+    };
+    CHECK(Reloc(longest, dst, sizeof(dst), r));
+    CHECK_EQ(r.consumed, kMaxStolen);
+    CHECK(r.produced <= X86::MaxRelocatedSize(kMaxStolen));
+}
+
+TEST(RandomPrologueMix)
+{
+    // Splice instructions from the fixtures with random rel8/rel32 branches;
+    // whatever the relocator accepts must fit the bound and behave the same.
+    const std::vector<std::vector<uint8_t>> pieces = {
+        { 0x55 }, { 0x8B, 0xEC }, { 0x83, 0xEC, 0x10 }, { 0x56 }, { 0x8B, 0xF1 },
+        { 0x6A, 0xFF }, { 0x64, 0xA1, 0x00, 0x00, 0x00, 0x00 }, { 0x8B, 0x44, 0x24, 0x04 },
+        { 0x85, 0xC9 }, { 0x33, 0xC0 }, { 0x0F, 0xB6, 0x44, 0x24, 0x04 }, { 0xD9, 0xEE },
+        { 0x74, 0x00 }, { 0x75, 0x00 }, { 0xEB, 0x00 }, { 0xE8, 0, 0, 0, 0 }, { 0x0F, 0x84, 0, 0, 0, 0 },
+        { 0xC3 }, { 0xCC }, { 0xE2, 0x00 }, { 0x66, 0xE9, 0x00, 0x00 },
+    };
+
+    std::mt19937 rng(0x5EED);
+    size_t accepted = 0;
+    for (int iter = 0; iter < 200000; ++iter)
+    {
+        std::vector<uint8_t> src;
+        while (src.size() < 24)
+        {
+            std::vector<uint8_t> piece = pieces[rng() % pieces.size()];
+            if (piece.size() == 2 && (piece[0] & 0xF0) == 0x70)
+                piece[1] = static_cast<uint8_t>(rng());
+            else if (piece[0] == 0xEB || piece[0] == 0xE2)
+                piece[1] = static_cast<uint8_t>(rng());
+            else if (piece[0] == 0xE8 || (piece[0] == 0x0F && piece[1] == 0x84))
+            {
+                uint32_t rel = static_cast<uint32_t>(static_cast<int32_t>(rng() % 64) - 32);
+                memcpy(piece.data() + piece.size() - 4, &rel, 4);
+            }
+            src.insert(src.end(), piece.begin(), piece.end());
+        }
+
+        uint8_t dst[64];
+        X86::RelocResult r;
+        if (!Reloc(src, dst, sizeof(dst), r))
+            continue;
+        ++accepted;
+        CHECK(r.consumed >= kHook);
+        CHECK(r.produced <= X86::MaxRelocatedSize(r.consumed));
+        CHECK(SameBehaviour(src.data(), src.size(), dst, r));
+        if (Test::Failures())
+            return;
+    }
+    CHECK(accepted > 1000);
+}
+
+TEST_MAIN()
@@ -0,0 +1,169 @@
+/**
+ * @file blog_decode.cpp
+ * @brief Offline decoder for dinput8_proxy.blog — turns the binary deferred-format
+ *        log back into the same text lines dinput8_proxy.log contains.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Standalone and portable (no Windows headers). Build:
+ *   Linux:   g++ -std=c++20 -O2 -o blog_decode tools/blog_decode.cpp
+ *   Windows: cl /std:c++20 /O2 /EHsc tools\blog_decode.cpp
+ *
+ * Usage:
+ *   blog_decode <dinput8_proxy.blog> [output.log]
+ * Writes to stdout when no output file is given. Timestamps are rendered in
+ * the local time zone of the machine running the decoder.
+ */
+
+#include "../log_format.h"
+
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+static bool ReadFile(const char* path, std::vector<uint8_t>& out)
+{
+    FILE* f = fopen(path, "rb");
+    if (!f)
+        return false;
+
+    uint8_t chunk[65536];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0)
+        out.insert(out.end(), chunk, chunk + n);
+    fclose(f);
+    return true;
+}
+
+static void AppendStamp(std::string& line, uint32_t stamp)
+{
+    time_t t = static_cast<time_t>(stamp);
+    struct tm local = {};
+#ifdef _WIN32
+    localtime_s(&local, &t);
+#else
+    localtime_r(&t, &local);
+#endif
+    char buf[80];
+    snprintf(buf, sizeof(buf), "[%04d-%02d-%02d %02d:%02d:%02d] ",
+        local.tm_year + 1900, local.tm_mon + 1, local.tm_mday,
+        local.tm_hour, local.tm_min, local.tm_sec);
+    line += buf;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2 || argc > 3)
+    {
+        fprintf(stderr, "usage: %s <dinput8_proxy.blog> [output.log]\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<uint8_t> data;
+    if (!ReadFile(argv[1], data))
+    {
+        fprintf(stderr, "blog_decode: cannot read '%s'\n", argv[1]);
+        return 1;
+    }
+
+    BlogFormat::FileHeader header;
+    if (data.size() < sizeof(header))
+    {
+        fprintf(stderr, "blog_decode: '%s' is too small to be a .blog file\n", argv[1]);
+        return 1;
+    }
+    memcpy(&header, data.data(), sizeof(header));
+    if (memcmp(header.magic, BlogFormat::kMagic, sizeof(header.magic)) != 0)
+    {
+        fprintf(stderr, "blog_decode: '%s' has no BLOG signature\n", argv[1]);
+        return 1;
+    }
+    if (header.version != BlogFormat::kVersion)
+    {
+        fprintf(stderr, "blog_decode: unsupported version %u (expected %u)\n",
+            header.version, BlogFormat::kVersion);
+        return 1;
+    }
+
+    FILE* out = stdout;
+    if (argc == 3)
+    {
+        out = fopen(argv[2], "w");
+        if (!out)
+        {
+            fprintf(stderr, "blog_decode: cannot create '%s'\n", argv[2]);
+            return 1;
+        }
+    }
+
+    std::unordered_map<uint32_t, std::string> formats;
+    std::string line;
+    size_t records = 0;
+    size_t pos = sizeof(header);
+
+    while (pos + sizeof(BlogFormat::RecordHeader) <= data.size())
+    {
+        BlogFormat::RecordHeader rec;
+        memcpy(&rec, data.data() + pos, sizeof(rec));
+        pos += sizeof(rec);
+
+        if (pos + rec.size > data.size())
+        {
+            // Truncated tail — the process died mid-write.
+            fprintf(stderr, "blog_decode: truncated record at offset %zu\n", pos - sizeof(rec));
+            break;
+        }
+        const uint8_t* payload = data.data() + pos;
+        pos += rec.size;
+
+        switch (static_cast<BlogFormat::RecordKind>(rec.kind))
+        {
+        case BlogFormat::RecordKind::FormatDef:
+            formats[rec.formatId].assign(reinterpret_cast<const char*>(payload), rec.size);
+            continue;
+
+        case BlogFormat::RecordKind::Text:
+            line.clear();
+            AppendStamp(line, rec.stamp);
+            line.append(reinterpret_cast<const char*>(payload), rec.size);
+            break;
+
+        case BlogFormat::RecordKind::Format:
+        {
+            line.clear();
+            AppendStamp(line, rec.stamp);
+            auto it = formats.find(rec.formatId);
+            if (it == formats.end())
+            {
+                char buf[64];
+                snprintf(buf, sizeof(buf), "<unknown format 0x%08X>", rec.formatId);
+                line += buf;
+            }
+            else
+            {
+                BlogFormat::Render(line, it->second, payload, rec.size, header.pointerSize);
+            }
+            break;
+        }
+
+        default:
+            fprintf(stderr, "blog_decode: unknown record kind %u at offset %zu\n",
+                rec.kind, pos - rec.size - sizeof(rec));
+            continue;
+        }
+
+        line.push_back('\n');
+        fwrite(line.data(), 1, line.size(), out);
+        ++records;
+    }
+
+    if (out != stdout)
+        fclose(out);
+
+    fprintf(stderr, "blog_decode: %zu records, %zu format strings\n", records, formats.size());
+    return 0;
+}
@@ -0,0 +1,292 @@
+/**
+ * @file offset_gen.cpp
+ * @brief Offline offset resolver — scans an eqgame.exe on disk with the signatures
+ *        from signatures.h and emits the resolved addresses ahead of time.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Runs the same one-pass scan Offsets::ResolveAll() does in-process, but on a
+ * memory-mapped copy of the executable, so the game never has to scan.
+ * Two outputs:
+ *
+ *   -H <file>  offsets_generated.h — `#define SIG_<name>_x` constants at the
+ *              preferred image base, plus a table in Sig order. When this
+ *              header is present in the source tree, offsets.cpp compiles it
+ *              in and uses it directly if the running client's headers match.
+ *   -c <file>  dinput8_offsets.cache — the same binary table the DLL writes
+ *              after a scan. Drop it in the game directory and the first
+ *              launch is already a table load.
+ *
+ * With neither option the resolved table is printed to stdout. Entries with
+ * no pattern, or whose pattern does not match exactly once, are reported and
+ * left to the DLL's fixed fallback addresses.
+ *
+ * Portable (no Windows or eqlib headers). Build from the repo root:
+ *   Linux:   g++ -std=c++20 -O2 -pthread -o offset_gen tools/offset_gen.cpp
+ *                pe_image.cpp mapped_file.cpp sig_scan.cpp multi_scan.cpp
+ *   Windows: cl /std:c++20 /O2 /EHsc tools\offset_gen.cpp pe_image.cpp
+ *                mapped_file.cpp sig_scan.cpp multi_scan.cpp
+ *
+ * Usage:
+ *   offset_gen <eqgame.exe> [-H offsets_generated.h] [-c dinput8_offsets.cache]
+ * Exit code is 0 when every entry with a pattern resolved, 1 otherwise.
+ */
+
+#include "../mapped_file.h"
+#include "../multi_scan.h"
+#include "../offset_cache.h"
+#include "../pe_image.h"
+#include "../signatures.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+constexpr size_t kSigCount = static_cast<size_t>(Sig::Count);
+
+struct Resolved
+{
+    uint32_t rva = 0;   // 0 = unresolved
+    size_t   hits = 0;
+};
+
+// Same rules as Offsets::ScanAll: exactly one hit, then offset and optional
+// rel32 follow — computed in RVA space since the file isn't mapped at its base.
+static void ScanImage(const PE::Image& image, const PE::Section& text, std::vector<Resolved>& out)
+{
+    out.assign(kSigCount, {});
+
+    // Raw data is padded to the file alignment; only the virtual size is code
+    std::span<const uint8_t> bytes = image.SectionData(text);
+    if (text.virtualSize && text.virtualSize < bytes.size())
+        bytes = bytes.first(text.virtualSize);
+
+    SigScan::MultiScanner scanner;
+    size_t patterns = 0;
+    for (const SigDef& def : kSigDefs)
+    {
+        SigScan::Pattern pattern;
+        if (def.pattern && !pattern.Parse(def.pattern))
+            fprintf(stderr, "warning: '%s' has a malformed pattern\n", def.name);
+        if (!pattern.Empty())
+            ++patterns;
+        scanner.Add(pattern);
+    }
+    if (!patterns)
+        return;
+    scanner.Build();
+
+    std::vector<std::vector<size_t>> hits;
+    scanner.Scan(bytes, hits, 2, 0);
+
+    for (size_t i = 0; i < kSigCount; ++i)
+    {
+        const SigDef& def = kSigDefs[i];
+        out[i].hits = hits[i].size();
+        if (!def.pattern || hits[i].size() != 1)
+            continue;
+
+        uint32_t rva = text.rva + static_cast<uint32_t>(hits[i][0]) + def.offset;
+        if (def.kind == SigKind::Rel32)
+        {
+            const uint8_t* operand = image.RvaToPtr(rva, 4);
+            if (!operand)
+                continue;
+            int32_t rel;
+            memcpy(&rel, operand, sizeof(rel));
+            rva = rva + 4 + rel;
+        }
+        out[i].rva = rva;
+    }
+}
+
+static bool WriteHeader(const char* path, const PE::Image& image, const char* exeName,
+    uint64_t imageKey, const std::vector<Resolved>& table)
+{
+    FILE* f = fopen(path, "w");
+    if (!f)
+        return false;
+
+    for (const char* p = exeName; *p; ++p)
+    {
+        if (*p == '/' || *p == '\\')
+            exeName = p + 1;
+    }
+
+    fprintf(f,
+        "/**\n"
+        " * @file offsets_generated.h\n"
+        " * @brief Generated by tools/offset_gen from %s — do not edit.\n"
+        " *\n"
+        " * Addresses are at the preferred image base (0x%08X), like the eqlib _x\n"
+        " * offsets. offsets.cpp uses this table only when the running client's\n"
+        " * PE headers and signatures.h match the keys below.\n"
+        " */\n\n"
+        "#pragma once\n\n"
+        "#include <cstdint>\n\n",
+        exeName, image.ImageBase());
+
+    for (size_t i = 0; i < kSigCount; ++i)
+    {
+        if (table[i].rva)
+            fprintf(f, "#define SIG_%s_x 0x%08X\n", kSigDefs[i].name, image.ImageBase() + table[i].rva);
+        else
+            fprintf(f, "// SIG_%s_x unresolved — fixed fallback\n", kSigDefs[i].name);
+    }
+
+    fprintf(f,
+        "\nnamespace OffsetsGenerated\n{\n\n"
+        "inline constexpr uint64_t kImageKey = 0x%016llXull;\n"
+        "inline constexpr uint64_t kDefsHash = 0x%016llXull;\n\n"
+        "// Sig order; 0 = unresolved\n"
+        "inline constexpr uintptr_t kAddresses[] = {\n",
+        static_cast<unsigned long long>(imageKey),
+        static_cast<unsigned long long>(OffsetCache::DefinitionsHash()));
+    for (size_t i = 0; i < kSigCount; ++i)
+    {
+        if (table[i].rva)
+            fprintf(f, "    SIG_%s_x,\n", kSigDefs[i].name);
+        else
+            fprintf(f, "    0,\n");
+    }
+    fprintf(f, "};\n\n} // namespace OffsetsGenerated\n");
+
+    return fclose(f) == 0;
+}
+
+static bool WriteCache(const char* path, const PE::Image& image, uint64_t imageKey,
+    const std::vector<Resolved>& table)
+{
+    std::vector<OffsetCache::Entry> entries(kSigCount);
+    for (size_t i = 0; i < kSigCount; ++i)
+    {
+        OffsetCache::Entry& c = entries[i];
+        c = {};
+        const uint8_t* at = table[i].rva ? image.RvaToPtr(table[i].rva, OffsetCache::kCheckBytes) : nullptr;
+        if (!at)
+            continue;
+        c.rva = table[i].rva;
+        c.source = static_cast<uint8_t>(OffsetCache::EntrySource::Signature);
+        memcpy(c.check, at, OffsetCache::kCheckBytes);
+    }
+    return OffsetCache::Write(path, imageKey, entries);
+}
+
+// The DLL compares check bytes against live memory. A HIGHLOW fixup inside
+// that window changes if the loader rebases the image, which just costs a
+// rescan — but it's worth knowing about.
+static void WarnRelocatedChecks(const PE::Image& image, const std::vector<Resolved>& table)
+{
+    std::vector<uint32_t> relocs;
+    image.Relocations(relocs);
+    std::sort(relocs.begin(), relocs.end());
+
+    for (size_t i = 0; i < kSigCount; ++i)
+    {
+        uint32_t rva = table[i].rva;
+        if (!rva)
+            continue;
+        // A 4-byte fixup at r overlaps [rva, rva + kCheckBytes) when r + 4 > rva
+        auto it = std::lower_bound(relocs.begin(), relocs.end(), rva > 3 ? rva - 3 : 0);
+        if (it != relocs.end() && *it < rva + OffsetCache::kCheckBytes)
+            fprintf(stderr, "note: '%s' check bytes contain a relocation — the cache only holds at the preferred base\n",
+                kSigDefs[i].name);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const char* exePath = nullptr;
+    const char* headerPath = nullptr;
+    const char* cachePath = nullptr;
+    bool badArgs = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "-H") == 0 && i + 1 < argc)
+            headerPath = argv[++i];
+        else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc)
+            cachePath = argv[++i];
+        else if (!exePath && argv[i][0] != '-')
+            exePath = argv[i];
+        else
+            badArgs = true;
+    }
+    if (!exePath || badArgs)
+    {
+        fprintf(stderr, "usage: offset_gen <eqgame.exe> [-H offsets_generated.h] [-c dinput8_offsets.cache]\n");
+        return 2;
+    }
+
+    MappedFile file;
+    if (!file.Open(exePath))
+    {
+        fprintf(stderr, "cannot open %s\n", exePath);
+        return 2;
+    }
+
+    PE::Image image;
+    const PE::Section* text = nullptr;
+    if (!image.Parse(file.Data(), PE::Layout::File) || !(text = image.FindSection(".text")))
+    {
+        fprintf(stderr, "%s is not a PE32 image with a .text section\n", exePath);
+        return 2;
+    }
+
+    const uint64_t imageKey = OffsetCache::ImageKey(image);
+
+    std::vector<Resolved> table;
+    ScanImage(image, *text, table);
+
+    size_t resolved = 0, missing = 0;
+    for (size_t i = 0; i < kSigCount; ++i)
+    {
+        const SigDef& def = kSigDefs[i];
+        if (table[i].rva)
+        {
+            ++resolved;
+            printf("  %-26s = 0x%08X\n", def.name, image.ImageBase() + table[i].rva);
+        }
+        else if (def.pattern)
+        {
+            ++missing;
+            printf("  %-26s   %s\n", def.name, table[i].hits ? "matched more than once" : "no match");
+        }
+        else
+        {
+            printf("  %-26s   no pattern (fixed fallback)\n", def.name);
+        }
+    }
+    printf("%zu resolved, %zu failed, %zu without a pattern (image key 0x%016llX)\n",
+        resolved, missing, kSigCount - resolved - missing, static_cast<unsigned long long>(imageKey));
+
+    WarnRelocatedChecks(image, table);
+
+    int rc = missing ? 1 : 0;
+    if (headerPath)
+    {
+        if (WriteHeader(headerPath, image, exePath, imageKey, table))
+        {
+            printf("wrote %s\n", headerPath);
+        }
+        else
+        {
+            fprintf(stderr, "cannot write %s\n", headerPath);
+            rc = 2;
+        }
+    }
+    if (cachePath)
+    {
+        if (WriteCache(cachePath, image, imageKey, table))
+        {
+            printf("wrote %s\n", cachePath);
+        }
+        else
+        {
+            fprintf(stderr, "cannot write %s\n", cachePath);
+            rc = 2;
+        }
+    }
+    return rc;
+}
@@ -0,0 +1,213 @@
+/**
+ * @file worker_pool.cpp
+ * @brief Implementation of the work-stealing pool and its completion queue.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Built without the precompiled header so the file stays portable.
+ */
+
+#include "worker_pool.h"
+
+#include <algorithm>
+#include <chrono>
+
+// Which pool/worker the current thread belongs to, so nested submits stay local.
+static thread_local WorkerPool* t_pool  = nullptr;
+static thread_local size_t      t_index = 0;
+
+WorkerPool::~WorkerPool()
+{
+    Stop();
+}
+
+void WorkerPool::Start(unsigned threads)
+{
+    if (m_running.load(std::memory_order_acquire) || !m_workers.empty())
+        return;
+
+    if (threads == 0)
+    {
+        // Leave most cores to the game: half the hardware threads, 1..4.
+        unsigned hw = std::thread::hardware_concurrency();
+        threads = std::clamp(hw / 2, 1u, 4u);
+    }
+
+    m_running.store(true, std::memory_order_release);
+    m_active.store(threads, std::memory_order_release);
+    m_workers.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i)
+        m_workers.push_back(std::make_unique<Worker>());
+    for (unsigned i = 0; i < threads; ++i)
+        m_workers[i]->thread = std::thread(&WorkerPool::Run, this, static_cast<size_t>(i));
+}
+
+bool WorkerPool::Stop(bool joinThreads, unsigned timeoutMs)
+{
+    if (!m_running.exchange(false, std::memory_order_acq_rel))
+        return true;
+
+    bool exited;
+    {
+        std::unique_lock<std::mutex> lk(m_sleepLock);
+        m_wake.notify_all();
+        exited = m_exited.wait_for(lk, std::chrono::milliseconds(timeoutMs),
+            [this] { return m_active.load(std::memory_order_acquire) == 0; });
+    }
+
+    for (auto& worker : m_workers)
+    {
+        if (!worker->thread.joinable())
+            continue;
+        if (joinThreads && exited)
+            worker->thread.join();
+        else
+            worker->thread.detach();
+    }
+
+    // A straggler may still be inside a job and touching its Worker; leave
+    // the storage alone in that case rather than freeing it under it.
+    if (exited)
+        m_workers.clear();
+    m_pending.store(0, std::memory_order_release);
+    return exited;
+}
+
+void WorkerPool::Abandon()
+{
+    if (!m_running.exchange(false, std::memory_order_acq_rel))
+        return;
+
+    for (auto& worker : m_workers)
+    {
+        if (worker->thread.joinable())
+            worker->thread.detach();
+    }
+    m_pending.store(0, std::memory_order_release);
+}
+
+bool WorkerPool::Submit(Job job)
+{
+    if (!job || !m_running.load(std::memory_order_acquire) || m_workers.empty())
+        return false;
+
+    size_t target = (t_pool == this)
+        ? t_index
+        : m_nextQueue.fetch_add(1, std::memory_order_relaxed) % m_workers.size();
+
+    Worker& worker = *m_workers[target];
+    {
+        std::lock_guard<std::mutex> g(worker.lock);
+        worker.jobs.push_back(std::move(job));
+    }
+    m_pending.fetch_add(1, std::memory_order_release);
+
+    // Taking the sleep lock orders this against a worker that has just checked
+    // m_pending and is about to wait, so the wake-up can't be lost.
+    {
+        std::lock_guard<std::mutex> g(m_sleepLock);
+    }
+    m_wake.notify_one();
+    return true;
+}
+
+bool WorkerPool::TryTake(size_t index, Job& out)
+{
+    // Own queue first, newest job (cache-warm)...
+    {
+        Worker& self = *m_workers[index];
+        std::lock_guard<std::mutex> g(self.lock);
+        if (!self.jobs.empty())
+        {
+            out = std::move(self.jobs.back());
+            self.jobs.pop_back();
+            m_pending.fetch_sub(1, std::memory_order_acq_rel);
+            return true;
+        }
+    }
+
+    // ...then steal the oldest job from the others
+    size_t count = m_workers.size();
+    for (size_t i = 1; i < count; ++i)
+    {
+        Worker& victim = *m_workers[(index + i) % count];
+        std::lock_guard<std::mutex> g(victim.lock);
+        if (!victim.jobs.empty())
+        {
+            out = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            m_pending.fetch_sub(1, std::memory_order_acq_rel);
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkerPool::Execute(Job& job)
+{
+    try
+    {
+        job();
+    }
+    catch (...)
+    {
+        m_failed.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void WorkerPool::Run(size_t index)
+{
+    t_pool  = this;
+    t_index = index;
+
+    Job job;
+    while (m_running.load(std::memory_order_acquire))
+    {
+        if (TryTake(index, job))
+        {
+            Execute(job);
+            job = nullptr;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lk(m_sleepLock);
+        m_wake.wait(lk, [this]
+        {
+            return !m_running.load(std::memory_order_acquire)
+                || m_pending.load(std::memory_order_acquire) > 0;
+        });
+    }
+
+    {
+        std::lock_guard<std::mutex> g(m_sleepLock);
+        m_active.fetch_sub(1, std::memory_order_acq_rel);
+    }
+    m_exited.notify_all();
+}
+
+void WorkerPool::PostToMain(Job job)
+{
+    if (job)
+        m_completions.Push(std::move(job));
+}
+
+size_t WorkerPool::DrainCompletions()
+{
+    size_t ran = 0;
+    Job job;
+    while (m_completions.TryPop(job))
+    {
+        Execute(job);
+        job = nullptr;
+        ++ran;
+    }
+    return ran;
+}
+
+void WorkerPool::DiscardCompletions()
+{
+    Job job;
+    while (m_completions.TryPop(job))
+        job = nullptr;
+}
@@ -0,0 +1,127 @@
+/**
+ * @file worker_pool.h
+ * @brief Work-stealing background thread pool with a game-thread completion queue.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Each worker owns a deque. It pops its own work LIFO and steals FIFO from the
+ * others when it runs dry. Jobs submitted from a worker go to that worker's
+ * deque; jobs submitted from outside are spread round-robin.
+ *
+ * Workers must never touch game memory. Results come back through PostToMain(),
+ * a lock-free MPSC queue that the game thread drains with DrainCompletions()
+ * at the top of every ProcessGameEvents_Detour.
+ *
+ * Portable (std::thread only) so it can be built and exercised on a Linux host.
+ */
+
+#pragma once
+
+#include "mpsc_queue.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+class WorkerPool
+{
+public:
+    using Job = std::function<void()>;
+
+    WorkerPool() = default;
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // Spawn `threads` workers (0 = pick from hardware_concurrency).
+    void Start(unsigned threads = 0);
+
+    // Stop accepting work, drop queued jobs, and wait for every worker to leave
+    // its loop. With joinThreads=false the threads are detached once they are
+    // done instead of joined. Use that under the Windows loader lock, where a
+    // thread can't finish exiting. Returns false if a worker didn't finish
+    // within the timeout (e.g. a long job). At process exit use Abandon().
+    bool Stop(bool joinThreads = true, unsigned timeoutMs = 1000);
+
+    // Stop for process exit, when the OS has already ended the workers:
+    // mark the pool stopped and detach the threads without waiting or taking
+    // any lock a dead worker may have held. Worker storage is left in place.
+    void Abandon();
+
+    bool IsRunning() const { return m_running.load(std::memory_order_acquire); }
+    size_t GetThreadCount() const { return m_workers.size(); }
+
+    // Queue a job for a worker thread. Returns false if the pool isn't running.
+    bool Submit(Job job);
+
+    // Run work() on a worker, then done(result) on the game thread. For void
+    // work, done() takes no arguments.
+    template <typename Work, typename Done>
+    bool Submit(Work&& work, Done&& done)
+    {
+        using Result = std::invoke_result_t<Work&>;
+        return Submit(Job(
+            [this, work = std::forward<Work>(work), done = std::forward<Done>(done)]() mutable
+            {
+                if constexpr (std::is_void_v<Result>)
+                {
+                    work();
+                    PostToMain(std::move(done));
+                }
+                else
+                {
+                    auto result = std::make_shared<Result>(work());
+                    PostToMain([done = std::move(done), result]() mutable { done(std::move(*result)); });
+                }
+            }));
+    }
+
+    // Queue a callback for the game thread. Any thread.
+    void PostToMain(Job job);
+
+    // Run every queued completion. Game thread only. Returns the number run.
+    size_t DrainCompletions();
+
+    // Drop pending completions without running them (shutdown).
+    void DiscardCompletions();
+
+    // Jobs that threw; the exception is swallowed so it can't take down the game.
+    uint32_t GetFailedCount() const { return m_failed.load(std::memory_order_relaxed); }
+
+private:
+    struct Worker
+    {
+        std::mutex      lock;
+        std::deque<Job> jobs;
+        std::thread     thread;
+    };
+
+    void Run(size_t index);
+    bool TryTake(size_t index, Job& out);
+    void Execute(Job& job);
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::atomic<bool>     m_running{ false };
+    std::atomic<size_t>   m_pending{ 0 };   // queued, not yet taken
+    std::atomic<size_t>   m_active{ 0 };    // workers still inside Run()
+    std::atomic<size_t>   m_nextQueue{ 0 };
+    std::atomic<uint32_t> m_failed{ 0 };
+
+    // Idle workers sleep here; also used by Stop() to wait for m_active == 0.
+    std::mutex              m_sleepLock;
+    std::condition_variable m_wake;
+    std::condition_variable m_exited;
+
+    MpscQueue<Job> m_completions;
+};
@@ -0,0 +1,493 @@
+/**
+ * @file x86_decode.cpp
+ * @brief Implementation of the x86 length decoder (opcode tables) and branch relocator.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "x86_decode.h"
+
+#include <array>
+#include <cstring>
+
+namespace X86
+{
+
+// ---------------------------------------------------------------------------
+// Opcode tables (32-bit protected mode)
+// ---------------------------------------------------------------------------
+
+enum : uint8_t
+{
+    kModRM   = 0x01,
+    kImm8    = 0x02,
+    kImmZ    = 0x04,   // imm32, or imm16 with a 66 prefix
+    kImm16   = 0x08,
+    kPrefix  = 0x10,
+    kInvalid = 0x20,
+    kSpecial = 0x40,   // operand layout decided in Decode()
+};
+
+using Table = std::array<uint8_t, 256>;
+
+static constexpr void Set(Table& t, int lo, int hi, uint8_t flags)
+{
+    for (int i = lo; i <= hi; ++i)
+        t[i] = flags;
+}
+
+static constexpr Table BuildOneByte()
+{
+    Table t = {};
+
+    // ALU blocks: op r/m,r / r,r/m (00-03), AL,imm8 (04), eAX,immZ (05)
+    for (int base = 0x00; base <= 0x38; base += 0x08)
+    {
+        Set(t, base, base + 3, kModRM);
+        t[base + 4] = kImm8;
+        t[base + 5] = kImmZ;
+    }
+    t[0x0F] = kSpecial;                               // two-byte escape
+    t[0x26] = t[0x2E] = t[0x36] = t[0x3E] = kPrefix;  // segment overrides
+
+    t[0x62] = kSpecial;                               // BOUND (EVEX when mod == 3)
+    t[0x63] = kModRM;
+    Set(t, 0x64, 0x67, kPrefix);                      // FS, GS, operand, address size
+    t[0x68] = kImmZ;
+    t[0x69] = kModRM | kImmZ;
+    t[0x6A] = kImm8;
+    t[0x6B] = kModRM | kImm8;
+
+    Set(t, 0x70, 0x7F, kImm8);                        // Jcc rel8
+    t[0x80] = t[0x82] = t[0x83] = kModRM | kImm8;
+    t[0x81] = kModRM | kImmZ;
+    Set(t, 0x84, 0x8E, kModRM);
+    t[0x8F] = kSpecial;                               // POP r/m (XOP when reg != 0)
+
+    t[0x9A] = kSpecial;                               // CALL far ptr16:32
+    Set(t, 0xA0, 0xA3, kSpecial);                     // MOV moffs
+    t[0xA8] = kImm8;
+    t[0xA9] = kImmZ;
+    Set(t, 0xB0, 0xB7, kImm8);
+    Set(t, 0xB8, 0xBF, kImmZ);
+
+    t[0xC0] = t[0xC1] = kModRM | kImm8;
+    t[0xC2] = kImm16;                                 // RET imm16
+    t[0xC4] = t[0xC5] = kSpecial;                     // LES/LDS (VEX when mod == 3)
+    t[0xC6] = kModRM | kImm8;
+    t[0xC7] = kModRM | kImmZ;
+    t[0xC8] = kSpecial;                               // ENTER imm16, imm8
+    t[0xCA] = kImm16;                                 // RETF imm16
+    t[0xCD] = kImm8;                                  // INT imm8
+
+    Set(t, 0xD0, 0xD3, kModRM);
+    t[0xD4] = t[0xD5] = kImm8;                        // AAM/AAD
+    Set(t, 0xD8, 0xDF, kModRM);                       // x87
+
+    Set(t, 0xE0, 0xE7, kImm8);                        // LOOPcc/JECXZ rel8, IN/OUT imm8
+    t[0xE8] = t[0xE9] = kImmZ;                        // CALL/JMP rel32
+    t[0xEA] = kSpecial;                               // JMP far ptr16:32
+    t[0xEB] = kImm8;                                  // JMP rel8
+
+    t[0xF0] = t[0xF2] = t[0xF3] = kPrefix;            // LOCK, REPNE, REP
+    t[0xF6] = t[0xF7] = kSpecial;                     // group 3 (TEST has an immediate)
+    t[0xFE] = t[0xFF] = kModRM;
+    return t;
+}
+
+static constexpr Table BuildTwoByte()
+{
+    Table t = {};
+    Set(t, 0x00, 0x03, kModRM);
+    t[0x04] = t[0x0A] = t[0x0C] = kInvalid;
+    t[0x0D] = kModRM;                                 // PREFETCHW
+    t[0x0F] = kModRM | kImm8;                         // 3DNow!
+    Set(t, 0x10, 0x1F, kModRM);
+    Set(t, 0x20, 0x23, kModRM);                       // MOV CRn/DRn
+    Set(t, 0x24, 0x27, kInvalid);
+    Set(t, 0x28, 0x2F, kModRM);
+    t[0x38] = kSpecial;                               // three-byte map 0F 38
+    t[0x39] = kInvalid;
+    t[0x3A] = kSpecial;                               // three-byte map 0F 3A
+    Set(t, 0x3B, 0x3F, kInvalid);
+    Set(t, 0x40, 0x6F, kModRM);
+    Set(t, 0x70, 0x73, kModRM | kImm8);
+    Set(t, 0x74, 0x76, kModRM);
+    Set(t, 0x78, 0x79, kModRM);
+    t[0x7A] = t[0x7B] = kInvalid;
+    Set(t, 0x7C, 0x7F, kModRM);
+    Set(t, 0x80, 0x8F, kImmZ);                        // Jcc rel32
+    Set(t, 0x90, 0x9F, kModRM);                       // SETcc
+    t[0xA3] = t[0xA5] = t[0xAB] = t[0xAD] = t[0xAE] = t[0xAF] = kModRM;
+    t[0xA4] = t[0xAC] = kModRM | kImm8;               // SHLD/SHRD imm8
+    t[0xA6] = t[0xA7] = kInvalid;
+    Set(t, 0xB0, 0xBF, kModRM);
+    t[0xBA] = kModRM | kImm8;                         // BT group imm8
+    t[0xC0] = t[0xC1] = kModRM;                       // XADD
+    Set(t, 0xC2, 0xC6, kModRM | kImm8);               // CMPPS, PINSRW, SHUFPS...
+    t[0xC3] = kModRM;                                 // MOVNTI
+    t[0xC7] = kModRM;                                 // CMPXCHG8B group
+    Set(t, 0xD0, 0xFF, kModRM);
+    return t;
+}
+
+static constexpr Table kOneByte = BuildOneByte();
+static constexpr Table kTwoByte = BuildTwoByte();
+
+// ---------------------------------------------------------------------------
+// Decoder
+// ---------------------------------------------------------------------------
+
+// Bytes after the ModRM byte (SIB + displacement), or -1 if truncated
+static int ModRMExtra(const uint8_t* p, size_t avail, bool addr16)
+{
+    if (avail < 1)
+        return -1;
+    uint8_t modrm = p[0];
+    uint8_t mod = modrm >> 6;
+    uint8_t rm = modrm & 7;
+    if (mod == 3)
+        return 0;
+
+    if (addr16)
+    {
+        if (mod == 0)
+            return rm == 6 ? 2 : 0;
+        return mod == 1 ? 1 : 2;
+    }
+
+    int extra = 0;
+    if (rm == 4)
+    {
+        if (avail < 2)
+            return -1;
+        extra = 1;
+        if (mod == 0 && (p[1] & 7) == 5)
+            return extra + 4;
+    }
+    if (mod == 0)
+        return extra + (rm == 5 ? 4 : 0);
+    return extra + (mod == 1 ? 1 : 4);
+}
+
+size_t Decode(const uint8_t* code, size_t avail, Insn& out)
+{
+    out = Insn();
+    const size_t limit = avail < kMaxInsnLength ? avail : kMaxInsnLength;
+
+    size_t pos = 0;
+    bool opSize16 = false, addr16 = false;
+    while (pos < limit && (kOneByte[code[pos]] & kPrefix))
+    {
+        if (code[pos] == 0x66)
+            opSize16 = true;
+        else if (code[pos] == 0x67)
+            addr16 = true;
+        ++pos;
+    }
+    if (pos >= limit)
+        return 0;
+
+    out.opcodeOffset = static_cast<uint8_t>(pos);
+    out.opSize16 = opSize16;
+    const size_t immZ = opSize16 ? 2 : 4;
+
+    uint8_t op = code[pos++];
+    uint8_t flags = kOneByte[op];
+    size_t imm = 0;
+    bool modrm = false;
+    bool regOnly = false;   // ModRM is always read as the register form
+
+    if (op == 0x0F)
+    {
+        if (pos >= limit)
+            return 0;
+        uint8_t op2 = code[pos++];
+        if (op2 == 0x38 || op2 == 0x3A)
+        {
+            if (pos >= limit)
+                return 0;
+            ++pos;   // third opcode byte
+            modrm = true;
+            imm = op2 == 0x3A ? 1 : 0;
+        }
+        else
+        {
+            flags = kTwoByte[op2];
+            if (flags & kInvalid)
+                return 0;
+            modrm = flags & kModRM;
+            regOnly = op2 >= 0x20 && op2 <= 0x23;   // MOV CRn/DRn ignore mod
+            if (flags & kImm8)
+                imm = 1;
+            if (flags & kImmZ)
+                imm = immZ;
+        }
+
+        if (op2 >= 0x80 && op2 <= 0x8F)
+        {
+            out.flow = Flow::Branch;
+            out.relSize = static_cast<uint8_t>(immZ);
+        }
+        else if (op2 == 0x05 || op2 == 0x34)   // SYSCALL/SYSENTER
+        {
+            out.flow = Flow::Call;
+        }
+    }
+    else if (flags & kSpecial)
+    {
+        switch (op)
+        {
+        case 0x62:   // BOUND; mod == 3 is EVEX
+        case 0xC4:   // LES; mod == 3 is VEX3
+        case 0xC5:   // LDS; mod == 3 is VEX2
+            if (pos >= limit || (code[pos] >> 6) == 3)
+                return 0;
+            modrm = true;
+            break;
+        case 0x8F:   // POP r/m; reg != 0 is XOP
+            if (pos >= limit || ((code[pos] >> 3) & 7) != 0)
+                return 0;
+            modrm = true;
+            break;
+        case 0x9A:   // CALL far
+        case 0xEA:   // JMP far
+            imm = immZ + 2;
+            out.flow = op == 0x9A ? Flow::Call : Flow::Jump;
+            break;
+        case 0xA0: case 0xA1: case 0xA2: case 0xA3:
+            imm = addr16 ? 2 : 4;
+            break;
+        case 0xC8:   // ENTER imm16, imm8
+            imm = 3;
+            break;
+        case 0xF6:
+        case 0xF7:   // TEST r/m, imm (reg 0/1) — other group 3 ops have none
+            if (pos >= limit)
+                return 0;
+            modrm = true;
+            if (((code[pos] >> 3) & 7) < 2)
+                imm = op == 0xF6 ? 1 : immZ;
+            break;
+        default:
+            return 0;
+        }
+    }
+    else
+    {
+        if (flags & kInvalid)
+            return 0;
+        modrm = flags & kModRM;
+        if (flags & kImm8)
+            imm = 1;
+        if (flags & kImmZ)
+            imm = immZ;
+        if (flags & kImm16)
+            imm = 2;
+
+        if ((op >= 0x70 && op <= 0x7F) || (op >= 0xE0 && op <= 0xE3))
+        {
+            out.flow = Flow::Branch;
+            out.relSize = 1;
+        }
+        else if (op == 0xEB)
+        {
+            out.flow = Flow::Jump;
+            out.relSize = 1;
+        }
+        else if (op == 0xE9 || op == 0xE8)
+        {
+            out.flow = op == 0xE9 ? Flow::Jump : Flow::Call;
+            out.relSize = static_cast<uint8_t>(immZ);
+        }
+        else if (op == 0xC2 || op == 0xC3 || op == 0xCA || op == 0xCB || op == 0xCF)
+        {
+            out.flow = Flow::Return;
+        }
+        else if (op == 0xFF && pos < limit)
+        {
+            uint8_t reg = (code[pos] >> 3) & 7;
+            if (reg == 2 || reg == 3)
+                out.flow = Flow::Call;
+            else if (reg == 4 || reg == 5)
+                out.flow = Flow::Jump;
+        }
+    }
+
+    if (modrm)
+    {
+        int extra = regOnly ? (pos < limit ? 0 : -1) : ModRMExtra(code + pos, limit - pos, addr16);
+        if (extra < 0)
+            return 0;
+        pos += 1 + static_cast<size_t>(extra);
+    }
+
+    if (out.relSize)
+        out.relOffset = static_cast<uint8_t>(pos);
+    pos += imm;
+    if (pos > limit)
+        return 0;
+
+    out.length = static_cast<uint8_t>(pos);
+    return pos;
+}
+
+uint32_t BranchTarget(const uint8_t* code, const Insn& insn, uint32_t address)
+{
+    int32_t rel = 0;
+    const uint8_t* field = code + insn.relOffset;
+    if (insn.relSize == 1)
+    {
+        rel = static_cast<int8_t>(field[0]);
+    }
+    else if (insn.relSize == 2)
+    {
+        int16_t r16;
+        memcpy(&r16, field, sizeof(r16));
+        rel = r16;
+    }
+    else if (insn.relSize == 4)
+    {
+        memcpy(&rel, field, sizeof(rel));
+    }
+    return address + insn.length + static_cast<uint32_t>(rel);
+}
+
+// ---------------------------------------------------------------------------
+// Relocator
+// ---------------------------------------------------------------------------
+
+static void PutRel32(uint8_t* p, uint32_t from, uint32_t to)
+{
+    int32_t rel = static_cast<int32_t>(to - from);
+    memcpy(p, &rel, sizeof(rel));
+}
+
+void WriteJmpRel32(uint8_t* dst, uint32_t from, uint32_t to)
+{
+    dst[0] = 0xE9;
+    PutRel32(dst + 1, from + kJmpRel32Size, to);
+}
+
+static bool IsPadding(const uint8_t* p, size_t size)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        if (p[i] != 0xCC && p[i] != 0x90)
+            return false;
+    }
+    return true;
+}
+
+bool Relocate(const uint8_t* src, size_t srcAvail, uint32_t srcAddress, size_t minBytes,
+    uint8_t* dst, size_t dstCap, uint32_t dstAddress, RelocResult& result)
+{
+    result = RelocResult();
+    auto fail = [&result](RelocError error) {
+        result.error = error;
+        return false;
+    };
+
+    // First pass: choose the instructions to steal
+    size_t stolen = 0;
+    while (stolen < minBytes)
+    {
+        Insn insn;
+        if (!Decode(src + stolen, srcAvail - stolen, insn))
+            return fail(RelocError::Invalid);
+        stolen += insn.length;
+
+        if ((insn.flow == Flow::Return || insn.flow == Flow::Jump) && stolen < minBytes)
+        {
+            // The function ends here; what follows is overwritten but never run
+            if (srcAvail < minBytes || !IsPadding(src + stolen, minBytes - stolen))
+                return fail(RelocError::TooShort);
+            break;
+        }
+    }
+    const size_t copied = stolen;   // real instructions; padding is not copied
+    stolen = stolen < minBytes ? minBytes : stolen;
+
+    // Second pass: copy, widening and re-basing relative branches
+    size_t out = 0;
+    for (size_t pos = 0; pos < copied;)
+    {
+        Insn insn;
+        Decode(src + pos, srcAvail - pos, insn);
+        const uint8_t* in = src + pos;
+        const uint32_t from = srcAddress + static_cast<uint32_t>(pos);
+
+        if (!insn.relSize)
+        {
+            if (dstCap - out < insn.length)
+                return fail(RelocError::NoSpace);
+            memcpy(dst + out, in, insn.length);
+            out += insn.length;
+            pos += insn.length;
+            continue;
+        }
+
+        const uint8_t op = in[insn.opcodeOffset];
+        if (insn.relSize == 2 || (op >= 0xE0 && op <= 0xE3))
+            return fail(RelocError::Unsupported);
+
+        uint32_t target = BranchTarget(in, insn, from);
+        if (target > srcAddress && target < srcAddress + stolen)
+            return fail(RelocError::BranchInside);
+
+        // Prefixes (e.g. branch hints) are kept in front of the new form
+        const size_t prefixes = insn.opcodeOffset;
+        size_t size;
+        if (insn.relSize == 4)
+            size = insn.length;
+        else if (op == 0xEB)
+            size = prefixes + 5;
+        else
+            size = prefixes + 6;   // Jcc rel8 -> 0F 8x rel32
+        if (dstCap - out < size)
+            return fail(RelocError::NoSpace);
+
+        uint8_t* w = dst + out;
+        const uint32_t wAddr = dstAddress + static_cast<uint32_t>(out);
+        memcpy(w, in, prefixes);
+        if (insn.relSize == 4)
+        {
+            memcpy(w + prefixes, in + prefixes, insn.relOffset - prefixes);
+            PutRel32(w + insn.relOffset, wAddr + static_cast<uint32_t>(size), target);
+        }
+        else if (op == 0xEB)
+        {
+            w[prefixes] = 0xE9;
+            PutRel32(w + prefixes + 1, wAddr + static_cast<uint32_t>(size), target);
+        }
+        else
+        {
+            w[prefixes] = 0x0F;
+            w[prefixes + 1] = static_cast<uint8_t>(0x80 | (op & 0x0F));
+            PutRel32(w + prefixes + 2, wAddr + static_cast<uint32_t>(size), target);
+        }
+        out += size;
+        pos += insn.length;
+    }
+
+    result.consumed = stolen;
+    result.produced = out;
+    return true;
+}
+
+const char* RelocErrorName(RelocError error)
+{
+    switch (error)
+    {
+    case RelocError::None:         return "none";
+    case RelocError::Invalid:      return "undecodable instruction";
+    case RelocError::Unsupported:  return "LOOP/JECXZ or rel16 branch";
+    case RelocError::BranchInside: return "branch into the replaced bytes";
+    case RelocError::TooShort:     return "function shorter than the hook";
+    case RelocError::NoSpace:      return "trampoline too small";
+    }
+    return "?";
+}
+
+} // namespace X86
@@ -0,0 +1,104 @@
+/**
+ * @file x86_decode.h
+ * @brief 32-bit x86 instruction-length decoder and branch relocator for inline hooks.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Pure functions over byte buffers — no allocation, no Windows headers — so
+ * the inline hook engine's hardest part can be exercised on any host.
+ *
+ * Decode() returns the length of one instruction (legacy prefixes, one-,
+ * two- and three-byte opcode maps, ModRM/SIB/displacement, immediates) and
+ * whether it carries a relative branch. VEX/EVEX-encoded instructions and
+ * anything not in the tables decode as invalid (length 0), which makes the
+ * hook engine refuse the target rather than guess.
+ *
+ * Relocate() copies whole instructions from the start of a function until at
+ * least `minBytes` have been taken (5 for a JMP rel32), rewriting relative
+ * branches so they still reach their original targets from the new address:
+ *
+ *     JMP rel8        EB xx       ->  E9 rel32
+ *     Jcc rel8        7x xx       ->  0F 8x rel32
+ *     JMP/CALL rel32, Jcc rel32   ->  displacement re-based
+ *
+ * It refuses LOOP/JECXZ (rel8 only, no long form), operand-size-prefixed
+ * branches (rel16), and any branch whose target falls inside the bytes being
+ * replaced. If a RET or unconditional JMP ends the function early, the rest
+ * of the window must be INT3/NOP padding.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace X86
+{
+
+enum class Flow : uint8_t
+{
+    Next,       // falls through
+    Jump,       // unconditional jump (rel or indirect)
+    Branch,     // conditional jump / loop
+    Call,       // call (rel or indirect)
+    Return,     // RET/RETF/IRET
+};
+
+struct Insn
+{
+    uint8_t length = 0;       // 0 = invalid or unsupported
+    uint8_t opcodeOffset = 0; // first opcode byte, after prefixes
+    uint8_t relOffset = 0;    // offset of the rel8/rel32 field, if relSize
+    uint8_t relSize = 0;      // 0, 1, 2 or 4
+    Flow    flow = Flow::Next;
+    bool    opSize16 = false; // 66 prefix present
+};
+
+constexpr size_t kMaxInsnLength = 15;
+constexpr size_t kJmpRel32Size  = 5;
+
+// Decode the instruction at code[0..avail). Returns its length (also in
+// out.length), or 0 if it is truncated, invalid or unsupported.
+size_t Decode(const uint8_t* code, size_t avail, Insn& out);
+
+// Absolute target of a decoded relative branch located at `address`
+uint32_t BranchTarget(const uint8_t* code, const Insn& insn, uint32_t address);
+
+// Worst-case size of Relocate()'s output for `stolen` source bytes
+constexpr size_t MaxRelocatedSize(size_t stolen)
+{
+    // every 2-byte rel8 branch can grow to 6 bytes
+    return stolen * 3;
+}
+
+enum class RelocError : uint8_t
+{
+    None,
+    Invalid,        // undecodable instruction
+    Unsupported,    // LOOP/JECXZ or rel16 branch
+    BranchInside,   // a branch lands inside the replaced bytes
+    TooShort,       // function ends before minBytes and isn't padded
+    NoSpace,        // dst too small
+};
+
+struct RelocResult
+{
+    size_t     consumed = 0;  // source bytes taken (whole instructions, >= minBytes)
+    size_t     produced = 0;  // bytes written to dst
+    RelocError error = RelocError::None;
+};
+
+// Copy the first >= minBytes of whole instructions from src (which lives at
+// srcAddress) to dst (which will live at dstAddress), fixing relative
+// branches. Appends nothing — the caller adds the jump back to
+// srcAddress + consumed. Returns false with result.error set on failure.
+bool Relocate(const uint8_t* src, size_t srcAvail, uint32_t srcAddress, size_t minBytes,
+    uint8_t* dst, size_t dstCap, uint32_t dstAddress, RelocResult& result);
+
+// E9 rel32 at dst (living at `from`) jumping to `to`. Writes kJmpRel32Size bytes.
+void WriteJmpRel32(uint8_t* dst, uint32_t from, uint32_t to);
+
+const char* RelocErrorName(RelocError error);
+
+} // namespace X86